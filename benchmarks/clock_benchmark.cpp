@@ -0,0 +1,55 @@
+#include "../core/clock.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+using namespace hft::core;
+
+// Cost of one timestamp from each clock source
+
+constexpr size_t NUM_CALLS = 20000000;
+
+template <typename Clock> static double run(Clock clock) {
+  uint64_t sink = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < NUM_CALLS; ++i) {
+    sink += clock();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  // Keep the calls from being optimized away
+  if (sink == 42) {
+    std::cout << "";
+  }
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         NUM_CALLS;
+}
+
+int main() {
+  std::cout << "Clock Benchmark\n";
+  std::cout << "===============\n";
+  std::cout << "Calls: " << NUM_CALLS << ", TSC in use: "
+            << (TscClock::uses_tsc() ? "yes" : "no") << " ("
+            << std::setprecision(4) << TscClock::ticks_per_ns()
+            << " ticks/ns)\n\n";
+
+  std::cout << std::left << std::setw(28) << "source" << std::right
+            << std::setw(12) << "ns/call" << "\n";
+
+  const auto report = [](const char *name, double ns) {
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(2) << ns
+              << "\n";
+  };
+
+  report("steady_clock::now()", run([] {
+           return static_cast<uint64_t>(
+               std::chrono::steady_clock::now().time_since_epoch().count());
+         }));
+  report("TscClock::ticks()", run([] { return TscClock::ticks(); }));
+  report("TscClock::now()", run([] { return TscClock::now(); }));
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include "../core/distribution/dispatcher.hpp"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace hft::core;
+
+// Dispatcher fan-out cost: queue-per-subscriber vs broadcast ring
+// Measures the parser-side cost of dispatch() as the subscriber count grows.
+// Queue mode writes every message once per subscriber; broadcast mode writes
+// it once regardless of how many subscribers read it.
+
+constexpr uint32_t NUM_MESSAGES = 5000000;
+
+struct Result {
+  double seconds;
+  uint64_t delivered;
+  uint64_t dropped;
+};
+
+static Result run(DispatchMode mode, size_t subscribers) {
+  DispatcherConfig config;
+  config.mode = mode;
+  Dispatcher dispatcher(config);
+
+  std::atomic<uint64_t> delivered{0};
+  for (size_t i = 0; i < subscribers; ++i) {
+    dispatcher.add_subscriber(
+        make_subscriber("bench", [&delivered](const NormalizedMessage &) {
+          delivered.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }));
+  }
+  dispatcher.start();
+
+  NormalizedMessage msg;
+  msg.type = NormalizedMessage::Type::TRADE;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t seq = 0; seq < NUM_MESSAGES; ++seq) {
+    msg.sequence = seq;
+    dispatcher.dispatch(msg);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  // Give the dispatch thread a moment to drain before reading counters
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  dispatcher.stop();
+
+  uint64_t dropped = 0;
+  for (size_t i = 0; i < subscribers; ++i) {
+    dropped += dispatcher.subscriber_stats(i).messages_dropped;
+  }
+
+  return {std::chrono::duration<double>(end - start).count(), delivered.load(),
+          dropped};
+}
+
+int main() {
+  std::cout << "Dispatcher Fan-out Benchmark\n";
+  std::cout << "============================\n";
+  std::cout << "Messages: " << NUM_MESSAGES << " x " << sizeof(NormalizedMessage)
+            << " bytes\n\n";
+
+  std::cout << std::setw(12) << "mode" << std::setw(6) << "subs"
+            << std::setw(16) << "dispatch ns/msg" << std::setw(14)
+            << "delivered" << std::setw(12) << "dropped" << "\n";
+
+  for (size_t subscribers : {size_t{1}, size_t{4}, size_t{10}}) {
+    for (DispatchMode mode :
+         {DispatchMode::QUEUE_PER_SUBSCRIBER, DispatchMode::BROADCAST}) {
+      Result r = run(mode, subscribers);
+      std::cout << std::setw(12)
+                << (mode == DispatchMode::BROADCAST ? "broadcast" : "queue")
+                << std::setw(6) << subscribers << std::setw(16) << std::fixed
+                << std::setprecision(1) << (r.seconds * 1e9 / NUM_MESSAGES)
+                << std::setw(14) << r.delivered << std::setw(12) << r.dropped
+                << "\n";
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,268 @@
+#include "../core/book/order_book.hpp"
+#include "../core/metrics/histogram.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace hft::core;
+
+// Order book replay of a synthetic full trading session
+// The session spreads order flow over 8,000 instruments with a skewed
+// activity profile (a few names carry most of the flow) and a NASDAQ-like
+// message mix. Replaces arrive as a delete plus an add, as ItchParser emits
+// them with order tracking. The session is replayed once to warm up, then
+// timed on the same book after clear(); operator new is counted to show the
+// timed replay does not allocate.
+
+constexpr uint32_t INSTRUMENTS = 8000;
+constexpr size_t SESSION_MESSAGES = 4000000;
+constexpr int64_t TICK = 100; // $0.01 at price scale 10000
+
+static std::atomic<uint64_t> allocations{0};
+
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+struct Mix {
+  uint64_t adds{0};
+  uint64_t deletes{0};
+  uint64_t replaces{0};
+  uint64_t executions{0};
+  uint64_t cancels{0};
+};
+
+// Session generator - keeps the live orders so every event refers to an
+// order that is actually resting
+class SessionGenerator {
+public:
+  SessionGenerator() : rng_(2024), next_id_(1), books_(INSTRUMENTS) {
+    for (uint32_t i = 0; i < INSTRUMENTS; ++i) {
+      books_[i].mid = (20 + i % 480) * 10000;
+    }
+  }
+
+  std::vector<NormalizedMessage> generate(size_t count, Mix &mix) {
+    std::vector<NormalizedMessage> session;
+    session.reserve(count + 1);
+    while (session.size() < count) {
+      const uint32_t instrument = pick_instrument();
+      Book &book = books_[instrument];
+      const uint64_t action = rng_() % 100;
+
+      if (action < 44 || book.live.empty()) {
+        add(session, instrument, rng_() % 2, near_price(book, rng_() % 2));
+        mix.adds++;
+        continue;
+      }
+
+      const size_t slot = pick_order(book);
+      const uint64_t id = book.live[slot];
+      Order &order = orders_[id];
+      if (action < 84) {
+        session.push_back(message(NormalizedMessage::Type::ORDER_DELETE,
+                                  instrument, id, order.remaining));
+        remove(book, slot);
+        mix.deletes++;
+      } else if (action < 93) {
+        // Replace: same side, price nudged by a tick but kept off the mid
+        const uint8_t side = order.side;
+        int64_t price = order.price + (rng_() % 2 ? TICK : -TICK);
+        price = side == OrderBook::BID ? std::min(price, book.mid - TICK)
+                                       : std::max(price, book.mid + TICK);
+        session.push_back(message(NormalizedMessage::Type::ORDER_DELETE,
+                                  instrument, id, order.remaining));
+        remove(book, slot);
+        add(session, instrument, side, price);
+        mix.replaces++;
+      } else if (action < 97) {
+        const uint64_t executed =
+            rng_() % 2 ? order.remaining : 1 + rng_() % order.remaining;
+        session.push_back(message(NormalizedMessage::Type::ORDER_EXECUTE,
+                                  instrument, id, executed));
+        reduce(book, slot, executed);
+        mix.executions++;
+      } else {
+        const uint64_t cancelled = std::max<uint64_t>(order.remaining / 2, 1);
+        session.push_back(message(NormalizedMessage::Type::ORDER_MODIFY,
+                                  instrument, id, cancelled));
+        reduce(book, slot, cancelled);
+        mix.cancels++;
+      }
+    }
+    session.resize(count);
+    return session;
+  }
+
+private:
+  struct Order {
+    uint64_t remaining;
+    int64_t price;
+    uint8_t side;
+  };
+
+  // Orders rest around a fixed mid: nothing matches them here, so a moving
+  // price would leave the book crossed
+  struct Book {
+    int64_t mid{0};
+    std::vector<uint64_t> live;
+  };
+
+  // Heavily skewed towards low instrument ids
+  uint32_t pick_instrument() {
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    return static_cast<uint32_t>(INSTRUMENTS * u * u * u);
+  }
+
+  // Most cancels hit recently added orders; the rest rest for a while
+  size_t pick_order(const Book &book) {
+    const size_t size = book.live.size();
+    if (rng_() % 4 == 0) {
+      return rng_() % size;
+    }
+    const double u = std::uniform_real_distribution<double>(1e-9, 1.0)(rng_);
+    const size_t back = static_cast<size_t>(-std::log(u) * 8);
+    return size - 1 - std::min(back, size - 1);
+  }
+
+  // Most orders join within a few ticks of the inside
+  int64_t near_price(const Book &book, uint8_t side) {
+    const double u = std::uniform_real_distribution<double>(1e-9, 1.0)(rng_);
+    const int64_t ticks = 1 + std::min<int64_t>(
+                                  static_cast<int64_t>(-std::log(u) * 3), 50);
+    return side == OrderBook::BID ? book.mid - ticks * TICK
+                                  : book.mid + ticks * TICK;
+  }
+
+  void add(std::vector<NormalizedMessage> &session, uint32_t instrument,
+           uint8_t side, int64_t price) {
+    const uint64_t id = next_id_++;
+    const uint64_t quantity = 100 * (1 + rng_() % 10);
+    NormalizedMessage msg =
+        message(NormalizedMessage::Type::ORDER_ADD, instrument, id, quantity);
+    msg.side = side;
+    msg.price = price;
+    session.push_back(msg);
+    orders_.push_back(Order{quantity, price, side});
+    books_[instrument].live.push_back(id);
+  }
+
+  void reduce(Book &book, size_t slot, uint64_t quantity) {
+    Order &order = orders_[book.live[slot]];
+    order.remaining -= std::min(quantity, order.remaining);
+    if (order.remaining == 0) {
+      remove(book, slot);
+    }
+  }
+
+  static void remove(Book &book, size_t slot) {
+    book.live[slot] = book.live.back();
+    book.live.pop_back();
+  }
+
+  static NormalizedMessage message(NormalizedMessage::Type type,
+                                   uint32_t instrument, uint64_t id,
+                                   uint64_t quantity) {
+    NormalizedMessage msg;
+    msg.type = type;
+    msg.instrument_id = instrument;
+    msg.order_id = id;
+    msg.quantity = quantity;
+    return msg;
+  }
+
+  std::mt19937_64 rng_;
+  uint64_t next_id_;
+  std::vector<Book> books_;
+  std::vector<Order> orders_{Order{0, 0, 0}}; // Ids start at 1
+};
+
+static double replay(OrderBook &book,
+                     const std::vector<NormalizedMessage> &session) {
+  const auto start = std::chrono::steady_clock::now();
+  for (const NormalizedMessage &msg : session) {
+    book.apply(msg);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+static double percent(uint64_t part, size_t whole) {
+  return 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+int main() {
+  std::cout << "Order Book Session Replay Benchmark\n";
+  std::cout << "===================================\n";
+
+  Mix mix;
+  SessionGenerator generator;
+  const std::vector<NormalizedMessage> session =
+      generator.generate(SESSION_MESSAGES, mix);
+  const size_t events =
+      mix.adds + mix.deletes + mix.replaces + mix.executions + mix.cancels;
+  std::cout << "Messages: " << session.size() << " across " << INSTRUMENTS
+            << " instruments\n"
+            << std::fixed << std::setprecision(1) << "Mix: add "
+            << percent(mix.adds, events) << "%, delete "
+            << percent(mix.deletes, events) << "%, replace "
+            << percent(mix.replaces, events) << "%, execute "
+            << percent(mix.executions, events) << "%, cancel "
+            << percent(mix.cancels, events) << "%\n\n";
+
+  OrderBookConfig config;
+  config.max_orders = 1 << 21;
+  config.max_levels = 1 << 19;
+  OrderBook book(config);
+
+  const double warmup = replay(book, session);
+  const size_t resting = book.order_count();
+  const size_t levels = book.level_count();
+  book.clear();
+
+  const uint64_t allocations_before = allocations.load();
+  const double seconds = replay(book, session);
+  const uint64_t replay_allocations = allocations.load() - allocations_before;
+
+  std::cout << std::setprecision(3) << "Warmup replay:     " << warmup
+            << " s\n"
+            << "Timed replay:      " << seconds << " s, "
+            << std::setprecision(2) << (session.size() / seconds / 1e6)
+            << " M msgs/sec, "
+            << (seconds * 1e9 / session.size()) << " ns/msg\n"
+            << "Resting at close:  " << resting << " orders, " << levels
+            << " levels\n"
+            << "Unknown / rejected: " << book.stats().unknown_orders << " / "
+            << book.stats().rejected << "\n"
+            << "Allocations during timed replay: " << replay_allocations
+            << "\n\n";
+
+  // Per-message latency, clock reads included
+  book.clear();
+  LatencyHistogram histogram;
+  for (const NormalizedMessage &msg : session) {
+    const Timestamp start = get_timestamp();
+    book.apply(msg);
+    histogram.record(get_timestamp() - start);
+  }
+  std::cout << "Per-message latency (ns, includes two clock reads)\n"
+            << "  p50 " << histogram.percentile(50.0) << "  p99 "
+            << histogram.percentile(99.0) << "  p99.9 "
+            << histogram.percentile(99.9) << "  max "
+            << histogram.percentile(100.0) << "\n";
+
+  return 0;
+}
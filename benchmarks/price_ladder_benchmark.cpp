@@ -0,0 +1,287 @@
+#include "../core/book/price_ladder.hpp"
+#include "../core/metrics/histogram.hpp"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace hft::core;
+
+// Aggregated book update latency: PriceLadderBook against a std::map book
+// Both books consume the same stream of enriched order messages, as
+// ItchParser emits them with order tracking, over 1,000 instruments whose
+// prices drift so the ladder windows have to recentre. Every update is
+// followed by a best bid/offer read, the usual strategy access pattern.
+
+constexpr uint32_t INSTRUMENTS = 1000;
+constexpr size_t SESSION_MESSAGES = 4000000;
+constexpr int64_t TICK = 100; // $0.01 at price scale 10000
+
+// Reference: one ordered map per book side
+class MapBook {
+public:
+  MapBook() : books_(INSTRUMENTS) {}
+
+  void apply(const NormalizedMessage &msg) {
+    Book &book = books_[msg.instrument_id];
+    if (msg.type == NormalizedMessage::Type::ORDER_ADD) {
+      BookLevel &level = msg.side == 0 ? book.bids[msg.price]
+                                       : book.asks[msg.price];
+      level.price = msg.price;
+      level.quantity += msg.quantity;
+      level.orders++;
+      return;
+    }
+    const bool gone = msg.type == NormalizedMessage::Type::ORDER_DELETE ||
+                      msg.remaining_quantity == 0;
+    if (msg.side == 0) {
+      reduce(book.bids, msg.price, msg.quantity, gone);
+    } else {
+      reduce(book.asks, msg.price, msg.quantity, gone);
+    }
+  }
+
+  bool best(uint32_t instrument_id, uint8_t side, BookLevel &out) const {
+    const Book &book = books_[instrument_id];
+    if (side == 0) {
+      if (book.bids.empty()) {
+        return false;
+      }
+      out = book.bids.begin()->second;
+      return true;
+    }
+    if (book.asks.empty()) {
+      return false;
+    }
+    out = book.asks.begin()->second;
+    return true;
+  }
+
+private:
+  struct Book {
+    std::map<int64_t, BookLevel, std::greater<int64_t>> bids;
+    std::map<int64_t, BookLevel> asks;
+  };
+
+  template <typename Levels>
+  static void reduce(Levels &levels, int64_t price, uint64_t quantity,
+                     bool gone) {
+    auto it = levels.find(price);
+    if (it == levels.end()) {
+      return;
+    }
+    if (quantity >= it->second.quantity) {
+      levels.erase(it);
+      return;
+    }
+    it->second.quantity -= quantity;
+    it->second.orders -= gone ? 1 : 0;
+  }
+
+  std::vector<Book> books_;
+};
+
+// Session generator - keeps the live orders so every event refers to an
+// order that is actually resting
+class SessionGenerator {
+public:
+  SessionGenerator() : rng_(2025), books_(INSTRUMENTS) {
+    for (uint32_t i = 0; i < INSTRUMENTS; ++i) {
+      books_[i].mid = (20 + i % 480) * 10000;
+    }
+  }
+
+  std::vector<NormalizedMessage> generate(size_t count) {
+    std::vector<NormalizedMessage> session;
+    session.reserve(count);
+    while (session.size() < count) {
+      const uint32_t instrument = pick_instrument();
+      Book &book = books_[instrument];
+      // Prices wander a tick at a time
+      if (rng_() % 4 == 0) {
+        book.mid += rng_() % 2 ? TICK : -TICK;
+      }
+
+      const uint64_t action = rng_() % 100;
+      if (action < 50 || book.live.empty()) {
+        const uint8_t side = rng_() % 2;
+        const double u =
+            std::uniform_real_distribution<double>(1e-9, 1.0)(rng_);
+        const int64_t ticks = 1 + std::min<int64_t>(
+                                      static_cast<int64_t>(-std::log(u) * 3),
+                                      100);
+        Order order{side == 0 ? book.mid - ticks * TICK
+                              : book.mid + ticks * TICK,
+                    100 * (1 + rng_() % 10), side};
+        session.push_back(message(NormalizedMessage::Type::ORDER_ADD,
+                                  instrument, order, order.remaining));
+        session.back().remaining_quantity =
+            static_cast<uint32_t>(order.remaining);
+        book.live.push_back(order);
+        continue;
+      }
+
+      // Recent orders are the likeliest to go
+      const size_t size = book.live.size();
+      const size_t back = std::min<size_t>(rng_() % 16, size - 1);
+      const size_t slot = size - 1 - back;
+      Order &order = book.live[slot];
+      uint64_t shares = order.remaining;
+      NormalizedMessage::Type type = NormalizedMessage::Type::ORDER_DELETE;
+      if (action >= 95) {
+        type = NormalizedMessage::Type::ORDER_EXECUTE;
+        shares = 1 + rng_() % order.remaining;
+      } else if (action >= 90) {
+        type = NormalizedMessage::Type::ORDER_MODIFY;
+        shares = std::max<uint64_t>(order.remaining / 2, 1);
+      }
+      order.remaining -= shares;
+      session.push_back(message(type, instrument, order, shares));
+      if (order.remaining == 0) {
+        book.live[slot] = book.live.back();
+        book.live.pop_back();
+      }
+    }
+    return session;
+  }
+
+private:
+  struct Order {
+    int64_t price;
+    uint64_t remaining;
+    uint8_t side;
+  };
+
+  struct Book {
+    int64_t mid{0};
+    std::vector<Order> live;
+  };
+
+  // Skewed towards low instrument ids
+  uint32_t pick_instrument() {
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    return static_cast<uint32_t>(INSTRUMENTS * u * u * u);
+  }
+
+  static NormalizedMessage message(NormalizedMessage::Type type,
+                                   uint32_t instrument, const Order &order,
+                                   uint64_t quantity) {
+    NormalizedMessage msg;
+    msg.type = type;
+    msg.instrument_id = instrument;
+    msg.side = order.side;
+    msg.price = order.price;
+    msg.quantity = quantity;
+    msg.remaining_quantity = static_cast<uint32_t>(order.remaining);
+    msg.flags = NormalizedMessage::FLAG_ENRICHED;
+    return msg;
+  }
+
+  std::mt19937_64 rng_;
+  std::vector<Book> books_;
+};
+
+struct Result {
+  double seconds{0};
+  uint64_t checksum{0};
+};
+
+// Apply every message and read the touch of its instrument
+template <typename BookType>
+static Result replay(BookType &book,
+                     const std::vector<NormalizedMessage> &session) {
+  Result result;
+  BookLevel level;
+  const auto start = std::chrono::steady_clock::now();
+  for (const NormalizedMessage &msg : session) {
+    book.apply(msg);
+    if (book.best(msg.instrument_id, msg.side, level)) {
+      result.checksum += level.quantity;
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  result.seconds = std::chrono::duration<double>(end - start).count();
+  return result;
+}
+
+template <typename BookType>
+static void print_latency(const char *name, BookType &book,
+                          const std::vector<NormalizedMessage> &session) {
+  LatencyHistogram histogram;
+  BookLevel level;
+  for (const NormalizedMessage &msg : session) {
+    const Timestamp start = get_timestamp();
+    book.apply(msg);
+    book.best(msg.instrument_id, msg.side, level);
+    histogram.record(get_timestamp() - start);
+  }
+  std::cout << "  " << std::left << std::setw(12) << name << std::right
+            << "p50 " << std::setw(5) << histogram.percentile(50.0)
+            << "  p99 " << std::setw(5) << histogram.percentile(99.0)
+            << "  p99.9 " << std::setw(6) << histogram.percentile(99.9)
+            << "\n";
+}
+
+int main() {
+  std::cout << "Price Ladder Benchmark\n";
+  std::cout << "======================\n";
+
+  SessionGenerator generator;
+  const std::vector<NormalizedMessage> session =
+      generator.generate(SESSION_MESSAGES);
+  std::cout << "Messages: " << session.size() << " across " << INSTRUMENTS
+            << " instruments\n\n";
+
+  PriceLadderConfig config;
+  config.max_instruments = INSTRUMENTS;
+  config.max_ladders = INSTRUMENTS;
+  config.window_ticks = 256; // Narrow enough for the drift to leave it
+  config.overflow_levels = 1024; // Deep enough to keep every level
+  PriceLadderBook ladders(config);
+  MapBook maps;
+
+  // Warm up both (ladder storage, map nodes), then time clean replays
+  replay(ladders, session);
+  ladders.clear();
+  const Result ladder = replay(ladders, session);
+  replay(maps, session);
+  MapBook timed_maps;
+  const Result map = replay(timed_maps, session);
+
+  if (ladder.checksum != map.checksum) {
+    std::cerr << "Books disagree on the touch\n";
+    return 1;
+  }
+
+  uint64_t recentres = 0;
+  size_t overflow = 0;
+  for (uint32_t i = 0; i < INSTRUMENTS; ++i) {
+    if (const PriceLadder *book = ladders.ladder(i)) {
+      recentres += book->recentres();
+      overflow += book->overflow_levels();
+    }
+  }
+
+  const double messages = static_cast<double>(session.size());
+  std::cout << std::fixed << std::setprecision(1)
+            << "Update + best bid/offer (ns/msg)\n"
+            << "  PriceLadder " << ladder.seconds * 1e9 / messages << "\n"
+            << "  std::map    " << map.seconds * 1e9 / messages << "\n"
+            << "  Speedup     " << std::setprecision(2)
+            << map.seconds / ladder.seconds << "x\n"
+            << "Window recentres: " << recentres
+            << ", levels in overflow at close: " << overflow << "\n\n";
+
+  // Per-message latency, clock reads included
+  ladders.clear();
+  MapBook latency_maps;
+  std::cout << "Per-message latency (ns, includes two clock reads)\n";
+  print_latency("PriceLadder", ladders, session);
+  print_latency("std::map", latency_maps, session);
+
+  return 0;
+}
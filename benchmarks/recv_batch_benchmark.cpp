@@ -0,0 +1,120 @@
+#include "../core/network/udp_receiver.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hft::core;
+
+// Receive throughput: recvfrom loop vs recvmmsg batching
+// Sender and receiver share the loopback multicast path, so absolute numbers
+// depend heavily on the host; compare the rows against each other.
+
+constexpr const char *GROUP = "239.1.1.77";
+constexpr uint16_t PORT = 10077;
+constexpr size_t PAYLOAD_SIZE = 256; // Typical small ITCH datagram
+constexpr auto RUN_TIME = std::chrono::seconds(2);
+
+struct Result {
+  uint64_t received;
+  uint64_t ring_dropped;
+  uint64_t sent;
+  double seconds;
+};
+
+static Result run(size_t batch_size) {
+  UDPConfig config;
+  config.multicast_group = GROUP;
+  config.port = PORT;
+  config.recv_batch_size = batch_size;
+
+  UDPReceiver receiver(config);
+  if (!receiver.initialize()) {
+    std::cerr << "Failed to initialize receiver (multicast unavailable?)\n";
+    return {0, 0, 0, 0.0};
+  }
+  receiver.start();
+
+  std::atomic<bool> sending{true};
+  std::atomic<uint64_t> sent{0};
+
+  // Sender - blast fixed-size datagrams at the group
+  std::thread sender([&]() {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    unsigned char loop = 1;
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    inet_pton(AF_INET, GROUP, &addr.sin_addr);
+
+    std::vector<uint8_t> payload(PAYLOAD_SIZE, 0xAB);
+    uint64_t count = 0;
+    while (sending.load(std::memory_order_relaxed)) {
+      if (sendto(fd, payload.data(), payload.size(), 0,
+                 reinterpret_cast<struct sockaddr *>(&addr),
+                 sizeof(addr)) > 0) {
+        count++;
+      }
+    }
+    sent.store(count);
+    close(fd);
+  });
+
+  // Consumer - drain the ring so it never becomes the bottleneck
+  std::atomic<bool> draining{true};
+  std::thread consumer([&]() {
+    MessageView view;
+    while (draining.load(std::memory_order_relaxed)) {
+      if (!receiver.read_packet(view)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(RUN_TIME);
+  sending.store(false);
+  sender.join();
+  auto end = std::chrono::steady_clock::now();
+
+  // Let in-flight datagrams land before reading counters
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  draining.store(false);
+  consumer.join();
+  receiver.stop();
+
+  const Statistics &stats = receiver.get_stats();
+  double seconds = std::chrono::duration<double>(end - start).count();
+  return {stats.packets_received, stats.packets_dropped, sent.load(), seconds};
+}
+
+int main() {
+  std::cout << "UDP Receive Batching Benchmark\n";
+  std::cout << "==============================\n";
+  std::cout << "Payload: " << PAYLOAD_SIZE << " bytes, "
+            << "duration: " << RUN_TIME.count() << "s per run\n\n";
+
+  std::cout << std::setw(8) << "batch" << std::setw(14) << "sent"
+            << std::setw(14) << "received" << std::setw(12) << "ring drop"
+            << std::setw(14) << "rx pkt/s" << "\n";
+
+  for (size_t batch : {size_t{1}, size_t{8}, size_t{32}, size_t{64}}) {
+    Result r = run(batch);
+    if (r.seconds == 0.0) {
+      return 1;
+    }
+
+    const std::string label = batch == 1 ? "recvfrom" : std::to_string(batch);
+    std::cout << std::setw(8) << label << std::setw(14) << r.sent
+              << std::setw(14) << r.received << std::setw(12) << r.ring_dropped << std::setw(14) << std::fixed
+              << std::setprecision(0) << (r.received / r.seconds) << "\n";
+  }
+
+  return 0;
+}
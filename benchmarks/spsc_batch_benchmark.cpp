@@ -0,0 +1,106 @@
+#include "../core/distribution/lockfree_queue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#include <vector>
+
+using namespace hft::core;
+
+// Cross-core SPSC throughput at different batch sizes
+// Producer and consumer are pinned to separate CPUs (when available) so the
+// index cache lines actually bounce between cores.
+
+constexpr size_t NUM_MESSAGES = 20000000;
+constexpr int PRODUCER_CPU = 0;
+constexpr int CONSUMER_CPU = 1;
+
+using Queue = SPSCQueue<NormalizedMessage, config::DEFAULT_QUEUE_SIZE>;
+
+static void pin_current_thread(int cpu) {
+  if (cpu >= static_cast<int>(std::thread::hardware_concurrency())) {
+    return;
+  }
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+}
+
+static double run(size_t batch) {
+  auto queue = std::make_unique<Queue>();
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::thread producer([&queue, batch]() {
+    pin_current_thread(PRODUCER_CPU);
+    std::vector<NormalizedMessage> messages(batch);
+    size_t sent = 0;
+
+    while (sent < NUM_MESSAGES) {
+      const size_t count = std::min(batch, NUM_MESSAGES - sent);
+      for (size_t i = 0; i < count; ++i) {
+        messages[i].sequence = static_cast<uint32_t>(sent + i);
+      }
+
+      size_t pushed = 0;
+      while (pushed < count) {
+        const size_t n =
+            batch == 1 ? (queue->push(messages[0]) ? 1 : 0)
+                       : queue->push_n(messages.data() + pushed, count - pushed);
+        if (n == 0) {
+          std::this_thread::yield();
+        }
+        pushed += n;
+      }
+      sent += count;
+    }
+  });
+
+  std::thread consumer([&queue, batch]() {
+    pin_current_thread(CONSUMER_CPU);
+    std::vector<NormalizedMessage> messages(batch);
+    size_t received = 0;
+
+    while (received < NUM_MESSAGES) {
+      const size_t n = batch == 1 ? (queue->pop(messages[0]) ? 1 : 0)
+                                  : queue->pop_n(messages.data(), batch);
+      if (n == 0) {
+        std::this_thread::yield();
+      }
+      received += n;
+    }
+  });
+
+  producer.join();
+  consumer.join();
+
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+int main() {
+  std::cout << "SPSC Queue Batch Benchmark\n";
+  std::cout << "==========================\n";
+  std::cout << "Messages: " << NUM_MESSAGES << " x " << sizeof(NormalizedMessage)
+            << " bytes, CPUs " << PRODUCER_CPU << " -> " << CONSUMER_CPU
+            << " (" << std::thread::hardware_concurrency()
+            << " available)\n\n";
+
+  std::cout << std::setw(8) << "batch" << std::setw(12) << "time (s)"
+            << std::setw(14) << "M msgs/sec" << std::setw(12) << "ns/msg"
+            << "\n";
+
+  for (size_t batch : {size_t{1}, size_t{8}, size_t{64}}) {
+    const double seconds = run(batch);
+    std::cout << std::setw(8) << batch << std::setw(12) << std::fixed
+              << std::setprecision(3) << seconds << std::setw(14)
+              << std::setprecision(2) << (NUM_MESSAGES / seconds / 1e6)
+              << std::setw(12) << (seconds * 1e9 / NUM_MESSAGES) << "\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+#include "../core/core_engine.hpp"
+#include "../core/network/replay_source.hpp"
+#include "../core/static_engine.hpp"
+#include "../protocols/itch50/itch50_parser.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace hft::core;
+using namespace hft::protocols::itch50;
+
+// StaticEngine vs CoreEngine on the same replayed ITCH packets
+// Both run on one thread with two subscribers delivered synchronously
+// (CoreEngine uses inline subscribers), so the difference is the cost of
+// virtual parse/on_message calls and the dispatcher versus a pipeline the
+// compiler can inline end to end.
+
+constexpr size_t NUM_PACKETS = 4096;
+constexpr size_t MESSAGES_PER_PACKET = 8;
+constexpr size_t LOOPS = 250;
+
+static void write_u16_be(uint8_t *dest, uint16_t value) {
+  dest[0] = (value >> 8) & 0xFF;
+  dest[1] = value & 0xFF;
+}
+
+static void write_u32_be(uint8_t *dest, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    dest[i] = (value >> (24 - 8 * i)) & 0xFF;
+  }
+}
+
+static void write_u64_be(uint8_t *dest, uint64_t value) {
+  for (int i = 0; i < 8; ++i) {
+    dest[i] = (value >> (56 - 8 * i)) & 0xFF;
+  }
+}
+
+// Packet of length-prefixed add / execute / delete / trade messages
+static std::vector<uint8_t> build_packet(uint64_t first_order) {
+  std::vector<uint8_t> packet;
+
+  for (size_t i = 0; i < MESSAGES_PER_PACKET; ++i) {
+    const uint64_t order = first_order + i;
+    std::vector<uint8_t> msg;
+
+    switch (i % 4) {
+    case 0:
+      msg.resize(AddOrderMessage::SIZE);
+      msg[12] = 'A';
+      write_u64_be(&msg[13], order);
+      msg[21] = 'B';
+      write_u32_be(&msg[22], 100);
+      std::memcpy(&msg[26], "AAPL    ", 8);
+      write_u32_be(&msg[34], 1500000 + static_cast<uint32_t>(order % 100));
+      break;
+    case 1:
+      msg.resize(OrderExecutedMessage::SIZE);
+      msg[12] = 'E';
+      write_u64_be(&msg[13], order);
+      write_u32_be(&msg[21], 50);
+      write_u64_be(&msg[25], order);
+      break;
+    case 2:
+      msg.resize(OrderDeleteMessage::SIZE);
+      msg[12] = 'D';
+      write_u64_be(&msg[13], order);
+      break;
+    default:
+      msg.resize(TradeMessage::SIZE);
+      msg[12] = 'P';
+      write_u64_be(&msg[13], order);
+      msg[21] = 'S';
+      write_u32_be(&msg[22], 200);
+      std::memcpy(&msg[26], "MSFT    ", 8);
+      write_u32_be(&msg[34], 3000000);
+      write_u64_be(&msg[38], order);
+      break;
+    }
+
+    write_u16_be(&msg[0], static_cast<uint16_t>(1 + order % 64));
+    write_u64_be(&msg[4], order * 1000);
+
+    uint8_t length[2];
+    write_u16_be(length, static_cast<uint16_t>(msg.size() + 2));
+    packet.insert(packet.end(), length, length + 2);
+    packet.insert(packet.end(), msg.begin(), msg.end());
+  }
+
+  return packet;
+}
+
+// Typical light subscriber: counts and accumulates volume
+class VolumeSubscriber final : public ISubscriber {
+public:
+  bool on_message(const NormalizedMessage &msg) noexcept override {
+    count_++;
+    volume_ += msg.quantity;
+    return true;
+  }
+
+  const char *name() const noexcept override { return "VolumeSubscriber"; }
+
+  uint64_t count() const noexcept { return count_; }
+  uint64_t volume() const noexcept { return volume_; }
+
+private:
+  uint64_t count_{0};
+  uint64_t volume_{0};
+};
+
+static void fill(ReplaySource &source) {
+  for (size_t i = 0; i < NUM_PACKETS; ++i) {
+    source.add_packet(build_packet(i * MESSAGES_PER_PACKET));
+  }
+}
+
+static void report(const char *label, double seconds, uint64_t messages,
+                   uint64_t volume) {
+  std::cout << std::setw(24) << label << std::setw(12) << std::fixed
+            << std::setprecision(3) << seconds << std::setw(12)
+            << std::setprecision(2) << (seconds * 1e9 / messages)
+            << std::setw(14) << messages << std::setw(16) << volume << "\n";
+}
+
+int main() {
+  std::cout << "Static vs Virtual Pipeline Benchmark\n";
+  std::cout << "====================================\n";
+  std::cout << NUM_PACKETS << " packets x " << MESSAGES_PER_PACKET
+            << " ITCH messages, replayed " << LOOPS << " times\n\n";
+
+  std::cout << std::setw(24) << "engine" << std::setw(12) << "time (s)"
+            << std::setw(12) << "ns/msg" << std::setw(14) << "messages"
+            << std::setw(16) << "volume" << "\n";
+
+  // CoreEngine: virtual parser, dispatcher, virtual inline subscribers
+  {
+    ReplaySource source(LOOPS);
+    fill(source);
+
+    CoreEngine engine;
+    engine.set_parser(std::make_unique<ItchParser>());
+    SubscriberOptions options;
+    options.inline_dispatch = true;
+    auto first = std::make_unique<VolumeSubscriber>();
+    auto second = std::make_unique<VolumeSubscriber>();
+    VolumeSubscriber *first_ptr = first.get();
+    VolumeSubscriber *second_ptr = second.get();
+    engine.add_subscriber(std::move(first), options);
+    engine.add_subscriber(std::move(second), options);
+
+    auto start = std::chrono::steady_clock::now();
+    MessageView packet;
+    while (source.peek_packet(packet)) {
+      engine.process_packet(packet);
+      source.release_packet();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    report("CoreEngine (inline)",
+           std::chrono::duration<double>(end - start).count(),
+           first_ptr->count(), first_ptr->volume() + second_ptr->volume());
+  }
+
+  // StaticEngine: everything known at compile time
+  {
+    ReplaySource source(LOOPS);
+    fill(source);
+
+    StaticEngine<ReplaySource, ItchParser, VolumeSubscriber, VolumeSubscriber>
+        engine(source);
+
+    auto start = std::chrono::steady_clock::now();
+    while (source.has_packets()) {
+      engine.poll();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    report("StaticEngine",
+           std::chrono::duration<double>(end - start).count(),
+           engine.subscriber<0>().count(),
+           engine.subscriber<0>().volume() + engine.subscriber<1>().volume());
+  }
+
+  return 0;
+}
@@ -0,0 +1,499 @@
+#pragma once
+
+#include "../distribution/subscriber.hpp"
+#include "../types.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace hft {
+namespace core {
+
+// One price level of a book
+struct BookLevel {
+  int64_t price{0};     // Fixed point (scale: 10000)
+  uint64_t quantity{0}; // Shares resting at this price
+  uint32_t orders{0};   // Orders queued at this price
+};
+
+// A resting order
+struct BookOrder {
+  uint64_t order_id{0};
+  uint32_t instrument_id{0};
+  uint8_t side{0}; // 0=buy, 1=sell
+  int64_t price{0};
+  uint64_t quantity{0};
+};
+
+// Pool sizes are fixed at construction; nothing is allocated per message
+// once every active book side has grown past reserve_levels
+struct OrderBookConfig {
+  size_t max_orders{1 << 20};    // Resting orders across all books
+  size_t max_levels{1 << 18};    // Price levels across all books
+  size_t max_instruments{65536}; // Books for instrument ids below this
+  size_t reserve_levels{64};     // Per book side, reserved on first use
+};
+
+struct OrderBookStats {
+  uint64_t adds{0};
+  uint64_t executions{0};
+  uint64_t cancels{0};
+  uint64_t deletes{0};
+  uint64_t unknown_orders{0}; // Events for orders not on the book
+  uint64_t rejected{0};       // Adds refused: duplicate id, bad instrument
+                              // or a pool ran out
+};
+
+// Order id -> order node, open addressing with linear probing.
+// Sized to at most half full, so probes stay short; deletes shift later
+// entries back instead of leaving tombstones.
+class OrderIndex {
+public:
+  static constexpr uint32_t NIL = UINT32_MAX;
+
+  explicit OrderIndex(size_t max_entries)
+      : capacity_(capacity_for(max_entries)), mask_(capacity_ - 1),
+        shift_(64 - log2(capacity_)), slots_(capacity_) {}
+
+  // NIL if absent
+  uint32_t find(uint64_t key) const noexcept {
+    for (size_t i = home(key);; i = (i + 1) & mask_) {
+      const Slot &slot = slots_[i];
+      if (slot.value == NIL || slot.key == key) {
+        return slot.value;
+      }
+    }
+  }
+
+  // False if the key is already present
+  bool insert(uint64_t key, uint32_t value) noexcept {
+    for (size_t i = home(key);; i = (i + 1) & mask_) {
+      Slot &slot = slots_[i];
+      if (slot.value == NIL) {
+        slot.key = key;
+        slot.value = value;
+        return true;
+      }
+      if (slot.key == key) {
+        return false;
+      }
+    }
+  }
+
+  void erase(uint64_t key) noexcept {
+    size_t hole = home(key);
+    while (slots_[hole].key != key) {
+      if (slots_[hole].value == NIL) {
+        return;
+      }
+      hole = (hole + 1) & mask_;
+    }
+    if (slots_[hole].value == NIL) {
+      return;
+    }
+
+    // Pull back later entries of the run that may sit at the hole
+    slots_[hole].value = NIL;
+    for (size_t i = (hole + 1) & mask_; slots_[i].value != NIL;
+         i = (i + 1) & mask_) {
+      const size_t from_home = (i - home(slots_[i].key)) & mask_;
+      if (from_home >= ((i - hole) & mask_)) {
+        slots_[hole] = slots_[i];
+        slots_[i].value = NIL;
+        hole = i;
+      }
+    }
+  }
+
+  void clear() noexcept {
+    for (Slot &slot : slots_) {
+      slot.value = NIL;
+    }
+  }
+
+private:
+  struct Slot {
+    uint64_t key{0};
+    uint32_t value{NIL};
+  };
+
+  static size_t capacity_for(size_t max_entries) noexcept {
+    size_t capacity = 16;
+    while (capacity < max_entries * 2) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  static unsigned log2(size_t value) noexcept {
+    unsigned bits = 0;
+    while (value > 1) {
+      value >>= 1;
+      bits++;
+    }
+    return bits;
+  }
+
+  // Fibonacci hashing spreads near-sequential ids across the table
+  size_t home(uint64_t key) const noexcept {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift_);
+  }
+
+  size_t capacity_;
+  size_t mask_;
+  unsigned shift_;
+  std::vector<Slot> slots_;
+};
+
+// Full-depth (L3) order books for all instruments, built from normalized
+// order messages. Orders and price levels come from shared fixed-size pools;
+// each level queues its orders FIFO (time priority), and each book side
+// keeps its levels sorted by price with the best at the back, where most
+// activity lands.
+// Single-threaded: apply and query from one thread.
+class OrderBook {
+public:
+  static constexpr uint8_t BID = 0;
+  static constexpr uint8_t ASK = 1;
+  static constexpr uint32_t NIL = OrderIndex::NIL;
+
+  explicit OrderBook(const OrderBookConfig &config = OrderBookConfig{})
+      : config_(config), orders_(config.max_orders),
+        levels_(config.max_levels), books_(config.max_instruments),
+        index_(config.max_orders) {
+    clear();
+  }
+
+  OrderBook(const OrderBook &) = delete;
+  OrderBook &operator=(const OrderBook &) = delete;
+
+  // Apply an order message; other message types are ignored.
+  // ORDER_EXECUTE and ORDER_MODIFY take quantity shares off the order (an
+  // ITCH cancel is an ORDER_MODIFY); ITCH replaces must arrive as a delete
+  // and an add, i.e. from ItchParser with order tracking enabled.
+  // Returns false if the message could not be applied
+  bool apply(const NormalizedMessage &msg) noexcept {
+    switch (msg.type) {
+    case NormalizedMessage::Type::ORDER_ADD:
+      return add_order(msg.instrument_id, msg.order_id, msg.side, msg.price,
+                       msg.quantity);
+    case NormalizedMessage::Type::ORDER_EXECUTE:
+      stats_.executions++;
+      return reduce_order(msg.order_id, msg.quantity);
+    case NormalizedMessage::Type::ORDER_MODIFY:
+      stats_.cancels++;
+      return reduce_order(msg.order_id, msg.quantity);
+    case NormalizedMessage::Type::ORDER_DELETE:
+      stats_.deletes++;
+      return delete_order(msg.order_id);
+    default:
+      return true;
+    }
+  }
+
+  // Queue an order at the back of its price level
+  bool add_order(uint32_t instrument_id, uint64_t order_id, uint8_t side,
+                 int64_t price, uint64_t quantity) noexcept {
+    stats_.adds++;
+    if (instrument_id >= books_.size() || side > ASK || free_order_ == NIL) {
+      stats_.rejected++;
+      return false;
+    }
+
+    const uint32_t node = free_order_;
+    if (!index_.insert(order_id, node)) {
+      stats_.rejected++;
+      return false;
+    }
+    const uint32_t level = find_or_add_level(instrument_id, side, price);
+    if (level == NIL) {
+      index_.erase(order_id);
+      stats_.rejected++;
+      return false;
+    }
+    free_order_ = orders_[node].next;
+
+    OrderNode &order = orders_[node];
+    order.order_id = order_id;
+    order.quantity = quantity;
+    order.level = level;
+    order.instrument_id = instrument_id;
+    order.side = side;
+
+    LevelNode &queue = levels_[level];
+    order.prev = queue.tail;
+    order.next = NIL;
+    if (queue.tail == NIL) {
+      queue.head = node;
+    } else {
+      orders_[queue.tail].next = node;
+    }
+    queue.tail = node;
+    queue.orders++;
+    queue.quantity += quantity;
+    order_count_++;
+    return true;
+  }
+
+  // Take shares off an order (execution or partial cancel), keeping its
+  // queue position; the order leaves the book when nothing remains
+  bool reduce_order(uint64_t order_id, uint64_t quantity) noexcept {
+    const uint32_t node = index_.find(order_id);
+    if (node == NIL) {
+      stats_.unknown_orders++;
+      return false;
+    }
+    OrderNode &order = orders_[node];
+    if (quantity >= order.quantity) {
+      remove(order_id, node);
+      return true;
+    }
+    order.quantity -= quantity;
+    levels_[order.level].quantity -= quantity;
+    return true;
+  }
+
+  bool delete_order(uint64_t order_id) noexcept {
+    const uint32_t node = index_.find(order_id);
+    if (node == NIL) {
+      stats_.unknown_orders++;
+      return false;
+    }
+    remove(order_id, node);
+    return true;
+  }
+
+  bool find_order(uint64_t order_id, BookOrder &out) const noexcept {
+    const uint32_t node = index_.find(order_id);
+    if (node == NIL) {
+      return false;
+    }
+    const OrderNode &order = orders_[node];
+    out.order_id = order.order_id;
+    out.instrument_id = order.instrument_id;
+    out.side = order.side;
+    out.price = levels_[order.level].price;
+    out.quantity = order.quantity;
+    return true;
+  }
+
+  // Best level of one side; false if that side is empty
+  bool best(uint32_t instrument_id, uint8_t side,
+            BookLevel &out) const noexcept {
+    return depth(instrument_id, side, &out, 1) == 1;
+  }
+
+  // Up to max_levels levels of one side, best first; returns the count
+  size_t depth(uint32_t instrument_id, uint8_t side, BookLevel *out,
+               size_t max_levels) const noexcept {
+    if (instrument_id >= books_.size() || side > ASK) {
+      return 0;
+    }
+    const std::vector<LevelRef> &refs = books_[instrument_id].sides[side];
+    const size_t count = std::min(max_levels, refs.size());
+    for (size_t i = 0; i < count; ++i) {
+      const LevelNode &level = levels_[refs[refs.size() - 1 - i].level];
+      out[i].price = level.price;
+      out[i].quantity = level.quantity;
+      out[i].orders = level.orders;
+    }
+    return count;
+  }
+
+  // Visit the orders queued at one price in time priority; fn receives
+  // each BookOrder. Returns the number visited
+  template <typename F>
+  size_t for_each_order(uint32_t instrument_id, uint8_t side, int64_t price,
+                        F &&fn) const {
+    if (instrument_id >= books_.size() || side > ASK) {
+      return 0;
+    }
+    const std::vector<LevelRef> &refs = books_[instrument_id].sides[side];
+    const auto it = position(refs, side, price);
+    if (it == refs.end() || it->price != price) {
+      return 0;
+    }
+
+    size_t visited = 0;
+    BookOrder order;
+    order.instrument_id = instrument_id;
+    order.side = side;
+    order.price = price;
+    for (uint32_t node = levels_[it->level].head; node != NIL;
+         node = orders_[node].next) {
+      order.order_id = orders_[node].order_id;
+      order.quantity = orders_[node].quantity;
+      fn(static_cast<const BookOrder &>(order));
+      visited++;
+    }
+    return visited;
+  }
+
+  size_t order_count() const noexcept { return order_count_; }
+  size_t level_count() const noexcept { return level_count_; }
+  const OrderBookStats &stats() const noexcept { return stats_; }
+  const OrderBookConfig &config() const noexcept { return config_; }
+
+  // Empty every book; pools and reserved level storage are kept
+  void clear() noexcept {
+    for (size_t i = 0; i < orders_.size(); ++i) {
+      orders_[i].next = i + 1 < orders_.size() ? static_cast<uint32_t>(i + 1)
+                                               : NIL;
+    }
+    free_order_ = orders_.empty() ? NIL : 0;
+    for (size_t i = 0; i < levels_.size(); ++i) {
+      levels_[i].head = i + 1 < levels_.size() ? static_cast<uint32_t>(i + 1)
+                                               : NIL;
+    }
+    free_level_ = levels_.empty() ? NIL : 0;
+    for (Book &book : books_) {
+      book.sides[BID].clear();
+      book.sides[ASK].clear();
+    }
+    index_.clear();
+    order_count_ = 0;
+    level_count_ = 0;
+    stats_ = OrderBookStats{};
+  }
+
+private:
+  struct OrderNode {
+    uint64_t order_id{0};
+    uint64_t quantity{0};
+    uint32_t level{NIL};
+    uint32_t prev{NIL};
+    uint32_t next{NIL}; // Free-list link when unused
+    uint32_t instrument_id{0};
+    uint8_t side{0};
+  };
+
+  struct LevelNode {
+    int64_t price{0};
+    uint64_t quantity{0};
+    uint32_t head{NIL}; // Free-list link when unused
+    uint32_t tail{NIL};
+    uint32_t orders{0};
+  };
+
+  // Price kept beside the level so searches stay in one array
+  struct LevelRef {
+    int64_t price;
+    uint32_t level;
+  };
+
+  // Levels per side, worst to best: bids ascending, asks descending
+  struct Book {
+    std::vector<LevelRef> sides[2];
+  };
+
+  // First level at or better than price
+  template <typename Refs>
+  static auto position(Refs &refs, uint8_t side, int64_t price) noexcept {
+    if (side == BID) {
+      return std::lower_bound(
+          refs.begin(), refs.end(), price,
+          [](const LevelRef &ref, int64_t p) { return ref.price < p; });
+    }
+    return std::lower_bound(
+        refs.begin(), refs.end(), price,
+        [](const LevelRef &ref, int64_t p) { return ref.price > p; });
+  }
+
+  uint32_t find_or_add_level(uint32_t instrument_id, uint8_t side,
+                             int64_t price) noexcept {
+    std::vector<LevelRef> &refs = books_[instrument_id].sides[side];
+    // Storage grows only until the side reaches its working depth
+    if (refs.capacity() == 0) {
+      refs.reserve(config_.reserve_levels);
+    }
+    const auto it = position(refs, side, price);
+    if (it != refs.end() && it->price == price) {
+      return it->level;
+    }
+    if (free_level_ == NIL) {
+      return NIL;
+    }
+
+    const uint32_t level = free_level_;
+    free_level_ = levels_[level].head;
+    LevelNode &node = levels_[level];
+    node.price = price;
+    node.quantity = 0;
+    node.head = NIL;
+    node.tail = NIL;
+    node.orders = 0;
+    refs.insert(it, LevelRef{price, level});
+    level_count_++;
+    return level;
+  }
+
+  void remove(uint64_t order_id, uint32_t node) noexcept {
+    OrderNode &order = orders_[node];
+    LevelNode &level = levels_[order.level];
+    if (order.prev == NIL) {
+      level.head = order.next;
+    } else {
+      orders_[order.prev].next = order.next;
+    }
+    if (order.next == NIL) {
+      level.tail = order.prev;
+    } else {
+      orders_[order.next].prev = order.prev;
+    }
+    level.orders--;
+    level.quantity -= order.quantity;
+
+    if (level.orders == 0) {
+      std::vector<LevelRef> &refs =
+          books_[order.instrument_id].sides[order.side];
+      refs.erase(position(refs, order.side, level.price));
+      level.head = free_level_;
+      free_level_ = order.level;
+      level_count_--;
+    }
+
+    index_.erase(order_id);
+    order.next = free_order_;
+    free_order_ = node;
+    order_count_--;
+  }
+
+  OrderBookConfig config_;
+  std::vector<OrderNode> orders_;
+  std::vector<LevelNode> levels_;
+  std::vector<Book> books_;
+  OrderIndex index_;
+  uint32_t free_order_{NIL};
+  uint32_t free_level_{NIL};
+  size_t order_count_{0};
+  size_t level_count_{0};
+  OrderBookStats stats_;
+};
+
+// Subscriber that maintains an OrderBook from the messages it receives.
+// Query the book from the delivery thread (e.g. in a derived on_message)
+// or once the engine has stopped.
+class OrderBookSubscriber : public ISubscriber {
+public:
+  explicit OrderBookSubscriber(
+      const OrderBookConfig &config = OrderBookConfig{},
+      const char *name = "OrderBookSubscriber")
+      : book_(config), name_(name) {}
+
+  bool on_message(const NormalizedMessage &msg) noexcept override {
+    book_.apply(msg);
+    return true;
+  }
+
+  const char *name() const noexcept override { return name_; }
+
+  OrderBook &book() noexcept { return book_; }
+  const OrderBook &book() const noexcept { return book_; }
+
+private:
+  OrderBook book_;
+  const char *name_;
+};
+
+} // namespace core
+} // namespace hft
@@ -0,0 +1,655 @@
+#pragma once
+
+#include "../distribution/subscriber.hpp"
+#include "../types.hpp"
+#include "order_book.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hft {
+namespace core {
+
+struct PriceLadderConfig {
+  int64_t tick_size{100};        // Price grid step ($0.01 at scale 10000)
+  size_t window_ticks{1024};     // Levels per side held in the array
+                                 // (power of two, 64 to 4096)
+  size_t overflow_levels{64};    // Per side, levels kept outside the window
+  size_t max_instruments{65536}; // Ladders for instrument ids below this
+  size_t max_ladders{1024};      // Ladders allocated up front, handed to
+                                 // instruments on their first order
+};
+
+struct PriceLadderStats {
+  uint64_t updates{0};   // Level changes applied
+  uint64_t unmatched{0}; // Reductions for a level not on the ladder
+  uint64_t untracked{0}; // Order events without price and side (not
+                         // FLAG_ENRICHED), ignored
+  uint64_t rejected{0};  // Bad instrument id or side, or no ladder left
+  uint64_t dropped{0};   // Updates that lost a level to a full overflow
+};
+
+// Aggregated (market-by-price) depth of one instrument.
+// Levels near the touch live in a tick-indexed array window; a two-level
+// occupancy bitmap per side (one bit per tick, one summary bit per 64 ticks)
+// finds the best price and walks the depth with bit scans. An improving
+// price outside the window recentres it; levels that fall out of it, and
+// prices off the tick grid, are kept in a small sorted overflow array so the
+// depth stays complete. The overflow is bounded: once a side's is full its
+// worst level is dropped and counted. All storage is allocated up front.
+// Single-threaded.
+class PriceLadder {
+public:
+  static constexpr uint8_t BID = 0;
+  static constexpr uint8_t ASK = 1;
+  static constexpr size_t MIN_WINDOW_TICKS = 64;
+  static constexpr size_t MAX_WINDOW_TICKS = 4096; // One summary word
+
+  explicit PriceLadder(int64_t tick_size = 100, size_t window_ticks = 1024,
+                       size_t overflow_levels = 64)
+      : tick_(tick_size > 0 ? tick_size : 1),
+        ticks_(window_size(window_ticks)), words_(ticks_ / 64), base_(0),
+        quantity_(std::make_unique<uint64_t[]>(2 * ticks_)),
+        orders_(std::make_unique<uint32_t[]>(2 * ticks_)),
+        bits_(std::make_unique<uint64_t[]>(2 * words_)), summary_{0, 0},
+        spill_capacity_(overflow_levels > 0 ? overflow_levels : 1),
+        spill_(std::make_unique<BookLevel[]>(2 * spill_capacity_)),
+        spill_size_{0, 0}, window_levels_(0), recentres_(0), dropped_(0) {}
+
+  PriceLadder(const PriceLadder &) = delete;
+  PriceLadder &operator=(const PriceLadder &) = delete;
+
+  // Add shares (and orders) at a price
+  // Returns false if a level was dropped from a full overflow on the way
+  bool add(uint8_t side, int64_t price, uint64_t quantity,
+           uint32_t orders = 1) noexcept {
+    if (quantity == 0) {
+      return true;
+    }
+    if (empty()) {
+      base_ = centred(price);
+    }
+
+    const uint64_t dropped = dropped_;
+    size_t index = 0;
+    if (!slot(price, index)) {
+      if (price % tick_ != 0 || !improves(side, price)) {
+        spill(side, BookLevel{price, quantity, orders});
+        return dropped_ == dropped;
+      }
+      recentre(side, price);
+      slot(price, index);
+    }
+
+    const size_t at = side * ticks_ + index;
+    if (quantity_[at] == 0) {
+      mark(side, index);
+      window_levels_++;
+    }
+    quantity_[at] += quantity;
+    orders_[at] += orders;
+    return dropped_ == dropped;
+  }
+
+  // Take shares (and orders) off a price; the level goes once no shares
+  // remain. False if there is no level at that price
+  bool reduce(uint8_t side, int64_t price, uint64_t quantity,
+              uint32_t orders = 0) noexcept {
+    size_t index = 0;
+    if (slot(price, index)) {
+      const size_t at = side * ticks_ + index;
+      if (quantity_[at] == 0) {
+        return false;
+      }
+      if (quantity >= quantity_[at]) {
+        quantity_[at] = 0;
+        orders_[at] = 0;
+        unmark(side, index);
+        window_levels_--;
+      } else {
+        quantity_[at] -= quantity;
+        orders_[at] -= std::min(orders, orders_[at]);
+      }
+      return true;
+    }
+
+    const size_t position = find_spill(side, price);
+    if (position == NONE) {
+      return false;
+    }
+    BookLevel &level = spill_at(side)[position];
+    if (quantity >= level.quantity) {
+      erase_spill(side, position);
+    } else {
+      level.quantity -= quantity;
+      level.orders -= std::min(orders, level.orders);
+    }
+    return true;
+  }
+
+  // Best level of one side; false if that side is empty
+  bool best(uint8_t side, BookLevel &out) const noexcept {
+    return depth(side, &out, 1) == 1;
+  }
+
+  // Up to max_levels levels of one side, best first; returns the count
+  size_t depth(uint8_t side, BookLevel *out,
+               size_t max_levels) const noexcept {
+    const BookLevel *levels = spill_at(side);
+    const size_t spilled = spill_size_[side];
+    size_t next = 0;
+    size_t index = summary_[side] != 0 ? best_index(side) : NONE;
+    size_t count = 0;
+    while (count < max_levels) {
+      if (index != NONE &&
+          (next == spilled ||
+           better(side, price_at(index), levels[next].price))) {
+        const size_t at = side * ticks_ + index;
+        out[count].price = price_at(index);
+        out[count].quantity = quantity_[at];
+        out[count].orders = orders_[at];
+        index = next_index(side, index);
+      } else if (next != spilled) {
+        out[count] = levels[next++];
+      } else {
+        break;
+      }
+      count++;
+    }
+    return count;
+  }
+
+  // Level at one price; false if nothing rests there
+  bool level(uint8_t side, int64_t price, BookLevel &out) const noexcept {
+    size_t index = 0;
+    if (slot(price, index)) {
+      const size_t at = side * ticks_ + index;
+      out.price = price;
+      out.quantity = quantity_[at];
+      out.orders = orders_[at];
+      return quantity_[at] != 0;
+    }
+    const size_t position = find_spill(side, price);
+    if (position == NONE) {
+      return false;
+    }
+    out = spill_at(side)[position];
+    return true;
+  }
+
+  bool empty() const noexcept {
+    return window_levels_ == 0 && spill_size_[BID] == 0 &&
+           spill_size_[ASK] == 0;
+  }
+
+  size_t level_count() const noexcept {
+    return window_levels_ + overflow_levels();
+  }
+
+  // Levels currently outside the array window
+  size_t overflow_levels() const noexcept {
+    return spill_size_[BID] + spill_size_[ASK];
+  }
+
+  // Levels lost because a side's overflow was full
+  uint64_t dropped_levels() const noexcept { return dropped_; }
+
+  // Times the window moved to follow the price
+  uint64_t recentres() const noexcept { return recentres_; }
+
+  int64_t tick_size() const noexcept { return tick_; }
+  size_t window_ticks() const noexcept { return ticks_; }
+
+  // Lowest price the window covers
+  int64_t window_base() const noexcept { return base_; }
+
+  void clear() noexcept {
+    std::fill(quantity_.get(), quantity_.get() + 2 * ticks_, 0);
+    std::fill(orders_.get(), orders_.get() + 2 * ticks_, 0);
+    std::fill(bits_.get(), bits_.get() + 2 * words_, 0);
+    summary_[BID] = 0;
+    summary_[ASK] = 0;
+    spill_size_[BID] = 0;
+    spill_size_[ASK] = 0;
+    window_levels_ = 0;
+    recentres_ = 0;
+    dropped_ = 0;
+  }
+
+private:
+  static constexpr size_t NONE = SIZE_MAX;
+
+  static size_t window_size(size_t ticks) noexcept {
+    size_t size = MIN_WINDOW_TICKS;
+    while (size < ticks && size < MAX_WINDOW_TICKS) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  static bool better(uint8_t side, int64_t a, int64_t b) noexcept {
+    return side == BID ? a > b : a < b;
+  }
+
+  // Window base that puts price in the middle
+  int64_t centred(int64_t price) const noexcept {
+    return (price / tick_ - static_cast<int64_t>(ticks_ / 2)) * tick_;
+  }
+
+  bool slot(int64_t price, size_t &index) const noexcept {
+    const int64_t offset = price - base_;
+    if (offset < 0) {
+      return false;
+    }
+    const uint64_t ticks = static_cast<uint64_t>(offset / tick_);
+    if (ticks >= ticks_ || static_cast<int64_t>(ticks) * tick_ != offset) {
+      return false;
+    }
+    index = static_cast<size_t>(ticks);
+    return true;
+  }
+
+  int64_t price_at(size_t index) const noexcept {
+    return base_ + static_cast<int64_t>(index) * tick_;
+  }
+
+  bool best_price(uint8_t side, int64_t &price) const noexcept {
+    bool found = false;
+    if (summary_[side] != 0) {
+      price = price_at(best_index(side));
+      found = true;
+    }
+    if (spill_size_[side] != 0) {
+      const int64_t spilled = spill_at(side)[0].price;
+      if (!found || better(side, spilled, price)) {
+        price = spilled;
+      }
+      found = true;
+    }
+    return found;
+  }
+
+  BookLevel *spill_at(uint8_t side) noexcept {
+    return &spill_[side * spill_capacity_];
+  }
+  const BookLevel *spill_at(uint8_t side) const noexcept {
+    return &spill_[side * spill_capacity_];
+  }
+
+  // First overflow position not better than price (overflow is best first)
+  size_t spill_position(uint8_t side, int64_t price) const noexcept {
+    const BookLevel *levels = spill_at(side);
+    size_t low = 0;
+    size_t high = spill_size_[side];
+    while (low < high) {
+      const size_t middle = (low + high) / 2;
+      if (better(side, levels[middle].price, price)) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  size_t find_spill(uint8_t side, int64_t price) const noexcept {
+    const size_t position = spill_position(side, price);
+    return position < spill_size_[side] &&
+                   spill_at(side)[position].price == price
+               ? position
+               : NONE;
+  }
+
+  // Merge a level into the overflow; a full side drops its worst level
+  void spill(uint8_t side, const BookLevel &level) noexcept {
+    BookLevel *levels = spill_at(side);
+    size_t &size = spill_size_[side];
+    const size_t position = spill_position(side, level.price);
+    if (position < size && levels[position].price == level.price) {
+      levels[position].quantity += level.quantity;
+      levels[position].orders += level.orders;
+      return;
+    }
+    if (size == spill_capacity_) {
+      dropped_++;
+      if (position == size) {
+        return; // The new level is the worst
+      }
+      size--;
+    }
+    std::copy_backward(levels + position, levels + size, levels + size + 1);
+    levels[position] = level;
+    size++;
+  }
+
+  void erase_spill(uint8_t side, size_t position) noexcept {
+    BookLevel *levels = spill_at(side);
+    std::copy(levels + position + 1, levels + spill_size_[side],
+              levels + position);
+    spill_size_[side]--;
+  }
+
+  bool improves(uint8_t side, int64_t price) const noexcept {
+    int64_t best;
+    return !best_price(side, best) || better(side, price, best);
+  }
+
+  void mark(uint8_t side, size_t index) noexcept {
+    const size_t word = index >> 6;
+    bits_[side * words_ + word] |= 1ULL << (index & 63);
+    summary_[side] |= 1ULL << word;
+  }
+
+  void unmark(uint8_t side, size_t index) noexcept {
+    const size_t word = index >> 6;
+    uint64_t &bits = bits_[side * words_ + word];
+    bits &= ~(1ULL << (index & 63));
+    if (bits == 0) {
+      summary_[side] &= ~(1ULL << word);
+    }
+  }
+
+  // Highest occupied index for bids, lowest for asks; the side must have
+  // a level in the window
+  size_t best_index(uint8_t side) const noexcept {
+    const uint64_t *bits = &bits_[side * words_];
+    if (side == BID) {
+      const size_t word = 63 - std::countl_zero(summary_[BID]);
+      return word * 64 + 63 - std::countl_zero(bits[word]);
+    }
+    const size_t word = std::countr_zero(summary_[ASK]);
+    return word * 64 + std::countr_zero(bits[word]);
+  }
+
+  // Next occupied index worse than index, NONE past the last level
+  size_t next_index(uint8_t side, size_t index) const noexcept {
+    const uint64_t *bits = &bits_[side * words_];
+    if (side == BID) {
+      if (index == 0) {
+        return NONE;
+      }
+      const size_t i = index - 1;
+      size_t word = i >> 6;
+      const uint64_t below = bits[word] & (~0ULL >> (63 - (i & 63)));
+      if (below != 0) {
+        return word * 64 + 63 - std::countl_zero(below);
+      }
+      const uint64_t words =
+          word == 0 ? 0 : summary_[BID] & (~0ULL >> (64 - word));
+      if (words == 0) {
+        return NONE;
+      }
+      word = 63 - std::countl_zero(words);
+      return word * 64 + 63 - std::countl_zero(bits[word]);
+    }
+
+    const size_t i = index + 1;
+    if (i >= ticks_) {
+      return NONE;
+    }
+    size_t word = i >> 6;
+    const uint64_t above = bits[word] & (~0ULL << (i & 63));
+    if (above != 0) {
+      return word * 64 + std::countr_zero(above);
+    }
+    const uint64_t words =
+        word + 1 >= 64 ? 0 : summary_[ASK] & (~0ULL << (word + 1));
+    if (words == 0) {
+      return NONE;
+    }
+    word = std::countr_zero(words);
+    return word * 64 + std::countr_zero(bits[word]);
+  }
+
+  // Move the window so an improving price fits: centred between it and the
+  // other side's touch when both fit, otherwise on the price itself
+  void recentre(uint8_t side, int64_t price) noexcept {
+    int64_t base = centred(price);
+    int64_t other;
+    if (best_price(side ^ 1, other)) {
+      const int64_t between = centred(price + (other - price) / 2);
+      const int64_t ticks = (price - between) / tick_;
+      if (ticks >= 0 && ticks < static_cast<int64_t>(ticks_)) {
+        base = between;
+      }
+    }
+
+    const int64_t shift = (base - base_) / tick_;
+    const int64_t size = static_cast<int64_t>(ticks_);
+    for (uint8_t s = BID; s <= ASK; ++s) {
+      uint64_t *quantity = &quantity_[s * ticks_];
+      uint32_t *orders = &orders_[s * ticks_];
+
+      // Levels leaving the window go to the overflow
+      for (int64_t i = 0; i < size; ++i) {
+        if (quantity[i] != 0 && (i - shift < 0 || i - shift >= size)) {
+          spill(s, BookLevel{price_at(static_cast<size_t>(i)), quantity[i],
+                             orders[i]});
+          quantity[i] = 0;
+          orders[i] = 0;
+        }
+      }
+
+      // Slide the rest to their new slots
+      if (shift > 0 && shift < size) {
+        std::copy(quantity + shift, quantity + size, quantity);
+        std::fill(quantity + size - shift, quantity + size, 0);
+        std::copy(orders + shift, orders + size, orders);
+        std::fill(orders + size - shift, orders + size, 0);
+      } else if (shift < 0 && -shift < size) {
+        std::copy_backward(quantity, quantity + size + shift,
+                           quantity + size);
+        std::fill(quantity, quantity - shift, 0);
+        std::copy_backward(orders, orders + size + shift, orders + size);
+        std::fill(orders, orders - shift, 0);
+      }
+    }
+    base_ = base;
+
+    // Overflow levels now inside the window move into it
+    for (uint8_t s = BID; s <= ASK; ++s) {
+      BookLevel *levels = spill_at(s);
+      size_t kept = 0;
+      for (size_t i = 0; i < spill_size_[s]; ++i) {
+        size_t index = 0;
+        if (slot(levels[i].price, index)) {
+          quantity_[s * ticks_ + index] = levels[i].quantity;
+          orders_[s * ticks_ + index] = levels[i].orders;
+        } else {
+          levels[kept++] = levels[i];
+        }
+      }
+      spill_size_[s] = kept;
+    }
+
+    // Rebuild the bitmaps from the quantities
+    std::fill(bits_.get(), bits_.get() + 2 * words_, 0);
+    summary_[BID] = 0;
+    summary_[ASK] = 0;
+    window_levels_ = 0;
+    for (uint8_t s = BID; s <= ASK; ++s) {
+      for (size_t i = 0; i < ticks_; ++i) {
+        if (quantity_[s * ticks_ + i] != 0) {
+          mark(s, i);
+          window_levels_++;
+        }
+      }
+    }
+    recentres_++;
+  }
+
+  int64_t tick_;
+  size_t ticks_;
+  size_t words_;
+  int64_t base_; // Price of window index 0
+  std::unique_ptr<uint64_t[]> quantity_; // [side * ticks_ + index]
+  std::unique_ptr<uint32_t[]> orders_;
+  std::unique_ptr<uint64_t[]> bits_; // [side * words_ + word]
+  uint64_t summary_[2];              // Bit w set if bits word w is nonzero
+  size_t spill_capacity_;            // Overflow levels per side
+  std::unique_ptr<BookLevel[]> spill_; // [side * spill_capacity_ + i], best
+                                       // first
+  size_t spill_size_[2];
+  size_t window_levels_;
+  uint64_t recentres_;
+  uint64_t dropped_;
+};
+
+// Aggregated depth for all instruments, built from normalized order
+// messages. max_ladders ladders are allocated up front and handed to
+// instruments on their first order; once they run out, new instruments are
+// rejected, so applying never allocates.
+// Single-threaded: apply and query from one thread.
+class PriceLadderBook {
+public:
+  static constexpr uint8_t BID = PriceLadder::BID;
+  static constexpr uint8_t ASK = PriceLadder::ASK;
+
+  explicit PriceLadderBook(
+      const PriceLadderConfig &config = PriceLadderConfig{})
+      : config_(config), ladders_(config.max_instruments, nullptr),
+        next_ladder_(0) {
+    pool_.reserve(config.max_ladders);
+    for (size_t i = 0; i < config.max_ladders; ++i) {
+      pool_.push_back(std::make_unique<PriceLadder>(
+          config.tick_size, config.window_ticks, config.overflow_levels));
+    }
+  }
+
+  // Apply an order message; other message types are ignored.
+  // Executions, cancels and deletes only say which level they hit when the
+  // parser tracks orders (FLAG_ENRICHED); without it they are counted as
+  // untracked and skipped. Tracked executions carry the resting price, so
+  // one printed at another price (ITCH 'C', FLAG_PRINT_PRICE) still comes
+  // off the order's level.
+  // Returns false if the message could not be applied
+  bool apply(const NormalizedMessage &msg) noexcept {
+    switch (msg.type) {
+    case NormalizedMessage::Type::ORDER_ADD:
+      return add(msg.instrument_id, msg.side, msg.price, msg.quantity);
+    case NormalizedMessage::Type::ORDER_EXECUTE:
+    case NormalizedMessage::Type::ORDER_MODIFY:
+    case NormalizedMessage::Type::ORDER_DELETE:
+      if (!(msg.flags & NormalizedMessage::FLAG_ENRICHED)) {
+        stats_.untracked++;
+        return false;
+      }
+      return reduce(msg.instrument_id, msg.side, msg.price, msg.quantity,
+                    msg.type == NormalizedMessage::Type::ORDER_DELETE ||
+                        msg.remaining_quantity == 0);
+    default:
+      return true;
+    }
+  }
+
+  // Add one order's shares at a price
+  // Returns false if it was rejected or cost a level (stats().dropped)
+  bool add(uint32_t instrument_id, uint8_t side, int64_t price,
+           uint64_t quantity) noexcept {
+    if (instrument_id >= ladders_.size() || side > ASK) {
+      stats_.rejected++;
+      return false;
+    }
+    PriceLadder *&ladder = ladders_[instrument_id];
+    if (ladder == nullptr) {
+      if (next_ladder_ == pool_.size()) {
+        stats_.rejected++;
+        return false;
+      }
+      ladder = pool_[next_ladder_++].get();
+    }
+    stats_.updates++;
+    if (!ladder->add(side, price, quantity)) {
+      stats_.dropped++;
+      return false;
+    }
+    return true;
+  }
+
+  // Take shares off a price; order_gone also drops one from the level's
+  // order count
+  bool reduce(uint32_t instrument_id, uint8_t side, int64_t price,
+              uint64_t quantity, bool order_gone) noexcept {
+    if (instrument_id >= ladders_.size() || side > ASK) {
+      stats_.rejected++;
+      return false;
+    }
+    PriceLadder *ladder = ladders_[instrument_id];
+    if (ladder == nullptr ||
+        !ladder->reduce(side, price, quantity, order_gone ? 1 : 0)) {
+      stats_.unmatched++;
+      return false;
+    }
+    stats_.updates++;
+    return true;
+  }
+
+  // nullptr until the instrument's first order
+  const PriceLadder *ladder(uint32_t instrument_id) const noexcept {
+    return instrument_id < ladders_.size() ? ladders_[instrument_id] : nullptr;
+  }
+
+  bool best(uint32_t instrument_id, uint8_t side,
+            BookLevel &out) const noexcept {
+    const PriceLadder *book = ladder(instrument_id);
+    return book != nullptr && side <= ASK && book->best(side, out);
+  }
+
+  size_t depth(uint32_t instrument_id, uint8_t side, BookLevel *out,
+               size_t max_levels) const noexcept {
+    const PriceLadder *book = ladder(instrument_id);
+    return book != nullptr && side <= ASK ? book->depth(side, out, max_levels)
+                                          : 0;
+  }
+
+  const PriceLadderStats &stats() const noexcept { return stats_; }
+  const PriceLadderConfig &config() const noexcept { return config_; }
+
+  // Ladders handed out so far
+  size_t ladders_used() const noexcept { return next_ladder_; }
+
+  // Empty every ladder; their storage and instruments are kept
+  void clear() noexcept {
+    for (size_t i = 0; i < next_ladder_; ++i) {
+      pool_[i]->clear();
+    }
+    stats_ = PriceLadderStats{};
+  }
+
+private:
+  PriceLadderConfig config_;
+  std::vector<std::unique_ptr<PriceLadder>> pool_;
+  std::vector<PriceLadder *> ladders_; // By instrument, nullptr until used
+  size_t next_ladder_;
+  PriceLadderStats stats_;
+};
+
+// Subscriber that maintains a PriceLadderBook from the messages it
+// receives. Query it from the delivery thread or once the engine has
+// stopped.
+class PriceLadderSubscriber : public ISubscriber {
+public:
+  explicit PriceLadderSubscriber(
+      const PriceLadderConfig &config = PriceLadderConfig{},
+      const char *name = "PriceLadderSubscriber")
+      : book_(config), name_(name) {}
+
+  bool on_message(const NormalizedMessage &msg) noexcept override {
+    book_.apply(msg);
+    return true;
+  }
+
+  const char *name() const noexcept override { return name_; }
+
+  PriceLadderBook &book() noexcept { return book_; }
+  const PriceLadderBook &book() const noexcept { return book_; }
+
+private:
+  PriceLadderBook book_;
+  const char *name_;
+};
+
+} // namespace core
+} // namespace hft
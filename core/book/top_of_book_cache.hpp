@@ -0,0 +1,183 @@
+#pragma once
+
+#include "../types.hpp"
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+namespace hft {
+namespace core {
+
+// Best bid/offer and last trade for one instrument
+struct TopOfBook {
+  int64_t bid_price{0}; // Fixed point (scale: 10000), 0 = no bid
+  uint64_t bid_quantity{0};
+  int64_t ask_price{0}; // 0 = no offer
+  uint64_t ask_quantity{0};
+  int64_t last_price{0}; // 0 = no trade yet
+  uint64_t last_quantity{0};
+  Timestamp timestamp{0}; // Exchange timestamp of the latest update
+};
+
+// Latest top of book per instrument, indexed by instrument id (ITCH stock
+// locate), in one flat array with one cache line per instrument.
+// A single writer (the parse thread) updates entries under a per-entry
+// sequence lock; any number of threads read without locking and retry if
+// they raced with a write.
+class TopOfBookCache {
+public:
+  static constexpr size_t MAX_INSTRUMENTS = 65536;
+
+  TopOfBookCache() : entries_(std::make_unique<Entry[]>(MAX_INSTRUMENTS)) {}
+
+  // Apply a normalized message (writer side)
+  // Quotes set the bid (side 0) or offer (side 1); trades and executions
+  // that carry a price set the last trade. An execution flagged
+  // FLAG_PRINT_PRICE carries the resting price and leaves the last trade to
+  // the print after it. Other messages are ignored
+  void update(const NormalizedMessage &msg) noexcept {
+    switch (msg.type) {
+    case NormalizedMessage::Type::QUOTE:
+      update_quote(msg.instrument_id, msg.side, msg.price, msg.quantity,
+                   msg.timestamp);
+      break;
+    case NormalizedMessage::Type::ORDER_EXECUTE:
+      if (msg.price != 0 &&
+          !(msg.flags & NormalizedMessage::FLAG_PRINT_PRICE)) {
+        update_trade(msg.instrument_id, msg.price, msg.quantity,
+                     msg.timestamp);
+      }
+      break;
+    case NormalizedMessage::Type::TRADE:
+      if (msg.price != 0) {
+        update_trade(msg.instrument_id, msg.price, msg.quantity,
+                     msg.timestamp);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  // Set one side of the book (writer side) - side 0 = bid, 1 = offer
+  void update_quote(uint64_t instrument_id, uint8_t side, int64_t price,
+                    uint64_t quantity, Timestamp timestamp) noexcept {
+    if (instrument_id >= MAX_INSTRUMENTS) {
+      return;
+    }
+    Entry &entry = entries_[instrument_id];
+    begin_write(entry);
+    if (side == 0) {
+      entry.data.bid_price = price;
+      entry.data.bid_quantity = quantity;
+    } else {
+      entry.data.ask_price = price;
+      entry.data.ask_quantity = quantity;
+    }
+    entry.data.timestamp = timestamp;
+    end_write(entry);
+  }
+
+  // Set both sides at once (writer side), e.g. from an order book's best
+  // levels; price 0 = that side is empty. Skips the write if nothing changed
+  void update_book(uint64_t instrument_id, int64_t bid_price,
+                   uint64_t bid_quantity, int64_t ask_price,
+                   uint64_t ask_quantity, Timestamp timestamp) noexcept {
+    if (instrument_id >= MAX_INSTRUMENTS) {
+      return;
+    }
+    Entry &entry = entries_[instrument_id];
+    TopOfBook &data = entry.data;
+    if (entry.sequence.load(std::memory_order_relaxed) != 0 &&
+        data.bid_price == bid_price && data.bid_quantity == bid_quantity &&
+        data.ask_price == ask_price && data.ask_quantity == ask_quantity) {
+      return;
+    }
+    begin_write(entry);
+    data.bid_price = bid_price;
+    data.bid_quantity = bid_quantity;
+    data.ask_price = ask_price;
+    data.ask_quantity = ask_quantity;
+    data.timestamp = timestamp;
+    end_write(entry);
+  }
+
+  // Set the last trade (writer side)
+  void update_trade(uint64_t instrument_id, int64_t price, uint64_t quantity,
+                    Timestamp timestamp) noexcept {
+    if (instrument_id >= MAX_INSTRUMENTS) {
+      return;
+    }
+    Entry &entry = entries_[instrument_id];
+    begin_write(entry);
+    entry.data.last_price = price;
+    entry.data.last_quantity = quantity;
+    entry.data.timestamp = timestamp;
+    end_write(entry);
+  }
+
+  // Read a consistent snapshot (any thread)
+  // Returns false if the instrument has never been updated
+  bool read(uint64_t instrument_id, TopOfBook &out) const noexcept {
+    if (instrument_id >= MAX_INSTRUMENTS) {
+      return false;
+    }
+    const Entry &entry = entries_[instrument_id];
+
+    for (;;) {
+      const uint64_t before = entry.sequence.load(std::memory_order_acquire);
+      if (before == 0) {
+        return false;
+      }
+      if (before & 1) {
+        continue; // Write in progress
+      }
+
+      std::memcpy(static_cast<void *>(&out), &entry.data, sizeof(TopOfBook));
+
+      // Validate the copy: did a write start meanwhile?
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (entry.sequence.load(std::memory_order_relaxed) == before) {
+        return true;
+      }
+    }
+  }
+
+  // Clear every entry (writer side, e.g. on session reset)
+  void clear() noexcept {
+    for (size_t i = 0; i < MAX_INSTRUMENTS; ++i) {
+      Entry &entry = entries_[i];
+      if (entry.sequence.load(std::memory_order_relaxed) != 0) {
+        begin_write(entry);
+        entry.data = TopOfBook{};
+        end_write(entry);
+      }
+    }
+  }
+
+private:
+  // Sequence is odd while a write is in progress
+  struct alignas(config::CACHELINE_SIZE) Entry {
+    std::atomic<uint64_t> sequence{0};
+    TopOfBook data;
+  };
+
+  static_assert(sizeof(Entry) == config::CACHELINE_SIZE,
+                "Top of book entry must fit in one cache line");
+
+  static void begin_write(Entry &entry) noexcept {
+    entry.sequence.store(entry.sequence.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  static void end_write(Entry &entry) noexcept {
+    entry.sequence.store(entry.sequence.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_release);
+  }
+
+  std::unique_ptr<Entry[]> entries_;
+};
+
+} // namespace core
+} // namespace hft
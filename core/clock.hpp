@@ -0,0 +1,207 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define HFT_HAS_TSC 1
+#endif
+
+namespace hft {
+namespace core {
+
+// Invariant-TSC clock reporting nanoseconds in the steady_clock
+// (CLOCK_MONOTONIC) domain, so its readings mix freely with get_timestamp().
+// Reading it is a rdtscp plus a multiply instead of a clock_gettime call.
+// The tick rate is calibrated against steady_clock on first use, and
+// recalibrate() - called periodically off the hot path - corrects drift by
+// adjusting the rate without ever stepping the clock backwards. Without an
+// invariant TSC (or off x86) ticks are steady_clock nanoseconds.
+class TscClock {
+public:
+  // Raw timestamp counter - convert later with to_nanos()
+  static uint64_t ticks() noexcept {
+#ifdef HFT_HAS_TSC
+    if (state().invariant) {
+      unsigned int aux;
+      return __rdtscp(&aux);
+    }
+#endif
+    return steady_nanos();
+  }
+
+  // Convert a ticks() reading to nanoseconds
+  static uint64_t to_nanos(uint64_t ticks) noexcept {
+    const State &s = state();
+    for (;;) {
+      const uint64_t before = s.sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue; // Recalibration in progress
+      }
+      const uint64_t base_ticks = s.base_ticks.load(std::memory_order_relaxed);
+      const uint64_t base_nanos = s.base_nanos.load(std::memory_order_relaxed);
+      const uint64_t mult = s.mult.load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (s.sequence.load(std::memory_order_relaxed) == before) {
+        // Readings taken before the latest recalibration point count back
+        return ticks >= base_ticks
+                   ? base_nanos + scale(ticks - base_ticks, mult)
+                   : base_nanos - scale(base_ticks - ticks, mult);
+      }
+    }
+  }
+
+  // Current time in nanoseconds
+  static uint64_t now() noexcept { return to_nanos(ticks()); }
+
+  // True if readings come from the TSC rather than steady_clock
+  static bool uses_tsc() noexcept { return state().invariant; }
+
+  // Measured TSC frequency (1.0 when falling back to steady_clock)
+  static double ticks_per_ns() noexcept {
+    return static_cast<double>(uint64_t{1} << SHIFT) /
+           static_cast<double>(state().mult.load(std::memory_order_relaxed));
+  }
+
+  // Re-measure the tick rate against steady_clock and correct drift
+  // Cheap enough to call every few hundred milliseconds from a
+  // housekeeping thread; never call it from the hot path
+  static void recalibrate() noexcept {
+    State &s = state();
+    if (!s.invariant) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(s.calibration_mutex);
+
+    uint64_t tsc = 0;
+    const uint64_t actual = sample(tsc);
+    const uint64_t predicted = to_nanos(tsc);
+    const uint64_t elapsed_ticks = tsc - s.calibrated_ticks;
+    const uint64_t elapsed_nanos = actual - s.calibrated_nanos;
+    if (elapsed_ticks == 0 || elapsed_nanos == 0) {
+      return;
+    }
+
+    // Rate that would have been exact over the last interval, nudged to
+    // absorb the current error over the next one of similar length
+    const int64_t error = static_cast<int64_t>(actual - predicted);
+    long double target = static_cast<long double>(elapsed_nanos) +
+                         static_cast<long double>(error);
+    if (target < static_cast<long double>(elapsed_nanos) / 2) {
+      target = static_cast<long double>(elapsed_nanos) / 2;
+    }
+
+    publish(s, tsc, predicted, rate(target, elapsed_ticks));
+    s.calibrated_ticks = tsc;
+    s.calibrated_nanos = actual;
+  }
+
+private:
+  static constexpr unsigned SHIFT = 32; // Fixed-point bits of mult
+
+  struct State {
+    // Conversion: nanos = base_nanos + (ticks - base_ticks) * mult >> SHIFT
+    std::atomic<uint64_t> sequence{0}; // Odd while being updated
+    std::atomic<uint64_t> base_ticks{0};
+    std::atomic<uint64_t> base_nanos{0};
+    std::atomic<uint64_t> mult{uint64_t{1} << SHIFT};
+
+    bool invariant{false};
+    std::mutex calibration_mutex;
+    uint64_t calibrated_ticks{0}; // Last calibration point
+    uint64_t calibrated_nanos{0};
+
+    State() {
+#ifdef HFT_HAS_TSC
+      unsigned int eax, ebx, ecx, edx;
+      invariant = __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) &&
+                  (edx & (1u << 8)) != 0;
+#endif
+      if (invariant) {
+        calibrate();
+      }
+    }
+
+    // Initial rate measured across a short sleep
+    void calibrate() {
+      uint64_t start_tsc = 0;
+      const uint64_t start = sample(start_tsc);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      uint64_t end_tsc = 0;
+      const uint64_t end = sample(end_tsc);
+
+      publish(*this, end_tsc, end, rate(end - start, end_tsc - start_tsc));
+      calibrated_ticks = end_tsc;
+      calibrated_nanos = end;
+    }
+  };
+
+  static State &state() noexcept {
+    static State instance;
+    return instance;
+  }
+
+  static uint64_t steady_nanos() noexcept {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  // Paired TSC and steady_clock reading, taken from the tightest of a few
+  // attempts so the pair is not split by a preemption
+  static uint64_t sample(uint64_t &tsc) noexcept {
+#ifdef HFT_HAS_TSC
+    uint64_t best_window = UINT64_MAX;
+    uint64_t nanos = 0;
+    for (int attempt = 0; attempt < 5; ++attempt) {
+      unsigned int aux;
+      const uint64_t before = __rdtscp(&aux);
+      const uint64_t steady = steady_nanos();
+      const uint64_t after = __rdtscp(&aux);
+      if (after - before < best_window) {
+        best_window = after - before;
+        tsc = before + (after - before) / 2;
+        nanos = steady;
+      }
+    }
+    return nanos;
+#else
+    tsc = steady_nanos();
+    return tsc;
+#endif
+  }
+
+  static uint64_t rate(long double nanos, uint64_t ticks) noexcept {
+    return static_cast<uint64_t>(nanos * (uint64_t{1} << SHIFT) /
+                                 static_cast<long double>(ticks));
+  }
+
+  // delta * mult >> SHIFT without overflowing for deltas beyond 2^32 ticks
+  // (mult stays below 2^32 for any TSC of 1 GHz or more)
+  static uint64_t scale(uint64_t delta, uint64_t mult) noexcept {
+    return (delta >> SHIFT) * mult +
+           (((delta & ((uint64_t{1} << SHIFT) - 1)) * mult) >> SHIFT);
+  }
+
+  static void publish(State &s, uint64_t base_ticks, uint64_t base_nanos,
+                      uint64_t mult) noexcept {
+    s.sequence.store(s.sequence.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.base_ticks.store(base_ticks, std::memory_order_relaxed);
+    s.base_nanos.store(base_nanos, std::memory_order_relaxed);
+    s.mult.store(mult, std::memory_order_relaxed);
+    s.sequence.store(s.sequence.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_release);
+  }
+};
+
+} // namespace core
+} // namespace hft
@@ -1,14 +1,27 @@
 #pragma once
 
+#include "book/order_book.hpp"
+#include "book/top_of_book_cache.hpp"
 #include "distribution/dispatcher.hpp"
 #include "distribution/subscriber.hpp"
+#include "metrics/histogram.hpp"
+#include "metrics/metrics_exporter.hpp"
+#include "metrics/prometheus.hpp"
+#include "metrics/stats_block.hpp"
+#include "metrics/stats_page.hpp"
 #include "network/udp_receiver.hpp"
 #include "parser/parser_interface.hpp"
+#include "trace/tracer.hpp"
 #include "types.hpp"
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 
 namespace hft {
@@ -17,10 +30,27 @@ namespace core {
 // Core engine configuration
 struct CoreConfig {
   UDPConfig network;
+  DispatcherConfig dispatcher;
   int network_thread_cpu{config::NETWORK_THREAD_CPU};
-  int dispatcher_thread_cpu{config::DISPATCHER_THREAD_CPU};
+  int dispatcher_thread_cpu{config::DISPATCHER_THREAD_CPU}; // Shared thread
   int parser_thread_cpu{-1};          // -1 = no affinity
   size_t max_messages_per_packet{16}; // Max normalized messages per packet
+  uint32_t housekeeping_interval_ms{100}; // Clock drift correction and
+                                          // unsubscribe cleanup
+  uint32_t trace_sample_interval{0}; // HFT_TRACE builds: trace one message
+                                     // in N (0 = leave Tracer as it is)
+  std::string stats_page; // Shared-memory stats page published every
+                          // housekeeping interval, e.g. "/hft-stats"
+                          // (empty = off)
+  int metrics_port{-1};   // Prometheus GET /metrics on metrics_address
+                          // (-1 = off, 0 = any free port)
+  std::string metrics_address{"127.0.0.1"};
+  int metrics_thread_cpu{-1}; // Keep off the isolated hot-path cores
+  bool book_top_of_book{false}; // Build order books on the parse thread
+                                // and publish their best bid/offer to the
+                                // top of book cache; needs a parser that
+                                // tracks orders (set before set_parser())
+  OrderBookConfig book;         // Pool sizes for those books
 
   CoreConfig() = default;
 };
@@ -29,28 +59,54 @@ struct CoreConfig {
 class CoreEngine {
 public:
   explicit CoreEngine(const CoreConfig &config = CoreConfig{})
-      : config_(config), receiver_(config.network), dispatcher_(),
-        parser_(nullptr), running_(false), stats_() {
+      : config_(config), receiver_(config.network),
+        dispatcher_(config.dispatcher), parser_(nullptr),
+        messages_(config.max_messages_per_packet), running_(false),
+        stats_() {
     // Default to echo parser if none provided
     set_parser(std::make_unique<EchoParser>());
+
+#ifdef HFT_TSC_CLOCK
+    // Calibrate now rather than on the first hot-path timestamp
+    (void)TscClock::now();
+#endif
+#ifdef HFT_TRACE
+    if (config.trace_sample_interval != 0) {
+      Tracer::instance().set_sample_interval(config.trace_sample_interval);
+    }
+#endif
   }
 
   ~CoreEngine() { stop(); }
 
   // Set the protocol parser
+  // With book_top_of_book the books are only built for a parser that
+  // already tracks orders; start() refuses to run without them
   void set_parser(std::unique_ptr<IParser> parser) {
     if (running_.load()) {
       throw std::runtime_error("Cannot change parser while running");
     }
     parser_ = std::move(parser);
+    if (!config_.book_top_of_book || !parser_ || !parser_->order_tracking()) {
+      book_.reset();
+    } else if (!book_) {
+      book_ = std::make_unique<OrderBook>(config_.book);
+    } else {
+      book_->clear();
+    }
   }
 
-  // Add a subscriber
-  void add_subscriber(std::unique_ptr<ISubscriber> subscriber) {
-    if (running_.load()) {
-      throw std::runtime_error("Cannot add subscriber while running");
-    }
-    dispatcher_.add_subscriber(std::move(subscriber));
+  // Add a subscriber - safe while running
+  SubscriberId
+  add_subscriber(std::unique_ptr<ISubscriber> subscriber,
+                 const SubscriberOptions &options = SubscriberOptions{}) {
+    return dispatcher_.add_subscriber(std::move(subscriber), options);
+  }
+
+  // Remove a subscriber - safe while running
+  // Its shutdown() runs once the parse and consumer threads have let go of it
+  bool remove_subscriber(SubscriberId id) {
+    return dispatcher_.remove_subscriber(id);
   }
 
   // Initialize all components
@@ -76,15 +132,36 @@ public:
     if (!parser_) {
       throw std::runtime_error("No parser configured");
     }
+    if (config_.book_top_of_book && !book_) {
+      throw std::runtime_error(
+          "book_top_of_book needs a parser that tracks orders");
+    }
+    if (!config_.stats_page.empty() && !stats_page_writer_.is_open() &&
+        !stats_page_writer_.create(config_.stats_page)) {
+      throw std::runtime_error("Cannot create stats page " +
+                               config_.stats_page);
+    }
+    if (config_.metrics_port >= 0 && !metrics_exporter_) {
+      auto exporter =
+          std::make_unique<MetricsExporter>([this] { return metrics_text(); });
+      if (!exporter->start(static_cast<uint16_t>(config_.metrics_port),
+                           config_.metrics_address,
+                           config_.metrics_thread_cpu)) {
+        throw std::runtime_error("Cannot listen for metrics on port " +
+                                 std::to_string(config_.metrics_port));
+      }
+      metrics_exporter_ = std::move(exporter);
+    }
 
     running_.store(true);
 
     // Start components in order
     receiver_.start(config_.network_thread_cpu);
-    dispatcher_.start();
+    dispatcher_.start(config_.dispatcher_thread_cpu);
 
     // Start parsing thread
     parse_thread_ = std::thread(&CoreEngine::parse_loop, this);
+    housekeeping_thread_ = std::thread(&CoreEngine::housekeeping_loop, this);
 
     if (config_.parser_thread_cpu >= 0) {
       cpu_set_t cpuset;
@@ -100,34 +177,60 @@ public:
     if (!running_.load())
       return;
 
-    running_.store(false);
+    if (metrics_exporter_) {
+      metrics_exporter_->stop();
+      metrics_exporter_.reset();
+    }
 
-    // Stop parsing thread
+    {
+      std::lock_guard<std::mutex> lock(housekeeping_mutex_);
+      running_.store(false);
+    }
+    housekeeping_cv_.notify_all();
+
+    // Stop parsing and housekeeping threads
     if (parse_thread_.joinable()) {
       parse_thread_.join();
     }
+    if (housekeeping_thread_.joinable()) {
+      housekeeping_thread_.join();
+    }
 
     // Stop components
     dispatcher_.stop();
     receiver_.stop();
 
+    // Leave the final counters on the page until the engine goes away
+    if (stats_page_writer_.is_open()) {
+      stats_page_writer_.publish(stats_page());
+    }
+
     // Reset parser
     if (parser_) {
       parser_->reset();
     }
+    if (book_) {
+      book_->clear();
+    }
   }
 
-  // Get combined statistics
+  // Get combined statistics (any thread)
+  // Stages are read downstream first, so a snapshot never shows more
+  // messages dispatched than parsed or parsed than received
   Statistics get_stats() const {
-    Statistics combined = stats_;
+    const Statistics disp_stats = dispatcher_.get_stats();
+    Statistics combined = stats_.snapshot();
 
     // Add receiver stats
-    const auto &recv_stats = receiver_.get_stats();
+    const Statistics recv_stats = receiver_.get_stats();
     combined.packets_received = recv_stats.packets_received;
     combined.packets_dropped = recv_stats.packets_dropped;
+    combined.kernel_latency_samples = recv_stats.kernel_latency_samples;
+    combined.min_kernel_latency_ns = recv_stats.min_kernel_latency_ns;
+    combined.max_kernel_latency_ns = recv_stats.max_kernel_latency_ns;
+    combined.total_kernel_latency_ns = recv_stats.total_kernel_latency_ns;
 
     // Add dispatcher stats
-    const auto &disp_stats = dispatcher_.get_stats();
     combined.messages_dispatched = disp_stats.messages_dispatched;
 
     return combined;
@@ -137,52 +240,321 @@ public:
   bool is_running() const noexcept { return running_.load(); }
 
   // Get number of subscribers
-  size_t subscriber_count() const noexcept {
+  size_t subscriber_count() const {
     return dispatcher_.subscriber_count();
   }
 
+  // Parse and dispatch one packet on the calling thread
+  // For replaying captured data without the network receiver - do not mix
+  // with a running engine. Returns the number of messages parsed
+  size_t process_packet(const MessageView &packet) noexcept {
+    const Timestamp parse_start = get_timestamp();
+    const size_t count = parse_packet(packet);
+    const Timestamp parse_end = get_timestamp();
+    dispatch_parsed(count, packet.timestamp, parse_start, parse_end);
+    return count;
+  }
+
+  // Merge a stage's latency histogram into out (any thread)
+  // QUEUE_TO_SUBSCRIBER combines every queued subscriber
+  void latency_histogram(LatencyStage stage, LatencyHistogram &out) const {
+    if (stage == LatencyStage::QUEUE_TO_SUBSCRIBER) {
+      dispatcher_.delivery_histogram(out);
+    } else {
+      out.merge(stage_latency_[static_cast<size_t>(stage)]);
+    }
+  }
+
+  // Get the current top of book for an instrument (any thread, lock-free)
+  // The bid and offer come from the engine's order books (book_top_of_book),
+  // or from QUOTE messages for feeds that send them. Returns false if
+  // nothing has been seen for the instrument yet
+  bool get_top_of_book(uint64_t instrument_id, TopOfBook &out) const noexcept {
+    return top_of_book_.read(instrument_id, out);
+  }
+
+  const TopOfBookCache &top_of_book() const noexcept { return top_of_book_; }
+
+  // Port the metrics exporter listens on (0 if not serving)
+  uint16_t metrics_port() const noexcept {
+    return metrics_exporter_ ? metrics_exporter_->port() : 0;
+  }
+
+  // Current counters and latency histograms in Prometheus text format
+  // Reads snapshots only - safe from any thread while running
+  std::string metrics_text() const {
+    PrometheusText text;
+    const Statistics stats = get_stats();
+    text.family("hft_packets_received_total", "counter",
+                "Packets received from the network");
+    text.sample("hft_packets_received_total", stats.packets_received);
+    text.family("hft_packets_dropped_total", "counter",
+                "Packets dropped before parsing");
+    text.sample("hft_packets_dropped_total", stats.packets_dropped);
+    text.family("hft_messages_parsed_total", "counter",
+                "Normalized messages produced by the parser");
+    text.sample("hft_messages_parsed_total", stats.messages_parsed);
+    text.family("hft_messages_dispatched_total", "counter",
+                "Messages handed to the dispatcher");
+    text.sample("hft_messages_dispatched_total", stats.messages_dispatched);
+    text.family("hft_parse_errors_total", "counter",
+                "Packets that produced no messages");
+    text.sample("hft_parse_errors_total", stats.parse_errors);
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+    text.family("hft_stage_latency_seconds", "histogram",
+                "Latency of each pipeline stage");
+    for (size_t i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+      const auto stage = static_cast<LatencyStage>(i);
+      histogram->reset();
+      latency_histogram(stage, *histogram);
+      text.latency_histogram("hft_stage_latency_seconds",
+                             {{"stage", latency_stage_name(stage)}},
+                             *histogram);
+    }
+
+    const std::vector<SubscriberInfo> subscribers = dispatcher_.subscribers();
+    std::vector<SubscriberStats> rows;
+    for (const SubscriberInfo &info : subscribers) {
+      rows.push_back(dispatcher_.subscriber_stats(info.id));
+    }
+    const auto labels = [&](size_t i) -> PrometheusText::Labels {
+      return {{"id", std::to_string(subscribers[i].id)},
+              {"subscriber", subscribers[i].name}};
+    };
+
+    text.family("hft_subscriber_delivered_total", "counter",
+                "Messages delivered to a subscriber");
+    for (size_t i = 0; i < rows.size(); ++i) {
+      text.sample("hft_subscriber_delivered_total", labels(i),
+                  rows[i].messages_delivered);
+    }
+    text.family("hft_subscriber_dropped_total", "counter",
+                "Messages a subscriber lost to a full queue or ring");
+    for (size_t i = 0; i < rows.size(); ++i) {
+      text.sample("hft_subscriber_dropped_total", labels(i),
+                  rows[i].messages_dropped);
+    }
+    text.family("hft_subscriber_conflated_total", "counter",
+                "Updates replaced by a newer one while a subscriber lagged");
+    for (size_t i = 0; i < rows.size(); ++i) {
+      text.sample("hft_subscriber_conflated_total", labels(i),
+                  rows[i].messages_conflated);
+    }
+    text.family("hft_subscriber_queue_depth", "gauge",
+                "Messages waiting for a subscriber");
+    for (size_t i = 0; i < rows.size(); ++i) {
+      text.sample("hft_subscriber_queue_depth", labels(i), rows[i].lag);
+    }
+
+    text.family("hft_subscriber_delivery_latency_seconds", "histogram",
+                "Receive to hand-off latency per queued subscriber");
+    for (size_t i = 0; i < subscribers.size(); ++i) {
+      histogram->reset();
+      if (!subscribers[i].inline_dispatch &&
+          dispatcher_.delivery_histogram(subscribers[i].id, *histogram)) {
+        text.latency_histogram("hft_subscriber_delivery_latency_seconds",
+                               labels(i), *histogram);
+      }
+    }
+    return text.str();
+  }
+
+  // Snapshot of everything the shared-memory stats page shows (any thread)
+  StatsPage stats_page() const {
+    StatsPage page;
+    page.updated = get_timestamp();
+    page.engine = get_stats();
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+    for (size_t i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+      histogram->reset();
+      latency_histogram(static_cast<LatencyStage>(i), *histogram);
+      page.stages[i] = LatencySummary::of(*histogram);
+    }
+
+    for (const SubscriberInfo &info : dispatcher_.subscribers()) {
+      const SubscriberStats stats = dispatcher_.subscriber_stats(info.id);
+      StatsPageSubscriber row;
+      row.id = info.id;
+      std::strncpy(row.name, info.name.c_str(), sizeof(row.name) - 1);
+      row.delivered = stats.messages_delivered;
+      row.dropped = stats.messages_dropped;
+      row.conflated = stats.messages_conflated;
+      row.queue_depth = stats.lag;
+      row.inline_dispatch = info.inline_dispatch;
+      histogram->reset();
+      if (dispatcher_.delivery_histogram(info.id, *histogram)) {
+        row.latency = LatencySummary::of(*histogram);
+      }
+      page.subscribers.push_back(row);
+    }
+    return page;
+  }
+
+  // Get delivery counters and lag for a subscriber
+  SubscriberStats subscriber_stats(SubscriberId id) const {
+    return dispatcher_.subscriber_stats(id);
+  }
+
 private:
+  // Parse packet into normalized messages
+  size_t parse_packet(const MessageView &packet) noexcept {
+    return parser_->parse(packet, messages_.data(), messages_.size());
+  }
+
+  // Dispatch all parsed messages and update stats
+  void dispatch_parsed(size_t count, Timestamp received, Timestamp parse_start,
+                       Timestamp parse_end) noexcept {
+#ifdef HFT_TRACE
+    trace_parsed(count, received, parse_start, parse_end);
+#endif
+    for (size_t i = 0; i < count; ++i) {
+      top_of_book_.update(messages_[i]);
+      if (book_) {
+        update_book(messages_[i]);
+      }
+      dispatcher_.dispatch(messages_[i]);
+    }
+    // Conflated updates follow as soon as a subscriber catches up, even
+    // while the feed never lets this thread go idle
+    dispatcher_.flush_conflated();
+
+    const Timestamp dispatch_end = get_timestamp();
+    if (received != 0 && received <= parse_start) {
+      stage_latency(LatencyStage::RECEIVE_TO_PARSE)
+          .record(parse_start - received);
+    }
+    stage_latency(LatencyStage::PARSE).record(parse_end - parse_start);
+    stage_latency(LatencyStage::PARSE_TO_DISPATCH)
+        .record(dispatch_end - parse_end);
+
+    stats_.begin();
+    stats_.add_messages_parsed(count);
+    if (count == 0) {
+      stats_.add_parse_errors(1);
+    }
+    stats_.record_latency(dispatch_end - parse_start);
+    stats_.commit();
+  }
+
+#ifdef HFT_TRACE
+  // Pick the messages to trace; sampled ones get their receive and parse
+  // points recorded here and carry the trace id downstream
+  void trace_parsed(size_t count, Timestamp received, Timestamp parse_start,
+                    Timestamp parse_end) noexcept {
+    Tracer &tracer = Tracer::instance();
+    const uint16_t detail = static_cast<uint16_t>(count);
+    for (size_t i = 0; i < count; ++i) {
+      const uint32_t trace_id = tracer.sample();
+      messages_[i].trace_id = trace_id;
+      if (trace_id == 0) {
+        continue;
+      }
+      if (received != 0) {
+        tracer.record(TracePoint::RECEIVE, trace_id, detail, received);
+      }
+      tracer.record(TracePoint::PARSE_BEGIN, trace_id, detail, parse_start);
+      tracer.record(TracePoint::PARSE_END, trace_id, detail, parse_end);
+    }
+  }
+#endif
+
+  // Apply an order message to the books and publish the instrument's best
+  // bid and offer (the parser tracks orders, so replaces arrive as a delete
+  // and an add)
+  void update_book(const NormalizedMessage &msg) noexcept {
+    switch (msg.type) {
+    case NormalizedMessage::Type::ORDER_ADD:
+    case NormalizedMessage::Type::ORDER_EXECUTE:
+    case NormalizedMessage::Type::ORDER_MODIFY:
+    case NormalizedMessage::Type::ORDER_DELETE:
+      break;
+    default:
+      return;
+    }
+    if (!book_->apply(msg)) {
+      return;
+    }
+    BookLevel bid;
+    BookLevel ask;
+    book_->best(msg.instrument_id, OrderBook::BID, bid);
+    book_->best(msg.instrument_id, OrderBook::ASK, ask);
+    top_of_book_.update_book(msg.instrument_id, bid.price, bid.quantity,
+                             ask.price, ask.quantity, msg.timestamp);
+  }
+
+  LatencyHistogram &stage_latency(LatencyStage stage) noexcept {
+    return stage_latency_[static_cast<size_t>(stage)];
+  }
+
   void parse_loop() {
     MessageView raw_packet;
-    std::vector<NormalizedMessage> messages(config_.max_messages_per_packet);
+#ifdef HFT_TRACE
+    Tracer::instance().set_thread_name("parse");
+#endif
 
     while (running_.load(std::memory_order_relaxed)) {
-      // Read packet from network ring buffer
-      if (receiver_.read_packet(raw_packet)) {
+      // Parse straight out of the network ring buffer - no copy
+      if (receiver_.peek_packet(raw_packet)) {
         const Timestamp parse_start = get_timestamp();
+        const size_t count = parse_packet(raw_packet);
+        const Timestamp parse_end = get_timestamp();
 
-        // Parse packet into normalized messages
-        size_t count =
-            parser_->parse(raw_packet, messages.data(), messages.size());
-
-        // Dispatch all parsed messages
-        for (size_t i = 0; i < count; ++i) {
-          dispatcher_.dispatch(messages[i]);
-        }
+        // Messages no longer reference the packet; free its ring space
+        receiver_.release_packet();
 
-        // Update stats
-        stats_.messages_parsed += count;
-        if (count == 0) {
-          stats_.parse_errors++;
-        }
-
-        const Timestamp parse_end = get_timestamp();
-        stats_.update_latency(parse_end - parse_start);
+        dispatch_parsed(count, raw_packet.timestamp, parse_start, parse_end);
 
       } else {
-        // No packets available, yield
+        // No packets available - hand conflated updates to subscribers that
+        // caught up and let pending subscriber removals complete
+        dispatcher_.flush_conflated();
+        dispatcher_.quiescent();
         std::this_thread::yield();
       }
     }
   }
 
+  // Periodic work kept off the hot threads
+  void housekeeping_loop() {
+    const auto interval =
+        std::chrono::milliseconds(config_.housekeeping_interval_ms);
+    std::unique_lock<std::mutex> lock(housekeeping_mutex_);
+
+    while (!housekeeping_cv_.wait_for(lock, interval,
+                                      [this] { return !running_.load(); })) {
+#ifdef HFT_TSC_CLOCK
+      TscClock::recalibrate();
+#endif
+      // Unlink subscribers that returned false and free removed ones
+      dispatcher_.reclaim();
+
+      if (stats_page_writer_.is_open()) {
+        stats_page_writer_.publish(stats_page());
+      }
+    }
+  }
+
   CoreConfig config_;
   UDPReceiver receiver_;
   Dispatcher dispatcher_;
   std::unique_ptr<IParser> parser_;
+  std::vector<NormalizedMessage> messages_; // Parse output for one packet
+  std::unique_ptr<OrderBook> book_;         // Parse thread; feeds the cache
+  TopOfBookCache top_of_book_;              // Written by the parse thread
+  StatsPageWriter stats_page_writer_;       // Published by housekeeping
+  std::unique_ptr<MetricsExporter> metrics_exporter_; // While running
   std::thread parse_thread_;
+  std::thread housekeeping_thread_;
+  std::mutex housekeeping_mutex_; // Wakes housekeeping early on stop()
+  std::condition_variable housekeeping_cv_;
   std::atomic<bool> running_;
-  Statistics stats_;
+  StatsBlock stats_; // Written by the parse thread
+
+  // Receive->parse, parse and parse->dispatch, written by the parse thread;
+  // QUEUE_TO_SUBSCRIBER, the last stage, lives in the dispatcher
+  LatencyHistogram stage_latency_[LATENCY_STAGE_COUNT - 1];
 };
 
 } // namespace core
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "../types.hpp"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace hft {
+namespace core {
+
+// Single writer, multi reader broadcast ring
+// The writer stores each element once; every reader follows it with its own
+// cursor. The writer never waits for readers: a reader that falls more than
+// Size elements behind is lapped, detects it, counts the lost elements and
+// resumes at the newest data. Fast readers are never slowed by slow ones.
+//
+// Overrun detection uses a tail intent counter: the writer announces the
+// sequence it is about to write before touching the slot, so a reader that
+// copied a slot can tell afterwards whether the writer may have been
+// overwriting it during the copy (seqlock-style validation).
+template <typename T, size_t Size = config::DEFAULT_QUEUE_SIZE>
+class BroadcastRing {
+  static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Broadcast elements are copied while possibly being written");
+
+public:
+  BroadcastRing() : intent_(0), cursor_(0) {
+    buffer_ = std::make_unique<T[]>(Size);
+  }
+
+  // Claim the next slot for in-place writes (writer side)
+  // Never fails - the slot may still be being read by a lagging reader
+  T *claim() noexcept {
+    const uint64_t seq = cursor_.load(std::memory_order_relaxed);
+    intent_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return &buffer_[seq & (Size - 1)];
+  }
+
+  // Publish the slot returned by claim() to all readers
+  void commit() noexcept {
+    cursor_.store(cursor_.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_release);
+  }
+
+  // Write an element (writer side)
+  void publish(const T &item) noexcept {
+    std::memcpy(static_cast<void *>(claim()), &item, sizeof(T));
+    commit();
+  }
+
+  // Number of elements published so far
+  uint64_t cursor() const noexcept {
+    return cursor_.load(std::memory_order_acquire);
+  }
+
+  // Get capacity
+  constexpr size_t capacity() const noexcept { return Size; }
+
+  // Per-reader cursor - each Reader must be used by a single thread
+  class Reader {
+  public:
+    // Start reading at the ring's current position (newest data only)
+    explicit Reader(const BroadcastRing &ring) noexcept
+        : ring_(&ring), position_(ring.cursor()), cached_cursor_(0),
+          lost_(0) {
+      cached_cursor_ = position_.load(std::memory_order_relaxed);
+    }
+
+    // Read the next element
+    // Returns false if the reader is caught up with the writer
+    bool read(T &item) noexcept {
+      uint64_t position = position_.load(std::memory_order_relaxed);
+
+      for (;;) {
+        if (position == cached_cursor_) {
+          cached_cursor_ = ring_->cursor_.load(std::memory_order_acquire);
+          if (position == cached_cursor_) {
+            return false;
+          }
+        }
+
+        std::memcpy(static_cast<void *>(&item),
+                    &ring_->buffer_[position & (Size - 1)], sizeof(T));
+
+        // Validate the copy: was the writer about to reuse this slot?
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t intent = ring_->intent_.load(std::memory_order_relaxed);
+
+        if (intent - position <= Size) {
+          position_.store(position + 1, std::memory_order_relaxed);
+          return true;
+        }
+
+        // Lapped - skip to the newest published element
+        const uint64_t resume = ring_->cursor_.load(std::memory_order_acquire);
+        lost_.store(lost_.load(std::memory_order_relaxed) + (resume - position),
+                    std::memory_order_relaxed);
+        position = resume;
+        cached_cursor_ = resume;
+        position_.store(position, std::memory_order_relaxed);
+      }
+    }
+
+    // Elements published but not yet read (readable from any thread)
+    uint64_t lag() const noexcept {
+      const uint64_t cursor = ring_->cursor();
+      const uint64_t position = position_.load(std::memory_order_relaxed);
+      return cursor > position ? cursor - position : 0;
+    }
+
+    // Elements skipped because the writer lapped this reader
+    uint64_t lost() const noexcept {
+      return lost_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    const BroadcastRing *ring_;
+    alignas(config::CACHELINE_SIZE) std::atomic<uint64_t> position_;
+    uint64_t cached_cursor_;
+    std::atomic<uint64_t> lost_;
+  };
+
+private:
+  // Writer line: announced and published sequence numbers
+  alignas(config::CACHELINE_SIZE) std::atomic<uint64_t> intent_;
+  std::atomic<uint64_t> cursor_;
+
+  // Element storage (read-only pointer, kept off the writer line)
+  alignas(config::CACHELINE_SIZE) std::unique_ptr<T[]> buffer_;
+};
+
+} // namespace core
+} // namespace hft
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../types.hpp"
+#include <cstdint>
+#include <memory>
+
+namespace hft {
+namespace core {
+
+// Pending updates for a subscriber that has fallen behind, at most one per
+// (instrument, message type). A newer update replaces the pending one in
+// place, so the subscriber sees the latest state per key in first-seen
+// order. Everything is allocated up front: a flat table maps each key to
+// its position in a fixed-capacity FIFO ring of pending updates, so the
+// dispatching thread never allocates. Updates whose key falls outside the
+// table are queued without conflation. Owned and used by the dispatching
+// thread only.
+class ConflationBuffer {
+public:
+  static constexpr size_t MAX_INSTRUMENTS = 65536;
+  // One key per NormalizedMessage::Type, numbered from 0 to TRADE_BREAK
+  static constexpr size_t TYPE_COUNT =
+      static_cast<size_t>(NormalizedMessage::Type::TRADE_BREAK) + 1;
+  static_assert(static_cast<size_t>(NormalizedMessage::Type::UNKNOWN) == 0,
+                "Type values must start at 0 to index the key table");
+  static constexpr size_t DEFAULT_CAPACITY = config::DEFAULT_QUEUE_SIZE;
+
+  explicit ConflationBuffer(size_t capacity = DEFAULT_CAPACITY)
+      : capacity_(capacity > 0 ? capacity : 1),
+        pending_(std::make_unique<NormalizedMessage[]>(capacity_)),
+        positions_(std::make_unique<uint32_t[]>(MAX_INSTRUMENTS * TYPE_COUNT)),
+        head_(0), size_(0), conflated_(0) {
+    for (size_t i = 0; i < MAX_INSTRUMENTS * TYPE_COUNT; ++i) {
+      positions_[i] = NONE;
+    }
+  }
+
+  ConflationBuffer(const ConflationBuffer &) = delete;
+  ConflationBuffer &operator=(const ConflationBuffer &) = delete;
+
+  // Queue an update, replacing the pending one with the same key (the
+  // older update is lost and counted in conflated()).
+  // Returns false if a new key found the buffer full; the update is dropped
+  bool add(const NormalizedMessage &msg) noexcept {
+    const size_t key = key_of(msg);
+    if (key != NONE && positions_[key] != NONE) {
+      pending_[positions_[key]] = msg;
+      conflated_++;
+      return true;
+    }
+    if (size_ == capacity_) {
+      return false;
+    }
+    const size_t position = wrap(head_ + size_);
+    pending_[position] = msg;
+    if (key != NONE) {
+      positions_[key] = static_cast<uint32_t>(position);
+    }
+    size_++;
+    return true;
+  }
+
+  // Oldest pending update (buffer must not be empty)
+  const NormalizedMessage &front() const noexcept { return pending_[head_]; }
+
+  // Drop the oldest pending update once it has been handed on
+  void pop() noexcept {
+    const size_t key = key_of(pending_[head_]);
+    if (key != NONE) {
+      positions_[key] = NONE;
+    }
+    head_ = wrap(head_ + 1);
+    size_--;
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_t size() const noexcept { return size_; }
+  size_t capacity() const noexcept { return capacity_; }
+
+  // Updates replaced by newer ones since construction
+  uint64_t conflated() const noexcept { return conflated_; }
+
+private:
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  // Table index of the message's key, NONE if it has no entry
+  static size_t key_of(const NormalizedMessage &msg) noexcept {
+    const size_t type = static_cast<uint8_t>(msg.type);
+    if (msg.instrument_id >= MAX_INSTRUMENTS || type >= TYPE_COUNT) {
+      return NONE;
+    }
+    return msg.instrument_id * TYPE_COUNT + type;
+  }
+
+  size_t wrap(size_t position) const noexcept {
+    return position >= capacity_ ? position - capacity_ : position;
+  }
+
+  size_t capacity_;
+  std::unique_ptr<NormalizedMessage[]> pending_; // FIFO ring from head_
+  std::unique_ptr<uint32_t[]> positions_;        // Key -> ring position
+  size_t head_;
+  size_t size_;
+  uint64_t conflated_;
+};
+
+} // namespace core
+} // namespace hft
@@ -1,57 +1,229 @@
 #pragma once
 
 #include "../types.hpp"
+#include "broadcast_ring.hpp"
+#include "../metrics/histogram.hpp"
+#include "../metrics/stats_block.hpp"
+#include "../trace/tracer.hpp"
+#include "conflation_buffer.hpp"
 #include "lockfree_queue.hpp"
 #include "subscriber.hpp"
+#include "subscription_filter.hpp"
+#include <algorithm>
 #include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace hft {
 namespace core {
 
+// How the dispatcher fans messages out to subscribers
+enum class DispatchMode : uint8_t {
+  QUEUE_PER_SUBSCRIBER = 0, // One SPSC queue per subscriber (N copies)
+  BROADCAST = 1             // One shared ring, one read cursor per subscriber
+};
+
+// Which subscribers share a consumer thread
+enum class ConsumerThreads : uint8_t {
+  SHARED = 0,         // One dispatch thread delivers to every subscriber
+  PER_SUBSCRIBER = 1, // A dedicated thread per subscriber
+  PER_GROUP = 2       // One thread per SubscriberOptions::group
+};
+
+// Dispatcher configuration
+struct DispatcherConfig {
+  DispatchMode mode{DispatchMode::QUEUE_PER_SUBSCRIBER};
+  ConsumerThreads threads{ConsumerThreads::SHARED};
+
+  DispatcherConfig() = default;
+};
+
+// Per-subscriber registration options
+struct SubscriberOptions {
+  uint32_t group{0}; // Consumer thread group (ConsumerThreads::PER_GROUP)
+  int cpu{-1};       // Consumer thread affinity, -1 = none; a group's thread
+                     // uses the first member that sets one
+  bool inline_dispatch{false}; // Call on_message on the parser thread from
+                               // dispatch(), bypassing queues and threads
+  SubscriptionFilter filter;   // Instruments and types to deliver
+  bool conflate{false}; // Queue mode: once the queue is full, keep only the
+                        // latest update per instrument and type instead of
+                        // dropping, until the subscriber catches up; the
+                        // buffer holds one queue's worth of keys
+
+  SubscriberOptions() = default;
+};
+
+// Per-subscriber delivery counters
+struct SubscriberStats {
+  uint64_t messages_delivered{0};
+  uint64_t messages_dropped{0}; // Queue full, or lapped by the broadcast ring
+  uint64_t messages_conflated{0}; // Replaced by a newer update while behind
+  uint64_t lag{0};              // Messages waiting to be delivered
+
+  // Dispatch -> on_message latency (local receive timestamp based)
+  uint64_t min_latency_ns{UINT64_MAX};
+  uint64_t max_latency_ns{0};
+  uint64_t total_latency_ns{0};
+
+  double avg_latency_ns() const noexcept {
+    return messages_delivered > 0
+               ? static_cast<double>(total_latency_ns) / messages_delivered
+               : 0.0;
+  }
+};
+
+// Identifies a subscriber for stats and removal (assigned in add order)
+using SubscriberId = uint64_t;
+
+// A current subscriber, as listed by Dispatcher::subscribers()
+struct SubscriberInfo {
+  SubscriberId id{0};
+  std::string name;
+  bool inline_dispatch{false};
+};
+
 // Dispatcher distributes normalized messages to multiple subscribers
-// Uses lock-free queues for each subscriber to minimize latency
+// Queue mode copies each message into a lock-free queue per subscriber and
+// backpressures slow subscribers by dropping at their queue, or by conflating
+// to the latest update per instrument for subscribers that ask for it
+// (flush_conflated() hands those on once the queue drains; CoreEngine calls
+// it after every packet and when idle). Broadcast mode
+// writes each message once into a shared ring that every subscriber reads at
+// its own position; a slow subscriber is lapped instead of slowing the parser.
+// Subscribers are drained by one shared consumer thread, or by a thread per
+// subscriber or group so a slow subscriber cannot delay the others. Inline
+// subscribers skip all of that and are called directly by dispatch().
+// Subscription filters are applied before a message is queued; in broadcast
+// mode the message is written once and non-matching ones are skipped by the
+// subscriber's reader instead.
+//
+// Subscribers can be added and removed while running. The hot paths read an
+// immutable routing snapshot through an atomic pointer and take no locks;
+// control calls build a new snapshot and retire the old one. Retired
+// snapshots and removed subscribers are freed once every hot thread has
+// passed a quiescent point (quiescent-state based reclamation): consumer
+// threads after each loop, the dispatch() caller after each call or via
+// quiescent() when idle.
 class Dispatcher {
 public:
-  Dispatcher() : running_(false), stats_() {}
+  using MessageRing = BroadcastRing<NormalizedMessage>;
 
-  ~Dispatcher() { stop(); }
+  explicit Dispatcher(const DispatcherConfig &config = DispatcherConfig{})
+      : config_(config), routes_(new Routes()), epoch_(1), producer_epoch_(0),
+        unsubscribed_(false), running_(false), shared_cpu_(-1), next_id_(0),
+        next_worker_index_(0), stats_() {
+    if (config_.mode == DispatchMode::BROADCAST) {
+      ring_ = std::make_unique<MessageRing>();
+    }
+  }
 
-  // Add a subscriber (not thread-safe, call before start())
-  void add_subscriber(std::unique_ptr<ISubscriber> subscriber) {
-    subscribers_.push_back(std::move(subscriber));
-    queues_.push_back(std::make_unique<SPSCQueue<NormalizedMessage>>());
+  ~Dispatcher() {
+    stop();
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    reclaim_locked();
+    delete routes_.load();
   }
 
-  // Start dispatcher thread
-  void start() {
+  Dispatcher(const Dispatcher &) = delete;
+  Dispatcher &operator=(const Dispatcher &) = delete;
+
+  // Add a subscriber - safe to call while running
+  // Returns the id used by subscriber_stats() and remove_subscriber()
+  SubscriberId
+  add_subscriber(std::unique_ptr<ISubscriber> subscriber,
+                 const SubscriberOptions &options = SubscriberOptions{}) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+
+    auto sub = std::make_unique<Subscription>();
+    sub->id = next_id_++;
+    sub->subscriber = std::move(subscriber);
+    sub->options = options;
+    if (options.inline_dispatch) {
+      // Delivered synchronously - needs neither a queue nor a ring cursor
+    } else if (ring_) {
+      sub->reader = std::make_unique<MessageRing::Reader>(*ring_);
+    } else {
+      sub->queue = std::make_unique<SPSCQueue<NormalizedMessage>>();
+      if (options.conflate) {
+        sub->conflation = std::make_unique<ConflationBuffer>();
+      }
+    }
+
+    if (running_.load()) {
+      sub->subscriber->initialize();
+      sub->initialized = true;
+    }
+
+    const SubscriberId id = sub->id;
+    subscriptions_.push_back(std::move(sub));
+    publish_routes();
+    return id;
+  }
+
+  // Remove a subscriber - safe to call while running
+  // Delivery stops immediately; shutdown() and destruction happen once no
+  // hot thread can still reference it (see reclaim()). Do not call from
+  // on_message - return false from it instead
+  bool remove_subscriber(SubscriberId id) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+
+    Subscription *sub = find(id);
+    if (sub == nullptr) {
+      return false;
+    }
+    sub->active.store(false, std::memory_order_relaxed);
+    publish_routes();
+    return true;
+  }
+
+  // Start consumer thread(s)
+  // cpu_affinity pins the shared thread; per-subscriber and per-group threads
+  // use SubscriberOptions::cpu
+  void start(int cpu_affinity = -1) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
     if (running_.load())
       return;
 
     // Initialize all subscribers
-    for (auto &sub : subscribers_) {
-      sub->initialize();
+    for (auto &sub : subscriptions_) {
+      sub->subscriber->initialize();
+      sub->initialized = true;
     }
 
+    shared_cpu_ = cpu_affinity;
     running_.store(true);
-    dispatch_thread_ = std::thread(&Dispatcher::dispatch_loop, this);
+    publish_routes();
   }
 
-  // Stop dispatcher thread
+  // Stop consumer thread(s)
   void stop() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
     if (!running_.load())
       return;
 
     running_.store(false);
-    if (dispatch_thread_.joinable()) {
-      dispatch_thread_.join();
+    for (auto &worker : workers_) {
+      stop_worker(*worker);
     }
+    workers_.clear();
+
+    // No consumer threads left - unlink and free everything retired
+    publish_routes();
 
     // Shutdown all subscribers
-    for (auto &sub : subscribers_) {
-      sub->shutdown();
+    for (auto &sub : subscriptions_) {
+      sub->subscriber->shutdown();
+      sub->initialized = false;
     }
   }
 
@@ -60,47 +232,509 @@ public:
   void dispatch(const NormalizedMessage &msg) noexcept {
     const Timestamp now = get_timestamp();
     const uint64_t latency = now - msg.local_timestamp;
+    const Routes *routes = routes_.load(std::memory_order_acquire);
+    uint64_t dropped = 0;
+
+    // Inline subscribers run first, right here on the parser thread
+    for (Subscription *sub : routes->inline_subscriptions) {
+      if (sub->options.filter.matches(msg)) {
+        deliver(*sub, msg, now);
+      }
+    }
 
-    // Push to all subscriber queues
-    for (auto &queue : queues_) {
-      if (!queue->push(msg)) {
-        stats_.packets_dropped++;
+    if (ring_) {
+      // Written once, read by every queued subscriber
+      if (!routes->queued.empty()) {
+        ring_->publish(msg);
+      }
+    } else {
+      // Push to all subscriber queues
+      for (Subscription *sub : routes->queued) {
+        if (!sub->active.load(std::memory_order_relaxed) ||
+            !sub->options.filter.matches(msg)) {
+          continue;
+        }
+        if (sub->conflation ? !offer(*sub, msg) : !sub->queue->push(msg)) {
+          increment(sub->dropped, 1);
+          dropped++;
+        }
       }
     }
 
-    stats_.messages_dispatched++;
-    stats_.update_latency(latency);
+    HFT_TRACE_POINT(ENQUEUE, msg.trace_id, routes->queued.size());
+
+    stats_.begin();
+    stats_.add_packets_dropped(dropped);
+    stats_.add_messages_dispatched(1);
+    stats_.record_latency(latency);
+    stats_.commit();
+
+    quiescent();
+  }
+
+  // Move conflated updates into queues that have drained since the last
+  // dispatch() - call from the dispatching thread after each batch and when
+  // it is idle, so pending updates do not wait for their key's next update
+  void flush_conflated() noexcept {
+    const Routes *routes = routes_.load(std::memory_order_acquire);
+    for (Subscription *sub : routes->conflating) {
+      if (!sub->conflation->empty()) {
+        drain(*sub);
+      }
+    }
+  }
+
+  // Declare the dispatch() caller quiescent (holding no routing snapshot)
+  // dispatch() does this itself; call it when the producer thread is idle
+  // so removals can complete without new messages
+  void quiescent() noexcept {
+    producer_epoch_.store(epoch_.load(std::memory_order_acquire),
+                          std::memory_order_release);
+  }
+
+  // Unlink subscribers whose on_message returned false and free whatever
+  // has passed its grace period - call periodically from a control thread
+  void reclaim() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    if (unsubscribed_.exchange(false, std::memory_order_relaxed)) {
+      publish_routes();
+    } else {
+      reclaim_locked();
+    }
+  }
+
+  // Removed subscribers waiting for their grace period
+  size_t pending_removals() const {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    size_t pending = 0;
+    for (const auto &retired : retired_) {
+      pending += retired.subscriptions.size();
+    }
+    return pending;
+  }
+
+  // Get a statistics snapshot (any thread)
+  Statistics get_stats() const noexcept { return stats_.snapshot(); }
+
+  // Get delivery counters and current lag for one subscriber
+  // Returns zeroed stats for unknown or removed ids
+  SubscriberStats subscriber_stats(SubscriberId id) const {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    SubscriberStats stats;
+
+    const Subscription *sub = find(id);
+    if (sub == nullptr) {
+      return stats;
+    }
+
+    const Statistics delivery = sub->delivery.snapshot();
+    stats.messages_delivered = delivery.messages_dispatched;
+    stats.min_latency_ns = delivery.min_latency_ns;
+    stats.max_latency_ns = delivery.max_latency_ns;
+    stats.total_latency_ns = delivery.total_latency_ns;
+    if (sub->options.inline_dispatch) {
+      // Delivered synchronously - never dropped, never behind
+    } else if (ring_) {
+      stats.messages_dropped = sub->reader->lost();
+      stats.lag = sub->reader->lag();
+    } else {
+      stats.messages_dropped = sub->dropped.load(std::memory_order_relaxed);
+      stats.messages_conflated =
+          sub->conflated.load(std::memory_order_relaxed);
+      stats.lag =
+          sub->queue->size() + sub->pending.load(std::memory_order_relaxed);
+    }
+    return stats;
   }
 
-  // Get statistics
-  const Statistics &get_stats() const noexcept { return stats_; }
+  // Merge one queued subscriber's receive -> hand-off latency histogram into
+  // out (any thread). Returns false for unknown or removed ids
+  bool delivery_histogram(SubscriberId id, LatencyHistogram &out) const {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    const Subscription *sub = find(id);
+    if (sub == nullptr) {
+      return false;
+    }
+    out.merge(sub->delivery_latency);
+    return true;
+  }
+
+  // Merge every queued subscriber's latency histogram into out (any thread)
+  void delivery_histogram(LatencyHistogram &out) const {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    for (const auto &sub : subscriptions_) {
+      out.merge(sub->delivery_latency);
+    }
+  }
 
   // Get number of subscribers
-  size_t subscriber_count() const noexcept { return subscribers_.size(); }
+  size_t subscriber_count() const {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    return subscriptions_.size();
+  }
+
+  // List current subscribers in add order (any thread)
+  std::vector<SubscriberInfo> subscribers() const {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    std::vector<SubscriberInfo> list;
+    for (const auto &sub : subscriptions_) {
+      if (sub->active.load(std::memory_order_relaxed)) {
+        list.push_back(
+            {sub->id, sub->subscriber->name(), sub->options.inline_dispatch});
+      }
+    }
+    return list;
+  }
+
+  // Get number of consumer threads (0 when stopped)
+  size_t thread_count() const {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    return workers_.size();
+  }
+
+  // Get dispatch mode
+  DispatchMode mode() const noexcept { return config_.mode; }
 
 private:
-  void dispatch_loop() {
-    NormalizedMessage msg;
+  // Everything the dispatcher keeps per subscriber
+  struct Subscription {
+    SubscriberId id{0};
+    std::unique_ptr<ISubscriber> subscriber;
+    std::unique_ptr<SPSCQueue<NormalizedMessage>> queue; // Queue mode
+    std::unique_ptr<MessageRing::Reader> reader;         // Broadcast mode
+    std::unique_ptr<ConflationBuffer> conflation; // Queue mode, conflate set
+    SubscriberOptions options;
+    bool initialized{false};
+    std::atomic<bool> active{true}; // Cleared on removal or unsubscribe
 
-    while (running_.load(std::memory_order_relaxed)) {
-      bool any_activity = false;
+    // Written by the parser thread (queue mode)
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> conflated{0};
+    std::atomic<uint64_t> pending{0}; // Held in the conflation buffer
 
-      // Process messages for each subscriber
-      for (size_t i = 0; i < subscribers_.size(); ++i) {
-        auto &queue = queues_[i];
-        auto &subscriber = subscribers_[i];
+    // Delivered count and latency, written by the consumer thread (parser
+    // thread when inline) - on its own lines, away from the parser's
+    StatsBlock delivery;
+    LatencyHistogram delivery_latency; // Queued subscribers only
+  };
 
-        while (queue->pop(msg)) {
-          any_activity = true;
+  // A consumer thread; its subscriptions live in the routing snapshot
+  struct Worker {
+    size_t index{0}; // Slot in Routes::per_worker, never reused
+    uint64_t key{0}; // Group or subscriber id the thread serves
+    int cpu{-1};
+    std::atomic<bool> running{false};
+    std::thread thread;
+
+    // Last epoch this thread was seen quiescent at
+    alignas(config::CACHELINE_SIZE) std::atomic<uint64_t> quiescent_epoch{0};
+  };
+
+  // Immutable routing snapshot read by the hot paths
+  struct Routes {
+    std::vector<Subscription *> inline_subscriptions; // Called from dispatch()
+    std::vector<Subscription *> queued; // Fed through queues or the ring
+    std::vector<Subscription *> conflating; // Queued with a conflation buffer
+    std::vector<std::vector<Subscription *>> per_worker; // By Worker::index
+  };
+
+  // A replaced snapshot and the subscriptions it alone still references
+  struct Retired {
+    uint64_t epoch;
+    std::unique_ptr<const Routes> routes;
+    std::vector<std::unique_ptr<Subscription>> subscriptions;
+  };
+
+  // Pin a thread to a CPU (no-op for cpu < 0)
+  static void set_thread_affinity(std::thread &thread, int cpu) noexcept {
+#ifdef __linux__
+    if (cpu >= 0) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+      pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t),
+                             &cpuset);
+    }
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+  }
+
+  Subscription *find(SubscriberId id) const noexcept {
+    for (const auto &sub : subscriptions_) {
+      if (sub->id == id && sub->active.load(std::memory_order_relaxed)) {
+        return sub.get();
+      }
+    }
+    return nullptr;
+  }
+
+  // Consumer thread for a subscription, created if needed (not started)
+  Worker *worker_for(const Subscription &sub,
+                     std::vector<Worker *> &created) {
+    uint64_t key = 0;
+    if (config_.threads == ConsumerThreads::PER_SUBSCRIBER) {
+      key = sub.id;
+    } else if (config_.threads == ConsumerThreads::PER_GROUP) {
+      key = sub.options.group;
+    }
+
+    for (auto &worker : workers_) {
+      if (worker->key == key) {
+        // A group's thread takes the first CPU any member asks for
+        if (worker->cpu < 0 && sub.options.cpu >= 0) {
+          worker->cpu = sub.options.cpu;
+          set_thread_affinity(worker->thread, worker->cpu);
+        }
+        return worker.get();
+      }
+    }
+
+    auto worker = std::make_unique<Worker>();
+    worker->index = next_worker_index_++;
+    worker->key = key;
+    worker->cpu = config_.threads == ConsumerThreads::SHARED ? shared_cpu_
+                                                             : sub.options.cpu;
+    worker->quiescent_epoch.store(epoch_.load());
+    created.push_back(worker.get());
+    workers_.push_back(std::move(worker));
+    return created.back();
+  }
+
+  void stop_worker(Worker &worker) {
+    worker.running.store(false);
+    if (worker.thread.joinable()) {
+      worker.thread.join();
+    }
+  }
+
+  // Build a routing snapshot from the current subscriptions, publish it,
+  // match consumer threads to it and retire the previous one
+  // Caller holds control_mutex_
+  void publish_routes() {
+    auto routes = std::make_unique<Routes>();
+    std::vector<std::unique_ptr<Subscription>> removed;
+    std::vector<Worker *> created;
+
+    // Unlink removed and unsubscribed subscriptions
+    for (auto it = subscriptions_.begin(); it != subscriptions_.end();) {
+      if ((*it)->active.load(std::memory_order_relaxed)) {
+        ++it;
+      } else {
+        removed.push_back(std::move(*it));
+        it = subscriptions_.erase(it);
+      }
+    }
 
-          // Deliver to subscriber
-          if (!subscriber->on_message(msg)) {
-            // Subscriber returned false - wants to unsubscribe
-            // TODO: Handle unsubscription
+    for (auto &sub : subscriptions_) {
+      if (sub->options.inline_dispatch) {
+        routes->inline_subscriptions.push_back(sub.get());
+        continue;
+      }
+      routes->queued.push_back(sub.get());
+      if (sub->conflation) {
+        routes->conflating.push_back(sub.get());
+      }
+
+      if (running_.load()) {
+        Worker *worker = worker_for(*sub, created);
+        routes->per_worker.resize(next_worker_index_);
+        routes->per_worker[worker->index].push_back(sub.get());
+      }
+    }
+    routes->per_worker.resize(next_worker_index_);
+
+    // Swap snapshots - hot threads pick up the new one on their next pass
+    const Routes *old = routes_.exchange(routes.release());
+    const uint64_t epoch = epoch_.fetch_add(1) + 1;
+    retired_.push_back(Retired{epoch, std::unique_ptr<const Routes>(old),
+                               std::move(removed)});
+
+    // Start new threads now that their routes exist
+    for (Worker *worker : created) {
+      worker->running.store(true);
+      worker->thread = std::thread(&Dispatcher::dispatch_loop, this, worker);
+      set_thread_affinity(worker->thread, worker->cpu);
+    }
+
+    // Stop threads left without subscriptions
+    const Routes *current = routes_.load();
+    for (auto it = workers_.begin(); it != workers_.end();) {
+      if (current->per_worker[(*it)->index].empty()) {
+        stop_worker(**it);
+        it = workers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    reclaim_locked();
+  }
+
+  // Free retired snapshots and subscriptions every hot thread has moved past
+  // Caller holds control_mutex_
+  void reclaim_locked() {
+    uint64_t safe = UINT64_MAX; // Not running: no consumer threads
+    if (running_.load()) {
+      safe = producer_epoch_.load(std::memory_order_acquire);
+      for (const auto &worker : workers_) {
+        safe = std::min(
+            safe, worker->quiescent_epoch.load(std::memory_order_acquire));
+      }
+    }
+
+    while (!retired_.empty() && retired_.front().epoch <= safe) {
+      for (auto &sub : retired_.front().subscriptions) {
+        if (sub->initialized) {
+          sub->subscriber->shutdown();
+        }
+      }
+      retired_.pop_front();
+    }
+  }
+
+  // Queue a message for a conflating subscriber
+  // Goes straight to the queue while the subscriber keeps up; once it is
+  // behind, updates collect in the conflation buffer (newest per key wins)
+  // and move to the queue in first-seen order as space frees up.
+  // Returns false if the buffer was full too and the message was dropped
+  bool offer(Subscription &sub, const NormalizedMessage &msg) noexcept {
+    if (sub.conflation->empty() && sub.queue->push(msg)) {
+      return true;
+    }
+    const bool buffered = sub.conflation->add(msg);
+    drain(sub);
+    return buffered;
+  }
+
+  // Move pending conflated updates into the subscriber's queue
+  void drain(Subscription &sub) noexcept {
+    ConflationBuffer &buffer = *sub.conflation;
+    while (!buffer.empty() && sub.queue->push(buffer.front())) {
+      buffer.pop();
+    }
+    sub.conflated.store(buffer.conflated(), std::memory_order_relaxed);
+    sub.pending.store(buffer.size(), std::memory_order_relaxed);
+  }
+
+  // Fetch up to max_count messages for a subscriber from its queue or ring
+  // cursor. Returns the number fetched
+  size_t next_batch(Subscription &sub, NormalizedMessage *msgs,
+                    size_t max_count) noexcept {
+    if (!ring_) {
+      return sub.queue->pop_n(msgs, max_count); // Filtered by dispatch()
+    }
+    size_t count = 0;
+    while (count < max_count && sub.reader->read(msgs[count])) {
+      if (sub.options.filter.matches(msgs[count])) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  // Single-writer counter bump - no locked read-modify-write
+  static void increment(std::atomic<uint64_t> &counter, uint64_t n) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  // Subscriber returned false - stop delivering now, unlink on the next
+  // control call or reclaim()
+  void unsubscribe(Subscription &sub) noexcept {
+    sub.active.store(false, std::memory_order_relaxed);
+    unsubscribed_.store(true, std::memory_order_relaxed);
+  }
+
+  // Hand one message to a subscriber and record its delivery latency
+  void deliver(Subscription &sub, const NormalizedMessage &msg,
+               Timestamp now) noexcept {
+    if (!sub.active.load(std::memory_order_relaxed)) {
+      return;
+    }
+    sub.delivery.begin();
+    sub.delivery.add_messages_dispatched(1);
+    sub.delivery.record_latency(now - msg.local_timestamp);
+    sub.delivery.commit();
+    HFT_TRACE_POINT(CALLBACK_BEGIN, msg.trace_id, sub.id);
+    const bool keep = sub.subscriber->on_message(msg);
+    HFT_TRACE_POINT(CALLBACK_END, msg.trace_id, sub.id);
+    if (!keep) {
+      unsubscribe(sub);
+    }
+  }
+
+  // Hand a drained batch to a subscriber in one call
+  void deliver_batch(Subscription &sub, const NormalizedMessage *msgs,
+                     size_t count) noexcept {
+    const Timestamp now = get_timestamp();
+    sub.delivery.begin();
+    sub.delivery.add_messages_dispatched(count);
+    for (size_t i = 0; i < count; ++i) {
+      const uint64_t latency = now - msgs[i].local_timestamp;
+      sub.delivery.record_latency(latency);
+      sub.delivery_latency.record(latency);
+    }
+    sub.delivery.commit();
+#ifdef HFT_TRACE
+    trace_batch(TracePoint::CALLBACK_BEGIN, sub, msgs, count);
+#endif
+    const bool keep = sub.subscriber->on_messages(msgs, count);
+#ifdef HFT_TRACE
+    trace_batch(TracePoint::CALLBACK_END, sub, msgs, count);
+#endif
+    if (!keep) {
+      unsubscribe(sub);
+    }
+  }
+
+#ifdef HFT_TRACE
+  // Record a callback point for every sampled message in a batch
+  static void trace_batch(TracePoint point, const Subscription &sub,
+                          const NormalizedMessage *msgs,
+                          size_t count) noexcept {
+    Timestamp now = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (msgs[i].trace_id != 0) {
+        if (now == 0) {
+          now = get_timestamp();
+        }
+        Tracer::instance().record(point, msgs[i].trace_id,
+                                  static_cast<uint16_t>(sub.id), now);
+      }
+    }
+  }
+#endif
+
+  void dispatch_loop(Worker *worker) {
+    NormalizedMessage batch[config::MAX_DELIVERY_BATCH];
+#ifdef HFT_TRACE
+    Tracer::instance().set_thread_name(
+        ("dispatch " + std::to_string(worker->index)).c_str());
+#endif
+
+    while (worker->running.load(std::memory_order_relaxed)) {
+      bool any_activity = false;
+      const Routes *routes = routes_.load(std::memory_order_acquire);
+
+      // Drain each subscriber owned by this thread a batch at a time
+      for (Subscription *sub : routes->per_worker[worker->index]) {
+        while (sub->active.load(std::memory_order_relaxed)) {
+          const size_t count =
+              next_batch(*sub, batch, config::MAX_DELIVERY_BATCH);
+          if (count == 0) {
+            break;
           }
+          any_activity = true;
+          deliver_batch(*sub, batch, count);
         }
       }
 
+      // Done with this snapshot
+      worker->quiescent_epoch.store(epoch_.load(std::memory_order_acquire),
+                                    std::memory_order_release);
+
       // Yield if no activity to reduce CPU usage
       if (!any_activity) {
         std::this_thread::yield();
@@ -108,11 +742,26 @@ private:
     }
   }
 
-  std::vector<std::unique_ptr<ISubscriber>> subscribers_;
-  std::vector<std::unique_ptr<SPSCQueue<NormalizedMessage>>> queues_;
-  std::thread dispatch_thread_;
+  DispatcherConfig config_;
+  std::unique_ptr<MessageRing> ring_; // Broadcast mode only
+
+  // Hot path state
+  std::atomic<const Routes *> routes_;
+  alignas(config::CACHELINE_SIZE) std::atomic<uint64_t> epoch_;
+  alignas(config::CACHELINE_SIZE) std::atomic<uint64_t> producer_epoch_;
+  std::atomic<bool> unsubscribed_;
   std::atomic<bool> running_;
-  Statistics stats_;
+
+  // Control state, guarded by control_mutex_ (never taken on hot paths)
+  mutable std::mutex control_mutex_;
+  std::vector<std::unique_ptr<Subscription>> subscriptions_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::deque<Retired> retired_;
+  int shared_cpu_;
+  SubscriberId next_id_;
+  size_t next_worker_index_;
+
+  StatsBlock stats_; // Written by the dispatch() caller
 };
 
 } // namespace core
@@ -3,58 +3,102 @@
 #include "../types.hpp"
 #include <atomic>
 #include <memory>
+#include <new>
+#include <utility>
 
 namespace hft {
 namespace core {
 
 // Single Producer Single Consumer lock-free queue
-// Optimized for minimum latency with cache-line padding
+// Optimized for minimum latency with cache-line padding. Each side keeps a
+// cached copy of the other side's index and only reloads it (an acquire load
+// that pulls the remote cache line) when the queue looks full or empty
 template <typename T, size_t Size = config::DEFAULT_QUEUE_SIZE>
 class SPSCQueue {
   static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
 
 public:
-  SPSCQueue() : head_(0), tail_(0) {
+  SPSCQueue() : head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
     // Allocate with alignment for optimal cache behavior
     buffer_ = std::make_unique<T[]>(Size);
   }
 
-  // Push element (producer side)
-  // Returns true if successful, false if queue is full
-  bool push(const T &item) noexcept {
+  // Claim the next free slot for in-place writes (producer side)
+  // Returns nullptr if queue is full. The slot still holds a previously
+  // used T, so overwrite every field, then publish it with commit()
+  T *try_claim() noexcept {
     const size_t head = head_.load(std::memory_order_relaxed);
     const size_t next_head = (head + 1) & (Size - 1);
 
-    if (next_head == tail_.load(std::memory_order_acquire)) {
-      return false; // Queue is full
+    if (next_head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (next_head == cached_tail_) {
+        return nullptr; // Queue is full
+      }
     }
 
-    buffer_[head] = item;
-    head_.store(next_head, std::memory_order_release);
-    return true;
+    return &buffer_[head];
   }
 
-  // Push with move semantics
-  bool push(T &&item) noexcept {
+  // Publish the slot returned by the last successful try_claim()
+  void commit() noexcept {
     const size_t head = head_.load(std::memory_order_relaxed);
-    const size_t next_head = (head + 1) & (Size - 1);
+    head_.store((head + 1) & (Size - 1), std::memory_order_release);
+  }
 
-    if (next_head == tail_.load(std::memory_order_acquire)) {
+  // Construct element directly in the next free slot (producer side)
+  // Returns true if successful, false if queue is full
+  template <typename... Args> bool emplace(Args &&...args) noexcept {
+    T *slot = try_claim();
+    if (slot == nullptr) {
       return false;
     }
 
-    buffer_[head] = std::move(item);
-    head_.store(next_head, std::memory_order_release);
+    slot->~T();
+    new (slot) T(std::forward<Args>(args)...);
+    commit();
     return true;
   }
 
+  // Push element (producer side)
+  // Returns true if successful, false if queue is full
+  bool push(const T &item) noexcept { return emplace(item); }
+
+  // Push with move semantics
+  bool push(T &&item) noexcept { return emplace(std::move(item)); }
+
+  // Push up to 'count' elements with a single index publish (producer side)
+  // Returns the number pushed (0 if full)
+  size_t push_n(const T *items, size_t count) noexcept {
+    const size_t head = head_.load(std::memory_order_relaxed);
+
+    size_t free_slots = (cached_tail_ - head - 1) & (Size - 1);
+    if (free_slots < count) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      free_slots = (cached_tail_ - head - 1) & (Size - 1);
+    }
+
+    const size_t n = count < free_slots ? count : free_slots;
+    for (size_t i = 0; i < n; ++i) {
+      buffer_[(head + i) & (Size - 1)] = items[i];
+    }
+
+    if (n > 0) {
+      head_.store((head + n) & (Size - 1), std::memory_order_release);
+    }
+    return n;
+  }
+
   // Pop element (consumer side)
   // Returns true if successful, false if queue is empty
   bool pop(T &item) noexcept {
     const size_t tail = tail_.load(std::memory_order_relaxed);
 
-    if (tail == head_.load(std::memory_order_acquire)) {
-      return false; // Queue is empty
+    if (tail == cached_head_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail == cached_head_) {
+        return false; // Queue is empty
+      }
     }
 
     item = std::move(buffer_[tail]);
@@ -62,6 +106,28 @@ public:
     return true;
   }
 
+  // Pop up to 'max_items' elements with a single index publish (consumer side)
+  // Returns the number popped (0 if empty)
+  size_t pop_n(T *items, size_t max_items) noexcept {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+
+    size_t available = (cached_head_ - tail) & (Size - 1);
+    if (available < max_items) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      available = (cached_head_ - tail) & (Size - 1);
+    }
+
+    const size_t n = max_items < available ? max_items : available;
+    for (size_t i = 0; i < n; ++i) {
+      items[i] = std::move(buffer_[(tail + i) & (Size - 1)]);
+    }
+
+    if (n > 0) {
+      tail_.store((tail + n) & (Size - 1), std::memory_order_release);
+    }
+    return n;
+  }
+
   // Check if queue is empty
   bool empty() const noexcept {
     return tail_.load(std::memory_order_acquire) ==
@@ -88,12 +154,16 @@ public:
   }
 
 private:
-  // Cache-line aligned atomic indices
+  // Message buffer (read-only pointer, kept off both index lines)
+  alignas(config::CACHELINE_SIZE) std::unique_ptr<T[]> buffer_;
+
+  // Producer line: head index plus the producer's view of tail
   alignas(config::CACHELINE_SIZE) std::atomic<size_t> head_;
-  alignas(config::CACHELINE_SIZE) std::atomic<size_t> tail_;
+  size_t cached_tail_;
 
-  // Message buffer
-  std::unique_ptr<T[]> buffer_;
+  // Consumer line: tail index plus the consumer's view of head
+  alignas(config::CACHELINE_SIZE) std::atomic<size_t> tail_;
+  size_t cached_head_;
 };
 
 // Multi-Producer Single Consumer queue
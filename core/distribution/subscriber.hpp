@@ -16,6 +16,19 @@ public:
   // Return false to unsubscribe
   virtual bool on_message(const NormalizedMessage &msg) noexcept = 0;
 
+  // Called with consecutive messages drained from the subscriber's queue
+  // Override to process a batch at once; the default hands each message to
+  // on_message. Return false to unsubscribe (remaining messages are dropped)
+  virtual bool on_messages(const NormalizedMessage *msgs,
+                           size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+      if (!on_message(msgs[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   // Optional: Called on raw packet before parsing
   // Allows subscribers to access raw data if needed
   virtual void on_raw_packet(const MessageView &view) noexcept {
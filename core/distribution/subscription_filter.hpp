@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../parser/parser_interface.hpp"
+#include "../types.hpp"
+#include <vector>
+
+namespace hft {
+namespace core {
+
+// Instrument set and message type mask for one subscriber
+// Evaluated by the Dispatcher so non-matching messages are never queued.
+// The instrument set is a bitmap over ids below MAX_INSTRUMENTS (ITCH stock
+// locate codes are 16-bit); ids outside it never match an explicit set.
+// Configure before registering the subscriber - the filter is not changed
+// while the dispatcher runs.
+class SubscriptionFilter {
+public:
+  static constexpr size_t MAX_INSTRUMENTS = 65536;
+
+  SubscriptionFilter() : all_instruments_(true), type_mask_(ALL_TYPES) {}
+
+  // Match only the given instruments (the first call narrows from "all")
+  SubscriptionFilter &add_instrument(uint64_t instrument_id) {
+    if (all_instruments_) {
+      all_instruments_ = false;
+      instruments_.assign(MAX_INSTRUMENTS / 64, 0);
+    }
+    if (instrument_id < MAX_INSTRUMENTS) {
+      instruments_[instrument_id >> 6] |= uint64_t{1} << (instrument_id & 63);
+    }
+    return *this;
+  }
+
+  // Match an instrument by ticker symbol, resolved through the parser
+  // Returns false if the parser does not know the symbol
+  bool add_symbol(const char *symbol, const IParser &parser) {
+    uint64_t instrument_id = 0;
+    if (!parser.find_instrument(symbol, instrument_id)) {
+      return false;
+    }
+    add_instrument(instrument_id);
+    return true;
+  }
+
+  // Match only the given message types (the first call narrows from "all")
+  SubscriptionFilter &add_type(NormalizedMessage::Type type) {
+    if (type_mask_ == ALL_TYPES) {
+      type_mask_ = 0;
+    }
+    type_mask_ |= type_bit(type);
+    return *this;
+  }
+
+  // Check a message against the filter
+  bool matches(const NormalizedMessage &msg) const noexcept {
+    if ((type_mask_ & type_bit(msg.type)) == 0) {
+      return false;
+    }
+    if (all_instruments_) {
+      return true;
+    }
+    return msg.instrument_id < MAX_INSTRUMENTS &&
+           (instruments_[msg.instrument_id >> 6] >>
+            (msg.instrument_id & 63)) & 1;
+  }
+
+  // True if every message matches (no filtering configured)
+  bool accepts_all() const noexcept {
+    return all_instruments_ && type_mask_ == ALL_TYPES;
+  }
+
+private:
+  static constexpr uint32_t ALL_TYPES = UINT32_MAX;
+
+  static constexpr uint32_t type_bit(NormalizedMessage::Type type) noexcept {
+    return uint32_t{1} << (static_cast<uint8_t>(type) & 31);
+  }
+
+  bool all_instruments_;
+  uint32_t type_mask_;
+  std::vector<uint64_t> instruments_; // MAX_INSTRUMENTS bits when narrowed
+};
+
+} // namespace core
+} // namespace hft
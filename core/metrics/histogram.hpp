@@ -0,0 +1,203 @@
+#pragma once
+
+#include "../types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hft {
+namespace core {
+
+// Pipeline stages with their own latency histogram
+enum class LatencyStage : uint8_t {
+  RECEIVE_TO_PARSE = 0,   // Packet received -> parse starts
+  PARSE = 1,              // Parse of one packet
+  PARSE_TO_DISPATCH = 2,  // Parse done -> all its messages dispatched
+  QUEUE_TO_SUBSCRIBER = 3 // Message received -> handed to a queued subscriber
+};
+
+static constexpr size_t LATENCY_STAGE_COUNT = 4;
+
+inline const char *latency_stage_name(LatencyStage stage) noexcept {
+  switch (stage) {
+  case LatencyStage::RECEIVE_TO_PARSE:
+    return "receive_to_parse";
+  case LatencyStage::PARSE:
+    return "parse";
+  case LatencyStage::PARSE_TO_DISPATCH:
+    return "parse_to_dispatch";
+  case LatencyStage::QUEUE_TO_SUBSCRIBER:
+    return "queue_to_subscriber";
+  }
+  return "unknown";
+}
+
+// Fixed-size log-linear latency histogram (HDR-style)
+// Values below 2^SUB_BUCKET_BITS are counted exactly; above that each power
+// of two is split into 2^SUB_BUCKET_BITS linear buckets, so any recorded
+// value is reported within 1/64 (~1.6%) of itself. Covers the full uint64_t
+// range in ~30 KB with no allocation. One thread records; any thread may
+// read or merge() it into another histogram (counters are relaxed atomics).
+class LatencyHistogram {
+public:
+  static constexpr unsigned SUB_BUCKET_BITS = 6;
+  static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT =
+      (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+  LatencyHistogram() noexcept { reset(); }
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  // Record one value (writer side)
+  void record(uint64_t value) noexcept { record(value, 1); }
+
+  // Record a value seen n times (writer side)
+  void record(uint64_t value, uint64_t n) noexcept {
+    add(counts_[bucket_of(value)], n);
+    add(count_, n);
+    add(total_, value * n);
+    if (value < min_.load(std::memory_order_relaxed))
+      min_.store(value, std::memory_order_relaxed);
+    if (value > max_.load(std::memory_order_relaxed))
+      max_.store(value, std::memory_order_relaxed);
+  }
+
+  // Add another histogram's counts to this one (writer side of this one)
+  void merge(const LatencyHistogram &other) noexcept {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      const uint64_t n = other.counts_[i].load(std::memory_order_relaxed);
+      if (n != 0) {
+        add(counts_[i], n);
+      }
+    }
+    add(count_, other.count());
+    add(total_, other.total_.load(std::memory_order_relaxed));
+    if (other.min() < min())
+      min_.store(other.min(), std::memory_order_relaxed);
+    if (other.max() > max())
+      max_.store(other.max(), std::memory_order_relaxed);
+  }
+
+  // Smallest recorded value that at least percentile% of values are at or
+  // below (0 < percentile <= 100), reported as its bucket's upper bound.
+  // Returns 0 if nothing has been recorded
+  uint64_t percentile(double percentile) const noexcept {
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      total += counts_[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+      return 0;
+    }
+    if (percentile <= 0.0) {
+      return min();
+    }
+
+    uint64_t target = static_cast<uint64_t>(percentile / 100.0 *
+                                            static_cast<double>(total) +
+                                            0.5);
+    if (target == 0) {
+      target = 1;
+    }
+    if (target > total) {
+      target = total;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if (seen >= target) {
+        const uint64_t upper = highest_in_bucket(i);
+        const uint64_t largest = max();
+        return upper < largest ? upper : largest;
+      }
+    }
+    return max();
+  }
+
+  uint64_t count() const noexcept {
+    return count_.load(std::memory_order_relaxed);
+  }
+  uint64_t min() const noexcept { return min_.load(std::memory_order_relaxed); }
+  uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+  // Sum of all recorded values
+  uint64_t total() const noexcept {
+    return total_.load(std::memory_order_relaxed);
+  }
+
+  // Values recorded at or below value, to bucket precision (values sharing
+  // its bucket count as below it)
+  uint64_t count_at_or_below(uint64_t value) const noexcept {
+    const size_t last = bucket_of(value);
+    uint64_t n = 0;
+    for (size_t i = 0; i <= last; ++i) {
+      n += counts_[i].load(std::memory_order_relaxed);
+    }
+    return n;
+  }
+
+  // Values recorded in one bucket (index < BUCKET_COUNT)
+  uint64_t bucket_count(size_t index) const noexcept {
+    return counts_[index].load(std::memory_order_relaxed);
+  }
+
+  double mean() const noexcept {
+    const uint64_t n = count();
+    return n > 0 ? static_cast<double>(total_.load(std::memory_order_relaxed)) /
+                       static_cast<double>(n)
+                 : 0.0;
+  }
+
+  // Clear all counts (writer side, or while the writer is stopped)
+  void reset() noexcept {
+    for (auto &bucket : counts_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  // Bucket index for a value
+  static size_t bucket_of(uint64_t value) noexcept {
+    if (value < SUB_BUCKETS) {
+      return static_cast<size_t>(value);
+    }
+    const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value));
+    const unsigned shift = msb - SUB_BUCKET_BITS;
+    return ((shift + 1) << SUB_BUCKET_BITS) +
+           static_cast<size_t>((value >> shift) - SUB_BUCKETS);
+  }
+
+  // Largest value that lands in a bucket
+  static uint64_t highest_in_bucket(size_t index) noexcept {
+    if (index < SUB_BUCKETS) {
+      return index;
+    }
+    const unsigned shift =
+        static_cast<unsigned>(index >> SUB_BUCKET_BITS) - 1;
+    const uint64_t lowest = (SUB_BUCKETS + (index & (SUB_BUCKETS - 1)))
+                            << shift;
+    return lowest + ((uint64_t{1} << shift) - 1);
+  }
+
+private:
+  // Single writer - a plain load and store instead of fetch_add
+  static void add(std::atomic<uint64_t> &counter, uint64_t n) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  alignas(config::CACHELINE_SIZE) std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> total_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+  std::atomic<uint64_t> counts_[BUCKET_COUNT];
+};
+
+} // namespace core
+} // namespace hft
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace hft {
+namespace core {
+
+// Minimal HTTP listener serving GET /metrics for Prometheus scrapers
+// Runs its own background thread - keep it on a non-isolated core. Each
+// scrape calls render() on that thread, which should only read snapshots
+// (e.g. CoreEngine::metrics_text()). One connection at a time, closed after
+// each response.
+class MetricsExporter {
+public:
+  using Render = std::function<std::string()>;
+
+  explicit MetricsExporter(Render render)
+      : render_(std::move(render)), running_(false), listen_fd_(-1),
+        port_(0), scrapes_(0) {}
+
+  ~MetricsExporter() { stop(); }
+
+  MetricsExporter(const MetricsExporter &) = delete;
+  MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+  // Listen on address:port (port 0 picks a free one) and start serving
+  // cpu pins the serving thread (-1 = no affinity). Returns false if the
+  // socket cannot be set up
+  bool start(uint16_t port, const std::string &address = "127.0.0.1",
+             int cpu = -1) {
+    if (running_.load()) {
+      return true;
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      return false;
+    }
+    int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1 ||
+        bind(listen_fd_, reinterpret_cast<struct sockaddr *>(&addr),
+             sizeof(addr)) < 0 ||
+        listen(listen_fd_, 16) < 0) {
+      close(listen_fd_);
+      listen_fd_ = -1;
+      return false;
+    }
+
+    socklen_t length = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<struct sockaddr *>(&addr),
+                &length);
+    port_ = ntohs(addr.sin_port);
+
+    running_.store(true);
+    thread_ = std::thread(&MetricsExporter::serve_loop, this);
+    if (cpu >= 0) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+      pthread_setaffinity_np(thread_.native_handle(), sizeof(cpu_set_t),
+                             &cpuset);
+    }
+    return true;
+  }
+
+  void stop() {
+    if (!running_.load()) {
+      return;
+    }
+    running_.store(false);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    close(listen_fd_);
+    listen_fd_ = -1;
+  }
+
+  bool is_running() const noexcept { return running_.load(); }
+
+  // Port actually listened on (0 when stopped)
+  uint16_t port() const noexcept { return running_.load() ? port_ : 0; }
+
+  // Successful /metrics responses so far
+  uint64_t scrapes() const noexcept { return scrapes_.load(); }
+
+private:
+  static constexpr size_t MAX_REQUEST = 4096;
+  static constexpr int POLL_INTERVAL_MS = 100; // Bounds stop() latency
+
+  void serve_loop() {
+    while (running_.load(std::memory_order_relaxed)) {
+      struct pollfd pfd;
+      pfd.fd = listen_fd_;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (poll(&pfd, 1, POLL_INTERVAL_MS) <= 0) {
+        continue;
+      }
+
+      const int client = accept(listen_fd_, nullptr, nullptr);
+      if (client < 0) {
+        continue;
+      }
+      handle(client);
+      close(client);
+    }
+  }
+
+  void handle(int client) {
+    // A stalled client must not hold the thread past stop()
+    struct timeval timeout;
+    timeout.tv_sec = 1;
+    timeout.tv_usec = 0;
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.size() < MAX_REQUEST) {
+      const ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+      if (n <= 0) {
+        return;
+      }
+      request.append(buffer, static_cast<size_t>(n));
+    }
+
+    const size_t line_end = request.find("\r\n");
+    const std::string line = request.substr(0, line_end);
+    const bool is_get = line.rfind("GET ", 0) == 0;
+    std::string path;
+    if (is_get) {
+      const size_t path_end = line.find(' ', 4);
+      path = path_end == std::string::npos ? line.substr(4)
+                                           : line.substr(4, path_end - 4);
+    }
+
+    if (!is_get) {
+      respond(client, "405 Method Not Allowed", "text/plain",
+              "Only GET is supported\n");
+    } else if (path == "/metrics" || path.rfind("/metrics?", 0) == 0) {
+      respond(client, "200 OK", "text/plain; version=0.0.4; charset=utf-8",
+              render_());
+      scrapes_.fetch_add(1);
+    } else {
+      respond(client, "404 Not Found", "text/plain", "Try /metrics\n");
+    }
+  }
+
+  static void respond(int client, const char *status, const char *type,
+                      const std::string &body) {
+    std::string response = "HTTP/1.1 ";
+    response += status;
+    response += "\r\nContent-Type: ";
+    response += type;
+    response += "\r\nContent-Length: ";
+    response += std::to_string(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    response += body;
+
+    size_t sent = 0;
+    while (sent < response.size()) {
+      const ssize_t n = send(client, response.data() + sent,
+                             response.size() - sent, MSG_NOSIGNAL);
+      if (n <= 0) {
+        return;
+      }
+      sent += static_cast<size_t>(n);
+    }
+  }
+
+  Render render_;
+  std::atomic<bool> running_;
+  int listen_fd_;
+  uint16_t port_;
+  std::atomic<uint64_t> scrapes_;
+  std::thread thread_;
+};
+
+} // namespace core
+} // namespace hft
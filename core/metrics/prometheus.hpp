@@ -0,0 +1,146 @@
+#pragma once
+
+#include "histogram.hpp"
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hft {
+namespace core {
+
+// Builds a Prometheus text-format (0.0.4) exposition
+// Declare each metric family once with family(), then add its samples
+class PrometheusText {
+public:
+  using Labels = std::vector<std::pair<std::string, std::string>>;
+
+  // Histogram bucket bounds in nanoseconds, exported in seconds
+  static constexpr uint64_t LATENCY_BOUNDS_NS[] = {
+      100,    250,    500,     1000,    2500,    5000,    10000,
+      25000,  50000,  100000,  250000,  500000,  1000000, 2500000,
+      5000000, 10000000};
+
+  // HELP and TYPE lines for a family (type: counter, gauge, histogram)
+  void family(const char *name, const char *type, const char *help) {
+    text_ += "# HELP ";
+    text_ += name;
+    text_ += ' ';
+    text_ += help;
+    text_ += "\n# TYPE ";
+    text_ += name;
+    text_ += ' ';
+    text_ += type;
+    text_ += '\n';
+  }
+
+  void sample(const char *name, const Labels &labels, uint64_t value) {
+    text_ += name;
+    append_labels(labels, nullptr);
+    text_ += ' ';
+    text_ += std::to_string(value);
+    text_ += '\n';
+  }
+
+  void sample(const char *name, uint64_t value) { sample(name, {}, value); }
+
+  // Cumulative _bucket, _sum and _count samples of a nanosecond latency
+  // histogram, in seconds. Every bucket is read once and all cumulative
+  // values, +Inf and _count included, come from that one pass, so they stay
+  // consistent while the writer keeps recording (_sum is a separate read).
+  // An le bound is rounded up to the end of its histogram sub-bucket, so it
+  // also counts values up to 1/64 above it.
+  void latency_histogram(const char *name, const Labels &labels,
+                         const LatencyHistogram &histogram) {
+    const std::string base = name;
+    uint64_t cumulative = 0;
+    size_t bucket = 0;
+    for (const uint64_t bound : LATENCY_BOUNDS_NS) {
+      const size_t last = LatencyHistogram::bucket_of(bound);
+      for (; bucket <= last; ++bucket) {
+        cumulative += histogram.bucket_count(bucket);
+      }
+      text_ += base;
+      text_ += "_bucket";
+      append_labels(labels, seconds(bound).c_str());
+      text_ += ' ';
+      text_ += std::to_string(cumulative);
+      text_ += '\n';
+    }
+    for (; bucket < LatencyHistogram::BUCKET_COUNT; ++bucket) {
+      cumulative += histogram.bucket_count(bucket);
+    }
+    const uint64_t count = cumulative;
+    text_ += base;
+    text_ += "_bucket";
+    append_labels(labels, "+Inf");
+    text_ += ' ';
+    text_ += std::to_string(count);
+    text_ += '\n';
+
+    text_ += base;
+    text_ += "_sum";
+    append_labels(labels, nullptr);
+    text_ += ' ';
+    text_ += seconds(histogram.total());
+    text_ += '\n';
+
+    sample((base + "_count").c_str(), labels, count);
+  }
+
+  const std::string &str() const noexcept { return text_; }
+
+private:
+  static std::string seconds(uint64_t nanos) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g",
+                  static_cast<double>(nanos) / 1e9);
+    return buffer;
+  }
+
+  // {name="value",...} plus le for histogram buckets
+  void append_labels(const Labels &labels, const char *le) {
+    if (labels.empty() && le == nullptr) {
+      return;
+    }
+    text_ += '{';
+    bool first = true;
+    for (const auto &label : labels) {
+      if (!first) {
+        text_ += ',';
+      }
+      first = false;
+      text_ += label.first;
+      text_ += "=\"";
+      append_escaped(label.second);
+      text_ += '"';
+    }
+    if (le != nullptr) {
+      if (!first) {
+        text_ += ',';
+      }
+      text_ += "le=\"";
+      text_ += le;
+      text_ += '"';
+    }
+    text_ += '}';
+  }
+
+  void append_escaped(const std::string &value) {
+    for (const char c : value) {
+      if (c == '\\' || c == '"') {
+        text_ += '\\';
+        text_ += c;
+      } else if (c == '\n') {
+        text_ += "\\n";
+      } else {
+        text_ += c;
+      }
+    }
+  }
+
+  std::string text_;
+};
+
+} // namespace core
+} // namespace hft
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../types.hpp"
+#include <atomic>
+
+namespace hft {
+namespace core {
+
+// Live counters for one pipeline stage, written by that stage's thread only
+// and readable from any thread. Each block sits on its own cache lines so
+// stages never share a line. Writers publish with relaxed loads and stores
+// (no locked read-modify-write); a sequence counter around each group of
+// updates lets snapshot() return values that belong together, e.g. a
+// latency total that matches its message count.
+class alignas(config::CACHELINE_SIZE) StatsBlock {
+public:
+  StatsBlock() noexcept { reset(); }
+
+  StatsBlock(const StatsBlock &) = delete;
+  StatsBlock &operator=(const StatsBlock &) = delete;
+
+  // Open a group of updates (writer side)
+  void begin() noexcept {
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  // Publish the group opened by begin() (writer side)
+  void commit() noexcept {
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+  }
+
+  void add_packets_received(uint64_t n) noexcept { add(packets_received_, n); }
+  void add_packets_dropped(uint64_t n) noexcept { add(packets_dropped_, n); }
+  void add_messages_parsed(uint64_t n) noexcept { add(messages_parsed_, n); }
+  void add_messages_dispatched(uint64_t n) noexcept {
+    add(messages_dispatched_, n);
+  }
+  void add_parse_errors(uint64_t n) noexcept { add(parse_errors_, n); }
+
+  void record_latency(uint64_t latency_ns) noexcept {
+    lower(min_latency_ns_, latency_ns);
+    raise(max_latency_ns_, latency_ns);
+    add(total_latency_ns_, latency_ns);
+  }
+
+  void record_kernel_latency(uint64_t latency_ns) noexcept {
+    lower(min_kernel_latency_ns_, latency_ns);
+    raise(max_kernel_latency_ns_, latency_ns);
+    add(total_kernel_latency_ns_, latency_ns);
+    add(kernel_latency_samples_, 1);
+  }
+
+  // Copy the counters (any thread)
+  // Retries while the writer is inside a begin()/commit() group
+  Statistics snapshot() const noexcept {
+    Statistics stats;
+    for (;;) {
+      const uint64_t before = sequence_.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue; // Update in progress
+      }
+
+      stats.packets_received = load(packets_received_);
+      stats.packets_dropped = load(packets_dropped_);
+      stats.messages_parsed = load(messages_parsed_);
+      stats.messages_dispatched = load(messages_dispatched_);
+      stats.parse_errors = load(parse_errors_);
+      stats.min_latency_ns = load(min_latency_ns_);
+      stats.max_latency_ns = load(max_latency_ns_);
+      stats.total_latency_ns = load(total_latency_ns_);
+      stats.kernel_latency_samples = load(kernel_latency_samples_);
+      stats.min_kernel_latency_ns = load(min_kernel_latency_ns_);
+      stats.max_kernel_latency_ns = load(max_kernel_latency_ns_);
+      stats.total_kernel_latency_ns = load(total_kernel_latency_ns_);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == before) {
+        return stats;
+      }
+    }
+  }
+
+  // Zero all counters (writer side, or while the writer is stopped)
+  void reset() noexcept {
+    begin();
+    const Statistics zero;
+    packets_received_.store(zero.packets_received, std::memory_order_relaxed);
+    packets_dropped_.store(zero.packets_dropped, std::memory_order_relaxed);
+    messages_parsed_.store(zero.messages_parsed, std::memory_order_relaxed);
+    messages_dispatched_.store(zero.messages_dispatched,
+                               std::memory_order_relaxed);
+    parse_errors_.store(zero.parse_errors, std::memory_order_relaxed);
+    min_latency_ns_.store(zero.min_latency_ns, std::memory_order_relaxed);
+    max_latency_ns_.store(zero.max_latency_ns, std::memory_order_relaxed);
+    total_latency_ns_.store(zero.total_latency_ns, std::memory_order_relaxed);
+    kernel_latency_samples_.store(zero.kernel_latency_samples,
+                                  std::memory_order_relaxed);
+    min_kernel_latency_ns_.store(zero.min_kernel_latency_ns,
+                                 std::memory_order_relaxed);
+    max_kernel_latency_ns_.store(zero.max_kernel_latency_ns,
+                                 std::memory_order_relaxed);
+    total_kernel_latency_ns_.store(zero.total_kernel_latency_ns,
+                                   std::memory_order_relaxed);
+    commit();
+  }
+
+private:
+  using Counter = std::atomic<uint64_t>;
+
+  // Single writer - a plain load and store instead of fetch_add
+  static void add(Counter &counter, uint64_t n) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  static void lower(Counter &counter, uint64_t value) noexcept {
+    if (value < counter.load(std::memory_order_relaxed)) {
+      counter.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  static void raise(Counter &counter, uint64_t value) noexcept {
+    if (value > counter.load(std::memory_order_relaxed)) {
+      counter.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  static uint64_t load(const Counter &counter) noexcept {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> sequence_{0}; // Odd while an update is in progress
+  Counter packets_received_;
+  Counter packets_dropped_;
+  Counter messages_parsed_;
+  Counter messages_dispatched_;
+  Counter parse_errors_;
+  Counter min_latency_ns_;
+  Counter max_latency_ns_;
+  Counter total_latency_ns_;
+  Counter kernel_latency_samples_;
+  Counter min_kernel_latency_ns_;
+  Counter max_kernel_latency_ns_;
+  Counter total_kernel_latency_ns_;
+};
+
+} // namespace core
+} // namespace hft
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "../types.hpp"
+#include "histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hft {
+namespace core {
+
+// Percentiles of one latency histogram
+struct LatencySummary {
+  uint64_t count{0};
+  uint64_t min_ns{0};
+  uint64_t p50_ns{0};
+  uint64_t p90_ns{0};
+  uint64_t p99_ns{0};
+  uint64_t p999_ns{0};
+  uint64_t p9999_ns{0};
+  uint64_t max_ns{0};
+
+  static LatencySummary of(const LatencyHistogram &histogram) noexcept {
+    LatencySummary summary;
+    summary.count = histogram.count();
+    if (summary.count == 0) {
+      return summary;
+    }
+    summary.min_ns = histogram.min();
+    summary.p50_ns = histogram.percentile(50.0);
+    summary.p90_ns = histogram.percentile(90.0);
+    summary.p99_ns = histogram.percentile(99.0);
+    summary.p999_ns = histogram.percentile(99.9);
+    summary.p9999_ns = histogram.percentile(99.99);
+    summary.max_ns = histogram.max();
+    return summary;
+  }
+};
+
+// One subscriber's row on the stats page
+struct StatsPageSubscriber {
+  uint64_t id{0};
+  char name[32]{};
+  uint64_t delivered{0};
+  uint64_t dropped{0};
+  uint64_t conflated{0};
+  uint64_t queue_depth{0}; // Messages waiting to be delivered
+  LatencySummary latency;  // Receive -> hand-off, queued subscribers only
+  uint8_t inline_dispatch{0};
+};
+
+// Everything published on the stats page, as one consistent snapshot
+struct StatsPage {
+  uint64_t pid{0};      // Publishing process
+  uint64_t updates{0};  // Publish count, bumped by every publish()
+  Timestamp updated{0}; // get_timestamp() at the snapshot
+  Statistics engine;
+  LatencySummary stages[LATENCY_STAGE_COUNT]; // Indexed by LatencyStage
+  std::vector<StatsPageSubscriber> subscribers;
+};
+
+// Shared-memory layout: a header followed by max_subscribers rows. The
+// writer brackets every update with an odd/even sequence, like StatsBlock,
+// so readers in other processes copy it out without locks
+struct StatsPageLayout {
+  static constexpr char MAGIC[8] = {'H', 'F', 'T', 'S', 'T', 'A', 'T', 'S'};
+  static constexpr uint32_t VERSION = 1;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t max_subscribers;
+    std::atomic<uint64_t> sequence; // Odd while an update is in progress
+    uint64_t pid;
+    uint64_t updates;
+    Timestamp updated;
+    uint32_t subscriber_count;
+    uint32_t reserved;
+    Statistics engine;
+    LatencySummary stages[LATENCY_STAGE_COUNT];
+  };
+
+  static size_t size(uint32_t max_subscribers) noexcept {
+    return sizeof(Header) + max_subscribers * sizeof(StatsPageSubscriber);
+  }
+
+  static StatsPageSubscriber *rows(Header *header) noexcept {
+    return reinterpret_cast<StatsPageSubscriber *>(header + 1);
+  }
+
+  static const StatsPageSubscriber *rows(const Header *header) noexcept {
+    return reinterpret_cast<const StatsPageSubscriber *>(header + 1);
+  }
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Stats page sequence must be usable across processes");
+
+// Owns a named POSIX shared-memory stats page and publishes into it
+// Publish from a housekeeping thread, never from the hot path
+class StatsPageWriter {
+public:
+  static constexpr uint32_t MAX_SUBSCRIBERS = 64;
+
+  StatsPageWriter() = default;
+  ~StatsPageWriter() { close(); }
+
+  StatsPageWriter(const StatsPageWriter &) = delete;
+  StatsPageWriter &operator=(const StatsPageWriter &) = delete;
+
+  // Create (or replace) the page, e.g. "/hft-stats"
+  // Returns false if the shared memory cannot be set up
+  bool create(const std::string &name,
+              uint32_t max_subscribers = MAX_SUBSCRIBERS) {
+    close();
+
+    const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) {
+      return false;
+    }
+    const size_t size = StatsPageLayout::size(max_subscribers);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      ::close(fd);
+      shm_unlink(name.c_str());
+      return false;
+    }
+    void *memory =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+      shm_unlink(name.c_str());
+      return false;
+    }
+
+    header_ = new (memory) StatsPageLayout::Header{};
+    header_->version = StatsPageLayout::VERSION;
+    header_->max_subscribers = max_subscribers;
+    header_->pid = static_cast<uint64_t>(getpid());
+    header_->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header_->magic, StatsPageLayout::MAGIC,
+                sizeof(StatsPageLayout::MAGIC)); // Ready for readers
+
+    name_ = name;
+    size_ = size;
+    return true;
+  }
+
+  // Publish a snapshot; subscribers beyond max_subscribers are left out
+  void publish(const StatsPage &page) noexcept {
+    if (header_ == nullptr) {
+      return;
+    }
+    const uint32_t count = static_cast<uint32_t>(
+        std::min<size_t>(page.subscribers.size(), header_->max_subscribers));
+
+    header_->sequence.store(
+        header_->sequence.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    header_->updates++;
+    header_->updated = page.updated;
+    header_->subscriber_count = count;
+    header_->engine = page.engine;
+    std::memcpy(header_->stages, page.stages, sizeof(header_->stages));
+    std::memcpy(static_cast<void *>(StatsPageLayout::rows(header_)),
+                page.subscribers.data(), count * sizeof(StatsPageSubscriber));
+
+    header_->sequence.store(
+        header_->sequence.load(std::memory_order_relaxed) + 1,
+        std::memory_order_release);
+  }
+
+  // Unmap and remove the page
+  void close() noexcept {
+    if (header_ == nullptr) {
+      return;
+    }
+    munmap(header_, size_);
+    shm_unlink(name_.c_str());
+    header_ = nullptr;
+    size_ = 0;
+  }
+
+  bool is_open() const noexcept { return header_ != nullptr; }
+  const std::string &name() const noexcept { return name_; }
+
+private:
+  StatsPageLayout::Header *header_{nullptr};
+  size_t size_{0};
+  std::string name_;
+};
+
+// Read-only view of a stats page published by another process
+class StatsPageReader {
+public:
+  StatsPageReader() = default;
+  ~StatsPageReader() { detach(); }
+
+  StatsPageReader(const StatsPageReader &) = delete;
+  StatsPageReader &operator=(const StatsPageReader &) = delete;
+
+  // Map an existing page read-only. Returns false if it does not exist or
+  // is not a stats page of this version
+  bool attach(const std::string &name) {
+    detach();
+
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 ||
+        static_cast<size_t>(info.st_size) < sizeof(StatsPageLayout::Header)) {
+      ::close(fd);
+      return false;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void *memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+      return false;
+    }
+
+    const auto *header = static_cast<const StatsPageLayout::Header *>(memory);
+    if (std::memcmp(header->magic, StatsPageLayout::MAGIC,
+                    sizeof(StatsPageLayout::MAGIC)) != 0 ||
+        header->version != StatsPageLayout::VERSION ||
+        size < StatsPageLayout::size(header->max_subscribers)) {
+      munmap(memory, size);
+      return false;
+    }
+
+    header_ = header;
+    size_ = size;
+    return true;
+  }
+
+  void detach() noexcept {
+    if (header_ != nullptr) {
+      munmap(const_cast<StatsPageLayout::Header *>(header_), size_);
+      header_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  bool is_attached() const noexcept { return header_ != nullptr; }
+
+  // Copy out a consistent snapshot. Returns false if not attached or the
+  // writer kept it busy for too long
+  bool read(StatsPage &out) const {
+    if (header_ == nullptr) {
+      return false;
+    }
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+      const uint64_t before = header_->sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        std::this_thread::yield(); // Update in progress
+        continue;
+      }
+
+      out.pid = header_->pid;
+      out.updates = header_->updates;
+      out.updated = header_->updated;
+      out.engine = header_->engine;
+      std::memcpy(out.stages, header_->stages, sizeof(out.stages));
+      const uint32_t count = std::min(header_->subscriber_count,
+                                      header_->max_subscribers);
+      out.subscribers.resize(count);
+      std::memcpy(static_cast<void *>(out.subscribers.data()),
+                  StatsPageLayout::rows(header_),
+                  count * sizeof(StatsPageSubscriber));
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (header_->sequence.load(std::memory_order_relaxed) == before) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  const StatsPageLayout::Header *header_{nullptr};
+  size_t size_{0};
+};
+
+} // namespace core
+} // namespace hft
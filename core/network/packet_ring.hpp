@@ -0,0 +1,239 @@
+#pragma once
+
+#include "../types.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+namespace hft {
+namespace core {
+
+// Record header stored in front of every packet in a PacketRing
+struct PacketHeader {
+  uint32_t length;            // Payload length in bytes
+  uint32_t record_size;       // Header + payload, rounded up to a cache line
+  Timestamp timestamp;        // Userspace receive time
+  Timestamp kernel_timestamp; // Kernel RX time, wall clock (0 = unavailable)
+  uint64_t reserved;          // Keeps the payload 32-byte aligned
+};
+
+// Single Producer Single Consumer byte ring for variable-length packets
+// Packets are stored back to back as [PacketHeader][payload], each record
+// rounded up to a cache line, so a burst of small datagrams occupies a few
+// KB instead of one jumbo-sized slot each. A record never straddles the end
+// of the buffer: when the tail end is too short the producer fills it with a
+// padding record and continues at offset 0.
+template <size_t Capacity = config::PACKET_RING_BYTES> class PacketRing {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "Capacity must be power of 2");
+  static_assert(Capacity >= 4 * config::MAX_PACKET_SIZE,
+                "Capacity must hold several maximum-size packets");
+
+  static constexpr size_t MASK = Capacity - 1;
+  static constexpr uint32_t PADDING = UINT32_MAX; // Length marker for wrap
+
+public:
+  // Bytes occupied by a record carrying 'length' payload bytes
+  static constexpr size_t record_size(size_t length) noexcept {
+    return (sizeof(PacketHeader) + length + config::CACHELINE_SIZE - 1) &
+           ~(config::CACHELINE_SIZE - 1);
+  }
+
+  PacketRing() : head_(0), tail_(0) {
+    buffer_ = std::make_unique<Block[]>(Capacity / sizeof(Block));
+  }
+
+  // Claim space for one packet of up to max_length bytes (producer side)
+  // Returns the payload pointer to write into, or nullptr if the ring is full
+  uint8_t *claim(size_t max_length) noexcept {
+    uint8_t *payload = nullptr;
+    return claim_batch(1, max_length, &payload) == 1 ? payload : nullptr;
+  }
+
+  // Claim up to 'count' packets of up to max_length bytes each, laid out at
+  // a fixed stride in contiguous memory (e.g. as recvmmsg iovecs)
+  // Returns the number of payload pointers written to 'payloads'
+  size_t claim_batch(size_t count, size_t max_length,
+                     uint8_t **payloads) noexcept {
+    const size_t stride = record_size(max_length);
+    const size_t head = head_.load(std::memory_order_relaxed);
+
+    // Skip to the start of the buffer if the first record would not fit
+    size_t start = head;
+    const size_t contiguous = Capacity - (head & MASK);
+    if (contiguous < stride) {
+      start += contiguous;
+    }
+
+    if (start + stride - cached_tail_ > Capacity) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (start + stride - cached_tail_ > Capacity) {
+        return 0; // Ring is full
+      }
+    }
+
+    const size_t room = std::min(Capacity - (start & MASK),
+                                 Capacity - (start - cached_tail_));
+    const size_t claimed = std::min(count, room / stride);
+
+    if (start != head) {
+      PacketHeader *padding = header_at(head);
+      padding->length = PADDING;
+      padding->record_size = static_cast<uint32_t>(contiguous);
+    }
+
+    for (size_t i = 0; i < claimed; ++i) {
+      payloads[i] = payload_at(start + i * stride);
+    }
+
+    claim_start_ = start;
+    claim_stride_ = stride;
+    claim_index_ = 0;
+    write_pos_ = start;
+    return claimed;
+  }
+
+  // Finalize the next claimed packet, in claim order (producer side)
+  // Records are compacted so they sit back to back regardless of stride
+  void commit(uint32_t length, Timestamp timestamp,
+              Timestamp kernel_timestamp = 0) noexcept {
+    const size_t claimed_at = claim_start_ + claim_index_ * claim_stride_;
+    if (claimed_at != write_pos_ && length > 0) {
+      std::memmove(payload_at(write_pos_), payload_at(claimed_at), length);
+    }
+
+    PacketHeader *header = header_at(write_pos_);
+    header->length = length;
+    header->record_size = static_cast<uint32_t>(record_size(length));
+    header->timestamp = timestamp;
+    header->kernel_timestamp = kernel_timestamp;
+
+    write_pos_ += header->record_size;
+    claim_index_++;
+  }
+
+  // Make all committed packets visible to the consumer (producer side)
+  void publish() noexcept {
+    if (claim_index_ > 0) {
+      head_.store(write_pos_, std::memory_order_release);
+      claim_index_ = 0;
+    }
+  }
+
+  // Copy a packet in: claim + commit + publish (producer side)
+  bool push(const uint8_t *data, uint32_t length, Timestamp timestamp,
+            Timestamp kernel_timestamp = 0) noexcept {
+    uint8_t *payload = claim(length);
+    if (payload == nullptr) {
+      return false;
+    }
+    std::memcpy(payload, data, length);
+    commit(length, timestamp, kernel_timestamp);
+    publish();
+    return true;
+  }
+
+  // Peek at the next packet in place (consumer side)
+  // Returns nullptr if empty. The record, and its payload(), stay valid and
+  // unmodified until release() - the producer cannot reuse the space
+  const PacketHeader *front() noexcept { return next_record(); }
+
+  // Release the packet returned by front() back to the producer
+  void release() noexcept {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    tail_.store(tail + header_at(tail)->record_size,
+                std::memory_order_release);
+  }
+
+  // Payload bytes of a record returned by front()
+  static const uint8_t *payload(const PacketHeader *header) noexcept {
+    return reinterpret_cast<const uint8_t *>(header + 1);
+  }
+
+  // Copy the next packet out (consumer side)
+  // 'data' must hold at least config::MAX_PACKET_SIZE bytes
+  bool pop(uint8_t *data, PacketHeader &header) noexcept {
+    const PacketHeader *next = front();
+    if (next == nullptr) {
+      return false;
+    }
+
+    header = *next;
+    std::memcpy(data, payload(next), next->length);
+    release();
+    return true;
+  }
+
+  // Check if ring is empty
+  bool empty() const noexcept {
+    return tail_.load(std::memory_order_acquire) ==
+           head_.load(std::memory_order_acquire);
+  }
+
+  // Bytes currently occupied (may be stale)
+  size_t used_bytes() const noexcept {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  // Get capacity in bytes
+  constexpr size_t capacity() const noexcept { return Capacity; }
+
+private:
+  struct alignas(config::CACHELINE_SIZE) Block {
+    uint8_t bytes[config::CACHELINE_SIZE];
+  };
+
+  uint8_t *base() const noexcept {
+    return reinterpret_cast<uint8_t *>(buffer_.get());
+  }
+
+  PacketHeader *header_at(size_t offset) const noexcept {
+    return reinterpret_cast<PacketHeader *>(base() + (offset & MASK));
+  }
+
+  uint8_t *payload_at(size_t offset) const noexcept {
+    return base() + (offset & MASK) + sizeof(PacketHeader);
+  }
+
+  // Locate the next packet record, consuming wrap padding on the way
+  const PacketHeader *next_record() noexcept {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+
+    for (;;) {
+      if (tail == cached_head_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail == cached_head_) {
+          return nullptr; // Ring is empty
+        }
+      }
+
+      const PacketHeader *header = header_at(tail);
+      if (header->length != PADDING) {
+        return header;
+      }
+
+      tail += header->record_size;
+      tail_.store(tail, std::memory_order_release);
+    }
+  }
+
+  // Producer index and producer-private state
+  alignas(config::CACHELINE_SIZE) std::atomic<size_t> head_;
+  size_t cached_tail_{0};
+  size_t claim_start_{0};
+  size_t claim_stride_{0};
+  size_t claim_index_{0};
+  size_t write_pos_{0};
+
+  // Consumer index and consumer-private state
+  alignas(config::CACHELINE_SIZE) std::atomic<size_t> tail_;
+  size_t cached_head_{0};
+
+  // Packet storage
+  std::unique_ptr<Block[]> buffer_;
+};
+
+} // namespace core
+} // namespace hft
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../types.hpp"
+#include <vector>
+
+namespace hft {
+namespace core {
+
+// Packet source that replays captured datagrams from memory
+// Same peek/release interface as UDPReceiver, so engines, tests and
+// benchmarks can run identical input without a network.
+class ReplaySource {
+public:
+  // loops = how many times the packet list is replayed (0 = forever)
+  explicit ReplaySource(size_t loops = 1)
+      : loops_(loops), loop_(0), index_(0), sequence_(0) {}
+
+  // Append a packet (copied)
+  void add_packet(const uint8_t *data, size_t length) {
+    packets_.emplace_back(data, data + length);
+  }
+
+  void add_packet(const std::vector<uint8_t> &packet) {
+    packets_.push_back(packet);
+  }
+
+  // Peek at the next packet; it stays valid until release_packet()
+  bool peek_packet(MessageView &view) noexcept {
+    if (packets_.empty() || (loops_ != 0 && loop_ >= loops_)) {
+      return false;
+    }
+    const std::vector<uint8_t> &packet = packets_[index_];
+    view = MessageView(packet.data(), static_cast<uint32_t>(packet.size()),
+                       get_timestamp(), sequence_);
+    return true;
+  }
+
+  // Advance past the packet returned by peek_packet()
+  void release_packet() noexcept {
+    sequence_++;
+    if (++index_ == packets_.size()) {
+      index_ = 0;
+      loop_++;
+    }
+  }
+
+  // Start over from the first packet
+  void rewind() noexcept {
+    loop_ = 0;
+    index_ = 0;
+    sequence_ = 0;
+  }
+
+  // Check if packets remain to be replayed
+  bool has_packets() const noexcept {
+    return !packets_.empty() && (loops_ == 0 || loop_ < loops_);
+  }
+
+  size_t packet_count() const noexcept { return packets_.size(); }
+
+private:
+  std::vector<std::vector<uint8_t>> packets_;
+  size_t loops_;
+  size_t loop_;
+  size_t index_;
+  uint32_t sequence_;
+};
+
+} // namespace core
+} // namespace hft
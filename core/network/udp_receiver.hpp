@@ -1,11 +1,14 @@
 #pragma once
 
-#include "../distribution/lockfree_queue.hpp"
+#include "../metrics/stats_block.hpp"
 #include "../types.hpp"
+#include "packet_ring.hpp"
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <string>
 #include <thread>
+#include <vector>
 
 
 #ifdef _WIN32
@@ -16,6 +19,15 @@
 #define SO_REUSEADDR 2
 #define SO_RCVBUF 8
 #define SO_TIMESTAMP 29
+#define SO_TIMESTAMPNS 35
+#define SO_TIMESTAMPING 37
+#define SCM_TIMESTAMP SO_TIMESTAMP
+#define SCM_TIMESTAMPNS SO_TIMESTAMPNS
+#define SCM_TIMESTAMPING SO_TIMESTAMPING
+#define SOF_TIMESTAMPING_RX_SOFTWARE (1 << 3)
+#define SOF_TIMESTAMPING_SOFTWARE (1 << 4)
+#define SO_RCVTIMEO 20
+#define MSG_WAITFORONE 0x10000
 #define IPPROTO_IP 0
 #define IP_ADD_MEMBERSHIP 35
 #define INADDR_ANY 0
@@ -36,6 +48,40 @@ struct ip_mreq {
   struct in_addr imr_multiaddr;
   struct in_addr imr_interface;
 };
+struct timeval {
+  long tv_sec;
+  long tv_usec;
+};
+struct iovec {
+  void *iov_base;
+  size_t iov_len;
+};
+struct msghdr {
+  void *msg_name;
+  unsigned msg_namelen;
+  struct iovec *msg_iov;
+  size_t msg_iovlen;
+  void *msg_control;
+  size_t msg_controllen;
+  int msg_flags;
+};
+struct mmsghdr {
+  struct msghdr msg_hdr;
+  unsigned int msg_len;
+};
+struct timespec {
+  long tv_sec;
+  long tv_nsec;
+};
+struct cmsghdr {
+  size_t cmsg_len;
+  int cmsg_level;
+  int cmsg_type;
+};
+#define CMSG_SPACE(len) (sizeof(struct cmsghdr) + (len))
+#define CMSG_FIRSTHDR(m) ((struct cmsghdr *)nullptr)
+#define CMSG_NXTHDR(m, c) ((struct cmsghdr *)nullptr)
+#define CMSG_DATA(c) ((unsigned char *)((c) + 1))
 using ssize_t = intptr_t;
 inline int socket(int, int, int) { return -1; }
 inline int setsockopt(int, int, int, const void *, size_t) { return -1; }
@@ -44,6 +90,8 @@ inline int close(int) { return -1; }
 inline int inet_pton(int, const char *, void *) { return -1; }
 inline uint16_t htons(uint16_t x) { return x; }
 inline ssize_t recvfrom(int, void *, size_t, int, void *, void *) { return -1; }
+inline ssize_t recvmsg(int, struct msghdr *, int) { return -1; }
+inline int recvmmsg(int, struct mmsghdr *, unsigned, int, void *) { return -1; }
 struct cpu_set_t {
   unsigned long __bits[16];
 };
@@ -53,8 +101,10 @@ inline int pthread_setaffinity_np(void *, size_t, cpu_set_t *) { return -1; }
 #else
 // POSIX networking headers (Linux/WSL)
 #include <arpa/inet.h>
+#include <linux/net_tstamp.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <unistd.h>
 
 #endif
@@ -62,13 +112,12 @@ inline int pthread_setaffinity_np(void *, size_t, cpu_set_t *) { return -1; }
 namespace hft {
 namespace core {
 
-// Packet data structure for queue storage
-struct alignas(config::CACHELINE_SIZE) Packet {
-  alignas(16) uint8_t data[config::MAX_PACKET_SIZE];
-  uint32_t length;
-  Timestamp timestamp;
-
-  Packet() noexcept : length(0), timestamp(0) {}
+// Kernel timestamp source negotiated at initialize()
+enum class KernelTimestampMode : uint8_t {
+  NONE = 0,
+  TIMESTAMP = 1,   // SO_TIMESTAMP (timeval, microseconds)
+  TIMESTAMPNS = 2, // SO_TIMESTAMPNS (timespec)
+  TIMESTAMPING = 3 // SO_TIMESTAMPING software RX stamp (timespec)
 };
 
 // UDP receiver configuration
@@ -78,11 +127,12 @@ struct UDPConfig {
   uint16_t port{10000};
   size_t buffer_size{config::MAX_PACKET_SIZE * 1024};
   bool enable_timestamps{true};
+  size_t recv_batch_size{1}; // Datagrams per recvmmsg call (1 = recvfrom)
 
   UDPConfig() = default;
 };
 
-// UDP receiver - captures market data packets using lock-free queue
+// UDP receiver - captures market data packets into a lock-free byte ring
 class UDPReceiver {
 public:
   explicit UDPReceiver(const UDPConfig &config = UDPConfig{})
@@ -106,12 +156,17 @@ public:
     int bufsize = static_cast<int>(config_.buffer_size);
     setsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
 
-    // Enable timestamps if requested
+    // Enable kernel receive timestamps if requested, preferring the most
+    // precise interface the kernel accepts
     if (config_.enable_timestamps) {
-      int enable = 1;
-      setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMP, &enable, sizeof(enable));
+      enable_kernel_timestamps();
     }
 
+    // Bound blocking receives so stop() can join an idle receive thread
+    struct timeval timeout{};
+    timeout.tv_usec = config::RECV_TIMEOUT_US;
+    setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
     // Bind to port
     struct sockaddr_in addr{};
     addr.sin_family = AF_INET;
@@ -146,7 +201,11 @@ public:
       return;
 
     running_.store(true);
-    receive_thread_ = std::thread(&UDPReceiver::receive_loop, this);
+    if (config_.recv_batch_size > 1) {
+      receive_thread_ = std::thread(&UDPReceiver::receive_loop_batched, this);
+    } else {
+      receive_thread_ = std::thread(&UDPReceiver::receive_loop, this);
+    }
 
     // Set CPU affinity
     if (cpu_affinity >= 0) {
@@ -174,44 +233,232 @@ public:
     }
   }
 
-  // Read next packet from queue into a MessageView
-  // Note: The view is valid until the next call to read_packet
-  bool read_packet(MessageView &view) noexcept {
-    if (!packet_queue_.pop(current_packet_)) {
+  // Peek at the next packet in place - the view points into the ring
+  // Note: The view is valid until release_packet(), which must be called
+  // once for every successful peek before peeking again
+  bool peek_packet(MessageView &view) noexcept {
+    const PacketHeader *header = packet_ring_.front();
+    if (header == nullptr) {
       return false;
     }
 
-    view.data = current_packet_.data;
-    view.length = current_packet_.length;
-    view.timestamp = current_packet_.timestamp;
-    view.sequence = sequence_++;
+    view.data = PacketRing<config::PACKET_RING_BYTES>::payload(header);
+    view.length = header->length;
+    view.timestamp = header->timestamp;
+    view.kernel_timestamp = header->kernel_timestamp;
+    view.sequence = sequence_;
 
     return true;
   }
 
+  // Hand the peeked packet's ring space back to the receive thread
+  void release_packet() noexcept {
+    packet_ring_.release();
+    sequence_++;
+  }
+
+  // Read next packet into a MessageView (zero-copy)
+  // Note: The view is valid until the next call to read_packet, which
+  // releases it. Do not mix with peek_packet/release_packet
+  bool read_packet(MessageView &view) noexcept {
+    if (holding_packet_) {
+      release_packet();
+      holding_packet_ = false;
+    }
+
+    holding_packet_ = peek_packet(view);
+    return holding_packet_;
+  }
+
   // Check if packets are available
-  bool has_packets() const noexcept { return !packet_queue_.empty(); }
+  bool has_packets() const noexcept { return !packet_ring_.empty(); }
+
+  // Get a statistics snapshot (any thread)
+  Statistics get_stats() const noexcept { return stats_.snapshot(); }
 
-  // Get statistics
-  const Statistics &get_stats() const noexcept { return stats_; }
+  // Kernel timestamp source in use (NONE until initialize() succeeds)
+  KernelTimestampMode timestamp_mode() const noexcept {
+    return timestamp_mode_;
+  }
 
 private:
+  // Control buffer large enough for any of the timestamp cmsgs
+  struct alignas(struct cmsghdr) ControlBuffer {
+    uint8_t data[CMSG_SPACE(3 * sizeof(struct timespec))];
+  };
+
+  void enable_kernel_timestamps() noexcept {
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMPING, &flags,
+                   sizeof(flags)) == 0) {
+      timestamp_mode_ = KernelTimestampMode::TIMESTAMPING;
+      return;
+    }
+
+    int enable = 1;
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable,
+                   sizeof(enable)) == 0) {
+      timestamp_mode_ = KernelTimestampMode::TIMESTAMPNS;
+      return;
+    }
+
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMP, &enable,
+                   sizeof(enable)) == 0) {
+      timestamp_mode_ = KernelTimestampMode::TIMESTAMP;
+    }
+  }
+
+  // Extract the kernel RX timestamp from a received message's control data
+  // Returns nanoseconds on the wall clock, or 0 if none was attached
+  static Timestamp read_kernel_timestamp(struct msghdr &msg) noexcept {
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level != SOL_SOCKET) {
+        continue;
+      }
+
+      if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+        // ts[0] = software, ts[2] = raw hardware (not requested)
+        struct timespec ts[3];
+        std::memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+        return static_cast<Timestamp>(ts[0].tv_sec) * 1000000000ULL +
+               static_cast<Timestamp>(ts[0].tv_nsec);
+      }
+
+      if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+        struct timespec ts;
+        std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        return static_cast<Timestamp>(ts.tv_sec) * 1000000000ULL +
+               static_cast<Timestamp>(ts.tv_nsec);
+      }
+
+      if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+        struct timeval tv;
+        std::memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+        return static_cast<Timestamp>(tv.tv_sec) * 1000000000ULL +
+               static_cast<Timestamp>(tv.tv_usec) * 1000ULL;
+      }
+    }
+
+    return 0;
+  }
+
+  // Read the kernel timestamp and account kernel->userspace latency
+  Timestamp kernel_timestamp(struct msghdr &msg, Timestamp wall_now) noexcept {
+    const Timestamp kernel_ts = read_kernel_timestamp(msg);
+
+    if (kernel_ts != 0 && wall_now >= kernel_ts) {
+      stats_.record_kernel_latency(wall_now - kernel_ts);
+    }
+    return kernel_ts;
+  }
+
+  // Drain one datagram into scratch space when the ring has no room
+  void discard_packet(uint8_t *scratch) noexcept {
+    if (recvfrom(socket_fd_, scratch, config::MAX_PACKET_SIZE, 0, nullptr,
+                 nullptr) > 0) {
+      stats_.add_packets_dropped(1);
+    }
+  }
+
   void receive_loop() {
-    Packet packet;
+    std::vector<uint8_t> scratch(config::MAX_PACKET_SIZE);
+    ControlBuffer control;
+
+    struct iovec iov{};
+    iov.iov_len = config::MAX_PACKET_SIZE;
+
+    struct msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    const bool kernel_ts = timestamp_mode_ != KernelTimestampMode::NONE;
 
     while (running_.load(std::memory_order_relaxed)) {
-      ssize_t received = recvfrom(socket_fd_, packet.data,
-                                  config::MAX_PACKET_SIZE, 0, nullptr, nullptr);
+      // Receive straight into ring memory
+      iov.iov_base = packet_ring_.claim(config::MAX_PACKET_SIZE);
+      if (iov.iov_base == nullptr) {
+        discard_packet(scratch.data());
+        continue;
+      }
+
+      // Kernel rewrites msg_controllen on every call
+      msg.msg_control = kernel_ts ? control.data : nullptr;
+      msg.msg_controllen = kernel_ts ? sizeof(control.data) : 0;
+
+      ssize_t received = recvmsg(socket_fd_, &msg, 0);
 
       if (received > 0) {
-        packet.length = static_cast<uint32_t>(received);
-        packet.timestamp = get_timestamp();
+        const Timestamp now = get_timestamp();
+        stats_.begin();
+        const Timestamp kts =
+            kernel_ts ? kernel_timestamp(msg, get_wall_timestamp()) : 0;
+
+        packet_ring_.commit(static_cast<uint32_t>(received), now, kts);
+        packet_ring_.publish();
+        stats_.add_packets_received(1);
+        stats_.commit();
+      }
+    }
+  }
+
+  // Batched receive - one recvmmsg call drains up to recv_batch_size
+  // datagrams straight into consecutive ring records, amortizing the
+  // syscall across a burst
+  void receive_loop_batched() {
+    const size_t batch =
+        std::min(config_.recv_batch_size, config::MAX_RECV_BATCH);
+
+    std::vector<uint8_t> scratch(config::MAX_PACKET_SIZE);
+    std::vector<uint8_t *> payloads(batch);
+    std::vector<ControlBuffer> controls(batch);
+    std::vector<struct iovec> iovecs(batch);
+    std::vector<struct mmsghdr> msgs(batch);
+
+    const bool kernel_ts = timestamp_mode_ != KernelTimestampMode::NONE;
+
+    for (size_t i = 0; i < batch; ++i) {
+      iovecs[i].iov_len = config::MAX_PACKET_SIZE;
+      msgs[i].msg_hdr.msg_iov = &iovecs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (running_.load(std::memory_order_relaxed)) {
+      const size_t claimed = packet_ring_.claim_batch(
+          batch, config::MAX_PACKET_SIZE, payloads.data());
+      if (claimed == 0) {
+        discard_packet(scratch.data());
+        continue;
+      }
 
-        if (packet_queue_.push(packet)) {
-          stats_.packets_received++;
-        } else {
-          stats_.packets_dropped++;
+      for (size_t i = 0; i < claimed; ++i) {
+        iovecs[i].iov_base = payloads[i];
+        msgs[i].msg_hdr.msg_control = kernel_ts ? controls[i].data : nullptr;
+        msgs[i].msg_hdr.msg_controllen =
+            kernel_ts ? sizeof(controls[i].data) : 0;
+      }
+
+      // MSG_WAITFORONE: block for the first datagram, then take whatever
+      // else is already queued without waiting
+      int received = recvmmsg(socket_fd_, msgs.data(),
+                              static_cast<unsigned>(claimed), MSG_WAITFORONE,
+                              nullptr);
+
+      if (received > 0) {
+        const Timestamp now = get_timestamp();
+        const Timestamp wall_now = kernel_ts ? get_wall_timestamp() : 0;
+        stats_.begin();
+
+        // Records are compacted as they are committed, so only the bytes
+        // actually received stay in the ring
+        for (int i = 0; i < received; ++i) {
+          const Timestamp kts =
+              kernel_ts ? kernel_timestamp(msgs[i].msg_hdr, wall_now) : 0;
+          packet_ring_.commit(msgs[i].msg_len, now, kts);
         }
+        packet_ring_.publish();
+        stats_.add_packets_received(static_cast<uint64_t>(received));
+        stats_.commit();
       }
     }
   }
@@ -219,11 +466,12 @@ private:
   UDPConfig config_;
   std::atomic<bool> running_;
   int socket_fd_;
-  SPSCQueue<Packet, config::PACKET_RING_SIZE> packet_queue_;
-  Packet current_packet_; // Holds the last popped packet
+  KernelTimestampMode timestamp_mode_{KernelTimestampMode::NONE};
+  PacketRing<config::PACKET_RING_BYTES> packet_ring_;
+  bool holding_packet_{false}; // read_packet() owes a release
   uint32_t sequence_{0};  // Running sequence number
   std::thread receive_thread_;
-  Statistics stats_;
+  StatsBlock stats_; // Written by the receive thread
 };
 
 } // namespace core
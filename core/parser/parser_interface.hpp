@@ -30,6 +30,19 @@ public:
 
   // Optional: Get parser statistics
   virtual void get_stats(Statistics &stats) const { (void)stats; }
+
+  // Optional: True if order events carry the order's state and replaces
+  // arrive as a delete and an add, as order books need
+  virtual bool order_tracking() const noexcept { return false; }
+
+  // Optional: Resolve a ticker symbol to the instrument_id the parser emits
+  // Not thread-safe against parse() - call before the engine starts
+  virtual bool find_instrument(const char *symbol,
+                               uint64_t &instrument_id) const {
+    (void)symbol;
+    (void)instrument_id;
+    return false;
+  }
 };
 
 // Null parser - passes through without parsing (for testing)
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "metrics/stats_block.hpp"
+#include "types.hpp"
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace hft {
+namespace core {
+
+// Anything that hands out packets in place: UDPReceiver, ReplaySource
+template <typename T>
+concept PacketSource = requires(T source, MessageView &view) {
+  { source.peek_packet(view) } -> std::convertible_to<bool>;
+  source.release_packet();
+};
+
+// Anything that turns a packet into normalized messages
+template <typename T>
+concept MessageParser = requires(T parser, const MessageView &packet,
+                                 NormalizedMessage *output, size_t max) {
+  { parser.parse(packet, output, max) } -> std::convertible_to<size_t>;
+};
+
+// Anything that consumes normalized messages
+template <typename T>
+concept MessageSink = requires(T sink, const NormalizedMessage &msg) {
+  { sink.on_message(msg) } -> std::convertible_to<bool>;
+};
+
+// Compile-time wired pipeline: Source -> Parser -> Subscribers...
+// The parser and subscribers are held by value with their concrete types, so
+// every parse() and on_message() call is a direct call the compiler can
+// inline - no virtual dispatch, no unique_ptr indirection, no queues. All
+// subscribers run synchronously on the polling thread, in pack order.
+// Use CoreEngine when subscribers need their own threads or runtime
+// registration.
+template <PacketSource Source, MessageParser Parser, MessageSink... Subscribers>
+class StaticEngine {
+public:
+  static constexpr size_t MAX_MESSAGES_PER_PACKET = 128;
+
+  // The source is borrowed; parser and subscribers are owned
+  explicit StaticEngine(Source &source)
+      : source_(source), parser_(), subscribers_(), running_(false),
+        stats_() {}
+
+  StaticEngine(Source &source, Parser parser, Subscribers... subscribers)
+      : source_(source), parser_(std::move(parser)),
+        subscribers_(std::move(subscribers)...), running_(false), stats_() {}
+
+  ~StaticEngine() { stop(); }
+
+  StaticEngine(const StaticEngine &) = delete;
+  StaticEngine &operator=(const StaticEngine &) = delete;
+
+  // Process at most one packet on the calling thread
+  // Returns the number of messages delivered
+  size_t poll() noexcept {
+    MessageView packet;
+    if (!source_.peek_packet(packet)) {
+      return 0;
+    }
+
+    const size_t count =
+        parser_.parse(packet, messages_, MAX_MESSAGES_PER_PACKET);
+    source_.release_packet();
+
+    for (size_t i = 0; i < count; ++i) {
+      deliver(messages_[i], std::index_sequence_for<Subscribers...>{});
+    }
+
+    stats_.begin();
+    stats_.add_packets_received(1);
+    stats_.add_messages_parsed(count);
+    stats_.add_messages_dispatched(count);
+    if (count == 0) {
+      stats_.add_parse_errors(1);
+    }
+    stats_.commit();
+    return count;
+  }
+
+  // Run the poll loop on a dedicated thread
+  void start(int cpu_affinity = -1) {
+    if (running_.load())
+      return;
+
+    running_.store(true);
+    thread_ = std::thread(&StaticEngine::run, this);
+
+#ifdef __linux__
+    if (cpu_affinity >= 0) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu_affinity, &cpuset);
+      pthread_setaffinity_np(thread_.native_handle(), sizeof(cpu_set_t),
+                             &cpuset);
+    }
+#else
+    (void)cpu_affinity;
+#endif
+  }
+
+  // Stop the poll thread
+  void stop() {
+    if (!running_.load())
+      return;
+
+    running_.store(false);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // Access a subscriber by position in the pack
+  template <size_t I> auto &subscriber() noexcept {
+    return std::get<I>(subscribers_);
+  }
+
+  Parser &parser() noexcept { return parser_; }
+
+  // Get a statistics snapshot (any thread)
+  Statistics get_stats() const noexcept { return stats_.snapshot(); }
+
+  bool is_running() const noexcept { return running_.load(); }
+
+private:
+  // Hand a message to every subscriber - expands to straight-line calls
+  template <size_t... I>
+  void deliver(const NormalizedMessage &msg,
+               std::index_sequence<I...>) noexcept {
+    (static_cast<void>(std::get<I>(subscribers_).on_message(msg)), ...);
+  }
+
+  void run() {
+    while (running_.load(std::memory_order_relaxed)) {
+      if (poll() == 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  Source &source_;
+  Parser parser_;
+  std::tuple<Subscribers...> subscribers_;
+  NormalizedMessage messages_[MAX_MESSAGES_PER_PACKET];
+  std::thread thread_;
+  std::atomic<bool> running_;
+  StatsBlock stats_;
+};
+
+} // namespace core
+} // namespace hft
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "tracer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace hft {
+namespace core {
+
+// Convert collected trace events to Chrome trace-event JSON, which
+// chrome://tracing and ui.perfetto.dev both open. Each sampled message
+// becomes a set of slices - "wait" (received -> parse starts), "parse",
+// "dispatch" (parse done -> enqueued) on the parse thread and one
+// "callback" per subscriber on the delivering thread - joined by a flow
+// arrow from its parse to each of its callbacks.
+class ChromeTraceWriter {
+public:
+  static void write(const std::vector<TraceThread> &threads,
+                    std::ostream &out) {
+    ChromeTraceWriter writer(out);
+    writer.write_threads(threads);
+  }
+
+private:
+  struct Point {
+    uint32_t thread;
+    TraceEvent event;
+  };
+
+  explicit ChromeTraceWriter(std::ostream &out)
+      : out_(out), origin_(UINT64_MAX), first_(true) {}
+
+  void write_threads(const std::vector<TraceThread> &threads) {
+    // Group every event by trace id, in time order
+    std::map<uint32_t, std::vector<Point>> traces;
+    for (const auto &thread : threads) {
+      for (const auto &event : thread.events) {
+        origin_ = std::min(origin_, event.timestamp);
+        traces[event.trace_id].push_back({thread.index, event});
+      }
+    }
+
+    out_ << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (const auto &thread : threads) {
+      begin_event();
+      out_ << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.index
+           << ",\"name\":\"thread_name\",\"args\":{\"name\":\"";
+      write_escaped(thread.name);
+      out_ << "\"}}";
+    }
+
+    for (auto &trace : traces) {
+      std::vector<Point> &points = trace.second;
+      std::stable_sort(points.begin(), points.end(),
+                       [](const Point &a, const Point &b) {
+                         return a.event.timestamp < b.event.timestamp;
+                       });
+      write_trace(trace.first, points);
+    }
+    out_ << "]}\n";
+  }
+
+  void write_trace(uint32_t trace_id, const std::vector<Point> &points) {
+    const Point *received = find(points, TracePoint::RECEIVE);
+    const Point *parse_begin = find(points, TracePoint::PARSE_BEGIN);
+    const Point *parse_end = find(points, TracePoint::PARSE_END);
+    const Point *enqueued = find(points, TracePoint::ENQUEUE);
+
+    if (received && parse_begin) {
+      write_slice("wait", trace_id, parse_begin->thread, *received,
+                  *parse_begin);
+    }
+    if (parse_begin && parse_end) {
+      write_slice("parse", trace_id, parse_begin->thread, *parse_begin,
+                  *parse_end);
+      write_flow('s', trace_id, *parse_begin);
+    }
+    if (parse_end && enqueued) {
+      write_slice("dispatch", trace_id, enqueued->thread, *parse_end,
+                  *enqueued);
+    }
+
+    // Pair each callback begin with the next end on the same thread for the
+    // same subscriber
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (points[i].event.point != TracePoint::CALLBACK_BEGIN) {
+        continue;
+      }
+      for (size_t j = i + 1; j < points.size(); ++j) {
+        if (points[j].event.point == TracePoint::CALLBACK_END &&
+            points[j].thread == points[i].thread &&
+            points[j].event.detail == points[i].event.detail) {
+          write_slice("callback", trace_id, points[i].thread, points[i],
+                      points[j]);
+          if (parse_begin && parse_end) {
+            write_flow('f', trace_id, points[i]);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  static const Point *find(const std::vector<Point> &points,
+                           TracePoint point) {
+    for (const auto &p : points) {
+      if (p.event.point == point) {
+        return &p;
+      }
+    }
+    return nullptr;
+  }
+
+  void write_slice(const char *name, uint32_t trace_id, uint32_t thread,
+                   const Point &begin, const Point &end) {
+    begin_event();
+    out_ << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << thread << ",\"name\":\""
+         << name << "\",\"ts\":";
+    write_micros(begin.event.timestamp - origin_);
+    out_ << ",\"dur\":";
+    write_micros(end.event.timestamp > begin.event.timestamp
+                     ? end.event.timestamp - begin.event.timestamp
+                     : 0);
+    out_ << ",\"args\":{\"trace_id\":" << trace_id;
+    if (begin.event.point == TracePoint::CALLBACK_BEGIN) {
+      out_ << ",\"subscriber\":" << begin.event.detail;
+    } else if (begin.event.point == TracePoint::PARSE_BEGIN) {
+      out_ << ",\"messages\":" << begin.event.detail;
+    }
+    out_ << "}}";
+  }
+
+  // Flow arrow: 's' starts at the parse slice, 'f' ends in a callback slice
+  void write_flow(char phase, uint32_t trace_id, const Point &at) {
+    begin_event();
+    out_ << "{\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << at.thread
+         << ",\"name\":\"message\",\"cat\":\"message\",\"id\":" << trace_id
+         << ",\"ts\":";
+    write_micros(at.event.timestamp - origin_);
+    if (phase == 'f') {
+      out_ << ",\"bp\":\"e\"";
+    }
+    out_ << "}";
+  }
+
+  // Trace-event timestamps are microseconds; keep nanosecond precision
+  void write_micros(uint64_t nanos) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03llu",
+                  static_cast<unsigned long long>(nanos / 1000),
+                  static_cast<unsigned long long>(nanos % 1000));
+    out_ << buffer;
+  }
+
+  void write_escaped(const std::string &text) {
+    for (const char c : text) {
+      if (c == '"' || c == '\\') {
+        out_ << '\\' << c;
+      } else if (static_cast<unsigned char>(c) >= 0x20) {
+        out_ << c;
+      }
+    }
+  }
+
+  void begin_event() {
+    if (!first_) {
+      out_ << ",";
+    }
+    out_ << "\n";
+    first_ = false;
+  }
+
+  std::ostream &out_;
+  Timestamp origin_; // Earliest event, shown at time zero
+  bool first_;
+};
+
+} // namespace core
+} // namespace hft
@@ -0,0 +1,297 @@
+#pragma once
+
+#include "../types.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hft {
+namespace core {
+
+// Points on a message's path through the engine
+enum class TracePoint : uint8_t {
+  RECEIVE = 0,        // Packet received (timestamp from the receiver)
+  PARSE_BEGIN = 1,    // Parse of the message's packet starts
+  PARSE_END = 2,      // Parse done
+  ENQUEUE = 3,        // Handed to every subscriber queue / the ring
+  CALLBACK_BEGIN = 4, // Subscriber callback starts (detail = subscriber id)
+  CALLBACK_END = 5    // Subscriber callback returned
+};
+
+// One recorded event - 16 bytes
+struct TraceEvent {
+  Timestamp timestamp;
+  uint32_t trace_id;
+  TracePoint point;
+  uint8_t reserved;
+  uint16_t detail; // Point-specific: messages in packet, subscriber id
+};
+
+static_assert(sizeof(TraceEvent) == 16, "TraceEvent must stay compact");
+
+// Flight recorder for one thread: keeps the newest CAPACITY events,
+// overwriting the oldest. One writer; collect() may run on any thread.
+class TraceRing {
+public:
+  static constexpr size_t CAPACITY = 16384;
+
+  TraceRing()
+      : head_(0), events_(std::make_unique<TraceEvent[]>(CAPACITY)) {}
+
+  void record(const TraceEvent &event) noexcept {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    std::memcpy(static_cast<void *>(&events_[head & (CAPACITY - 1)]), &event,
+                sizeof(TraceEvent));
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Append the retained events, oldest first
+  void collect(std::vector<TraceEvent> &out) const {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    const uint64_t first = head > CAPACITY ? head - CAPACITY : 0;
+    const size_t start = out.size();
+    for (uint64_t i = first; i < head; ++i) {
+      TraceEvent event;
+      std::memcpy(static_cast<void *>(&event), &events_[i & (CAPACITY - 1)],
+                  sizeof(TraceEvent));
+      out.push_back(event);
+    }
+
+    // Drop anything the writer may have overwritten while we copied,
+    // including the slot it may be writing right now
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t now = head_.load(std::memory_order_relaxed) + 1;
+    const uint64_t valid = now > CAPACITY ? now - CAPACITY : 0;
+    if (valid > first) {
+      const uint64_t stale = std::min<uint64_t>(valid - first, head - first);
+      out.erase(out.begin() + static_cast<std::ptrdiff_t>(start),
+                out.begin() + static_cast<std::ptrdiff_t>(start + stale));
+    }
+  }
+
+  // Events recorded since construction (including overwritten ones)
+  uint64_t recorded() const noexcept {
+    return head_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::atomic<uint64_t> head_;
+  std::unique_ptr<TraceEvent[]> events_;
+};
+
+// Events collected from one thread
+struct TraceThread {
+  uint32_t index{0};
+  std::string name;
+  std::vector<TraceEvent> events;
+};
+
+// Process-wide tracer - each thread records into its own TraceRing,
+// registered on its first event. Sampling picks one message in every N
+// and gives it a nonzero trace id that travels in NormalizedMessage.
+// Engine trace points are compiled in with HFT_TRACE (see HFT_TRACE_POINT).
+class Tracer {
+public:
+  static Tracer &instance() {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  // Trace one message in every interval (0 = off, the default)
+  void set_sample_interval(uint32_t interval) noexcept {
+    sample_interval_.store(interval, std::memory_order_relaxed);
+  }
+
+  uint32_t sample_interval() const noexcept {
+    return sample_interval_.load(std::memory_order_relaxed);
+  }
+
+  // Trace id for the calling thread's next message: nonzero if sampled
+  uint32_t sample() noexcept {
+    const uint32_t interval =
+        sample_interval_.load(std::memory_order_relaxed);
+    if (interval == 0) {
+      return 0;
+    }
+    thread_local uint32_t countdown = 0;
+    if (countdown != 0) {
+      countdown--;
+      return 0;
+    }
+    countdown = interval - 1;
+
+    uint32_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+    if (id == 0) {
+      id = next_id_.fetch_add(1, std::memory_order_relaxed); // Wrapped
+    }
+    return id;
+  }
+
+  // Record an event on the calling thread's ring
+  void record(TracePoint point, uint32_t trace_id, uint16_t detail,
+              Timestamp timestamp) noexcept {
+    TraceEvent event;
+    event.timestamp = timestamp;
+    event.trace_id = trace_id;
+    event.point = point;
+    event.reserved = 0;
+    event.detail = detail;
+    thread_ring().record(event);
+  }
+
+  // Label the calling thread in exported traces
+  void set_thread_name(const char *name) {
+    Registration &registration = thread_registration();
+    std::lock_guard<std::mutex> lock(mutex_);
+    registration.name = name;
+  }
+
+  // Copy every thread's retained events (any thread)
+  std::vector<TraceThread> collect() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<TraceThread> threads;
+    for (size_t i = 0; i < registrations_.size(); ++i) {
+      TraceThread thread;
+      thread.index = static_cast<uint32_t>(i);
+      thread.name = registrations_[i]->name;
+      registrations_[i]->ring.collect(thread.events);
+      threads.push_back(std::move(thread));
+    }
+    return threads;
+  }
+
+  // Dump every thread's retained events to a binary file for offline
+  // conversion (see chrome_trace.hpp). Returns false on I/O failure
+  bool write(const char *path) const {
+    return write_trace_file(path, collect());
+  }
+
+  // Binary dump layout: FileHeader, then per thread a ThreadHeader followed
+  // by its events
+  struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t thread_count;
+  };
+
+  struct ThreadHeader {
+    uint32_t index;
+    uint32_t event_count;
+    char name[24];
+  };
+
+  static constexpr char MAGIC[8] = {'H', 'F', 'T', 'T', 'R', 'A', 'C', 'E'};
+  static constexpr uint32_t VERSION = 1;
+
+  static bool write_trace_file(const char *path,
+                               const std::vector<TraceThread> &threads) {
+    FILE *file = std::fopen(path, "wb");
+    if (file == nullptr) {
+      return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.thread_count = static_cast<uint32_t>(threads.size());
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for (const auto &thread : threads) {
+      ThreadHeader thread_header{};
+      thread_header.index = thread.index;
+      thread_header.event_count = static_cast<uint32_t>(thread.events.size());
+      std::strncpy(thread_header.name, thread.name.c_str(),
+                   sizeof(thread_header.name) - 1);
+      ok = ok &&
+           std::fwrite(&thread_header, sizeof(thread_header), 1, file) == 1;
+      ok = ok && std::fwrite(thread.events.data(), sizeof(TraceEvent),
+                             thread.events.size(),
+                             file) == thread.events.size();
+    }
+
+    return std::fclose(file) == 0 && ok;
+  }
+
+  static bool read_trace_file(const char *path,
+                              std::vector<TraceThread> &threads) {
+    FILE *file = std::fopen(path, "rb");
+    if (file == nullptr) {
+      return false;
+    }
+
+    FileHeader header{};
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+              header.version == VERSION;
+
+    for (uint32_t i = 0; ok && i < header.thread_count; ++i) {
+      ThreadHeader thread_header{};
+      ok = std::fread(&thread_header, sizeof(thread_header), 1, file) == 1;
+      if (!ok) {
+        break;
+      }
+      TraceThread thread;
+      thread.index = thread_header.index;
+      const size_t name_length =
+          strnlen(thread_header.name, sizeof(thread_header.name));
+      thread.name.assign(thread_header.name, name_length);
+      thread.events.resize(thread_header.event_count);
+      ok = std::fread(thread.events.data(), sizeof(TraceEvent),
+                      thread.events.size(), file) == thread.events.size();
+      threads.push_back(std::move(thread));
+    }
+
+    std::fclose(file);
+    return ok;
+  }
+
+private:
+  struct Registration {
+    TraceRing ring;
+    std::string name;
+  };
+
+  Tracer() : sample_interval_(0), next_id_(1) {}
+
+  Registration &thread_registration() {
+    thread_local Registration *registration = nullptr;
+    if (registration == nullptr) {
+      // Rings outlive their threads so a dump still shows exited ones
+      std::lock_guard<std::mutex> lock(mutex_);
+      registrations_.push_back(std::make_unique<Registration>());
+      registration = registrations_.back().get();
+      registration->name = "thread " + std::to_string(registrations_.size());
+    }
+    return *registration;
+  }
+
+  TraceRing &thread_ring() noexcept { return thread_registration().ring; }
+
+  std::atomic<uint32_t> sample_interval_;
+  std::atomic<uint32_t> next_id_;
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Registration>> registrations_;
+};
+
+} // namespace core
+} // namespace hft
+
+// Record an engine trace point for a sampled message (compiled out unless
+// HFT_TRACE is defined; costs one branch on trace_id otherwise)
+#ifdef HFT_TRACE
+#define HFT_TRACE_POINT(point, trace_id, detail)                               \
+  do {                                                                         \
+    if ((trace_id) != 0) {                                                     \
+      ::hft::core::Tracer::instance().record(                                  \
+          ::hft::core::TracePoint::point, (trace_id),                          \
+          static_cast<uint16_t>(detail), ::hft::core::get_timestamp());        \
+    }                                                                          \
+  } while (0)
+#else
+#define HFT_TRACE_POINT(point, trace_id, detail) ((void)0)
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "clock.hpp"
 #include <chrono>
 #include <cstdint>
 #include <cstring>
@@ -11,25 +12,42 @@ namespace core {
 using Timestamp = uint64_t;
 
 // Get current timestamp with minimal overhead
+// Nanoseconds on the steady clock; built with HFT_TSC_CLOCK they come from
+// the calibrated TSC instead of a clock_gettime call
 inline Timestamp get_timestamp() noexcept {
+#ifdef HFT_TSC_CLOCK
+  return TscClock::now();
+#else
   return std::chrono::duration_cast<std::chrono::nanoseconds>(
              std::chrono::steady_clock::now().time_since_epoch())
       .count();
+#endif
+}
+
+// Wall-clock timestamp in nanoseconds - same clock domain as kernel socket
+// receive timestamps (SO_TIMESTAMP*), which are not monotonic
+inline Timestamp get_wall_timestamp() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
 }
 
 // Message view - zero-copy reference to raw data
 struct alignas(64) MessageView {
-  const uint8_t *data; // Pointer to message data
-  uint32_t length;     // Message length in bytes
-  Timestamp timestamp; // Reception timestamp
-  uint32_t sequence;   // Sequence number
+  const uint8_t *data;        // Pointer to message data
+  uint32_t length;            // Message length in bytes
+  Timestamp timestamp;        // Reception timestamp (userspace)
+  uint32_t sequence;          // Sequence number
+  Timestamp kernel_timestamp; // Kernel RX timestamp, wall clock (0 = none)
 
   MessageView() noexcept
-      : data(nullptr), length(0), timestamp(0), sequence(0) {}
+      : data(nullptr), length(0), timestamp(0), sequence(0),
+        kernel_timestamp(0) {}
 
   MessageView(const uint8_t *d, uint32_t len, Timestamp ts,
               uint32_t seq) noexcept
-      : data(d), length(len), timestamp(ts), sequence(seq) {}
+      : data(d), length(len), timestamp(ts), sequence(seq),
+        kernel_timestamp(0) {}
 
   // Check if message is valid
   bool is_valid() const noexcept { return data != nullptr && length > 0; }
@@ -46,24 +64,45 @@ struct alignas(64) NormalizedMessage {
     ORDER_DELETE = 5,
     ORDER_EXECUTE = 6,
     IMBALANCE = 7,
-    SYSTEM_EVENT = 8
+    SYSTEM_EVENT = 8,
+    STATUS = 9,      // Trading state, halts, restrictions
+    TRADE_BREAK = 10 // Previously reported trade was broken
+                     // (keep last: ConflationBuffer::TYPE_COUNT uses it)
   };
 
+  // flags bits, set by stateful parsers (e.g. ITCH order tracking).
+  // FLAG_PRINT_PRICE marks an execution printed at a price other than the
+  // order's: the ORDER_EXECUTE carries the resting price and the TRADE
+  // right after it the print price
+  static constexpr uint8_t FLAG_ENRICHED = 0x01;    // Order state filled in
+  static constexpr uint8_t FLAG_REPLACE = 0x02;     // Half of a replace pair
+  static constexpr uint8_t FLAG_PRINT_PRICE = 0x04; // Half of a priced print
+
+  // Small fields first so the message packs into a single cache line
   Type type;
-  uint64_t instrument_id;    // Internal instrument identifier
-  uint64_t order_id;         // Order reference
-  int64_t price;             // Price in fixed point (scale: 10000)
-  uint64_t quantity;         // Quantity
-  uint8_t side;              // 0=buy, 1=sell
-  Timestamp timestamp;       // Original exchange timestamp
-  Timestamp local_timestamp; // Local reception timestamp
-  uint32_t sequence;         // Message sequence
+  uint8_t side;                // 0=buy, 1=sell
+  uint8_t source_type;         // Protocol message type (e.g. ITCH 'H')
+  uint8_t code;                // Protocol state/event code, 0 if none
+  uint32_t sequence;           // Message sequence
+  uint32_t instrument_id;      // Internal instrument identifier
+  uint32_t trace_id;           // Nonzero if sampled for tracing
+  uint64_t order_id;           // Order reference
+  int64_t price;               // Price in fixed point (scale: 10000)
+  uint64_t quantity;           // Quantity
+  Timestamp timestamp;         // Original exchange timestamp
+  Timestamp local_timestamp;   // Local reception timestamp
+  uint32_t remaining_quantity; // Shares left on the order after this event
+  uint8_t flags;               // FLAG_* bits
 
   NormalizedMessage() noexcept
-      : type(Type::UNKNOWN), instrument_id(0), order_id(0), price(0),
-        quantity(0), side(0), timestamp(0), local_timestamp(0), sequence(0) {}
+      : type(Type::UNKNOWN), side(0), source_type(0), code(0), sequence(0),
+        instrument_id(0), trace_id(0), order_id(0), price(0), quantity(0),
+        timestamp(0), local_timestamp(0), remaining_quantity(0), flags(0) {}
 };
 
+static_assert(sizeof(NormalizedMessage) == 64,
+              "NormalizedMessage must fit in one cache line");
+
 // Configuration constants
 namespace config {
 constexpr size_t CACHELINE_SIZE = 64;
@@ -71,18 +110,22 @@ constexpr size_t PAGE_SIZE = 4096;
 constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
 
 // Network config
-constexpr size_t MAX_PACKET_SIZE = 9000; // Jumbo frame
-constexpr size_t PACKET_RING_SIZE = 1024 * 16;
+constexpr size_t MAX_PACKET_SIZE = 9000;              // Jumbo frame
+constexpr size_t PACKET_RING_BYTES = 4 * 1024 * 1024; // Variable-length ring
+constexpr size_t MAX_RECV_BATCH = 64;    // Upper bound for recvmmsg batching
+constexpr long RECV_TIMEOUT_US = 100000; // Receive poll interval for shutdown
 
 // Queue config
 constexpr size_t DEFAULT_QUEUE_SIZE = 1024 * 64;
+constexpr size_t MAX_DELIVERY_BATCH = 64; // Messages per on_messages() call
 
 // Thread affinity
 constexpr int NETWORK_THREAD_CPU = 2;
 constexpr int DISPATCHER_THREAD_CPU = 3;
 } // namespace config
 
-// Statistics counters
+// Statistics counters - plain values, used for snapshots and by single
+// threads; stages shared across threads keep theirs in a StatsBlock
 struct alignas(64) Statistics {
   uint64_t packets_received{0};
   uint64_t packets_dropped{0};
@@ -93,6 +136,12 @@ struct alignas(64) Statistics {
   uint64_t max_latency_ns{0};
   uint64_t total_latency_ns{0};
 
+  // Kernel RX -> userspace receive latency (kernel timestamps only)
+  uint64_t kernel_latency_samples{0};
+  uint64_t min_kernel_latency_ns{UINT64_MAX};
+  uint64_t max_kernel_latency_ns{0};
+  uint64_t total_kernel_latency_ns{0};
+
   void update_latency(uint64_t latency_ns) noexcept {
     if (latency_ns < min_latency_ns)
       min_latency_ns = latency_ns;
@@ -101,11 +150,27 @@ struct alignas(64) Statistics {
     total_latency_ns += latency_ns;
   }
 
+  void update_kernel_latency(uint64_t latency_ns) noexcept {
+    if (latency_ns < min_kernel_latency_ns)
+      min_kernel_latency_ns = latency_ns;
+    if (latency_ns > max_kernel_latency_ns)
+      max_kernel_latency_ns = latency_ns;
+    total_kernel_latency_ns += latency_ns;
+    kernel_latency_samples++;
+  }
+
   double avg_latency_ns() const noexcept {
     return messages_dispatched > 0
                ? static_cast<double>(total_latency_ns) / messages_dispatched
                : 0.0;
   }
+
+  double avg_kernel_latency_ns() const noexcept {
+    return kernel_latency_samples > 0
+               ? static_cast<double>(total_kernel_latency_ns) /
+                     kernel_latency_samples
+               : 0.0;
+  }
 };
 
 } // namespace core
@@ -106,6 +106,25 @@ int main() {
     std::cout << "  Min latency: " << final_stats.min_latency_ns << "ns\n";
     std::cout << "  Max latency: " << final_stats.max_latency_ns << "ns\n";
     std::cout << "  Avg latency: " << final_stats.avg_latency_ns() << "ns\n";
+    std::cout << "  Avg kernel->user latency: "
+              << final_stats.avg_kernel_latency_ns() << "ns\n";
+
+    for (size_t i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+        const auto stage = static_cast<LatencyStage>(i);
+        LatencyHistogram histogram;
+        engine.latency_histogram(stage, histogram);
+        std::cout << "  " << latency_stage_name(stage) << " latency:"
+                  << " p50=" << histogram.percentile(50) << "ns"
+                  << " p99=" << histogram.percentile(99) << "ns"
+                  << " p99.99=" << histogram.percentile(99.99) << "ns\n";
+    }
+    for (size_t i = 0; i < engine.subscriber_count(); ++i) {
+        SubscriberStats sub_stats = engine.subscriber_stats(i);
+        std::cout << "  Subscriber " << i << ": delivered="
+                  << sub_stats.messages_delivered
+                  << " dropped=" << sub_stats.messages_dropped
+                  << " avg_latency=" << sub_stats.avg_latency_ns() << "ns\n";
+    }
     
     return 0;
 }
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include "../core/book/order_book.hpp"
 #include "../core/core_engine.hpp"
 #include "../protocols/itch50/itch50_parser.hpp"
 #include <atomic>
@@ -16,21 +17,18 @@ void signal_handler(int signal) {
   running.store(false);
 }
 
-// Order book subscriber that tracks orders for a specific instrument
-class OrderBookSubscriber : public ISubscriber {
+// Builds full-depth books for the instruments it is subscribed to
+// (filtering happens in the dispatcher) and samples the activity
+class ItchBookSubscriber : public OrderBookSubscriber {
 public:
-  explicit OrderBookSubscriber(uint64_t instrument_id)
-      : instrument_id_(instrument_id), message_count_(0), add_count_(0),
-        execute_count_(0), cancel_count_(0), delete_count_(0), trade_count_(0) {
-  }
+  ItchBookSubscriber()
+      : OrderBookSubscriber(OrderBookConfig{}, "ItchBookSubscriber"),
+        message_count_(0), add_count_(0), execute_count_(0), cancel_count_(0),
+        delete_count_(0), trade_count_(0) {}
 
   bool on_message(const NormalizedMessage &msg) noexcept override {
-    // Filter by instrument
-    if (msg.instrument_id != instrument_id_ && instrument_id_ != 0) {
-      return true;
-    }
-
     message_count_++;
+    OrderBookSubscriber::on_message(msg);
 
     switch (msg.type) {
     case NormalizedMessage::Type::ORDER_ADD:
@@ -69,8 +67,6 @@ public:
     return true;
   }
 
-  const char *name() const noexcept override { return "OrderBookSubscriber"; }
-
   void shutdown() override {
     std::cout << "\n" << std::string(60, '=') << "\n";
     std::cout << "Order Book Statistics\n";
@@ -81,6 +77,8 @@ public:
     std::cout << "  Cancels:      " << cancel_count_ << "\n";
     std::cout << "  Deletes:      " << delete_count_ << "\n";
     std::cout << "  Trades:       " << trade_count_ << "\n";
+    std::cout << "Resting orders: " << book().order_count() << " at "
+              << book().level_count() << " price levels\n";
     std::cout << std::string(60, '=') << "\n";
   }
 
@@ -91,7 +89,15 @@ private:
               << " Order: " << msg.order_id
               << " Side: " << (msg.side == 0 ? "BUY" : "SELL")
               << " Qty: " << msg.quantity << " Price: $" << std::fixed
-              << std::setprecision(4) << (msg.price / 10000.0) << "\n";
+              << std::setprecision(4) << (msg.price / 10000.0);
+    BookLevel bid;
+    BookLevel ask;
+    if (book().best(msg.instrument_id, OrderBook::BID, bid) &&
+        book().best(msg.instrument_id, OrderBook::ASK, ask)) {
+      std::cout << " Book: " << bid.quantity << " @ " << (bid.price / 10000.0)
+                << " / " << ask.quantity << " @ " << (ask.price / 10000.0);
+    }
+    std::cout << "\n";
   }
 
   void print_trade(const NormalizedMessage &msg) const {
@@ -102,7 +108,6 @@ private:
               << std::setprecision(4) << (msg.price / 10000.0) << "\n";
   }
 
-  uint64_t instrument_id_;
   uint64_t message_count_;
   uint64_t add_count_;
   uint64_t execute_count_;
@@ -171,6 +176,10 @@ private:
       return "Imbalance";
     case NormalizedMessage::Type::SYSTEM_EVENT:
       return "System Event";
+    case NormalizedMessage::Type::STATUS:
+      return "Status";
+    case NormalizedMessage::Type::TRADE_BREAK:
+      return "Trade Break";
     default:
       return "Other";
     }
@@ -214,12 +223,24 @@ int main(int argc, char **argv) {
 
   CoreEngine engine(config);
 
-  // Set ITCH 5.0 parser
-  engine.set_parser(std::make_unique<ItchParser>());
+  // Set ITCH 5.0 parser - order tracking turns replaces into the delete and
+  // add pairs the book needs
+  auto parser = std::make_unique<ItchParser>();
+  parser->enable_order_tracking();
+  engine.set_parser(std::move(parser));
 
-  // Add subscribers
-  engine.add_subscriber(
-      std::make_unique<OrderBookSubscriber>(instrument_filter));
+  // Add subscribers - the order book only sees order and trade messages for
+  // the filtered instrument, so the rest never reach its queue
+  SubscriberOptions book_options;
+  if (instrument_filter > 0) {
+    book_options.filter.add_instrument(instrument_filter);
+  }
+  book_options.filter.add_type(NormalizedMessage::Type::ORDER_ADD)
+      .add_type(NormalizedMessage::Type::ORDER_EXECUTE)
+      .add_type(NormalizedMessage::Type::ORDER_MODIFY)
+      .add_type(NormalizedMessage::Type::ORDER_DELETE)
+      .add_type(NormalizedMessage::Type::TRADE);
+  engine.add_subscriber(std::make_unique<ItchBookSubscriber>(), book_options);
   engine.add_subscriber(std::make_unique<StatisticsSubscriber>());
 
   // Initialize
@@ -52,7 +52,10 @@ enum class MessageType : uint8_t {
   CROSS_TRADE = 'Q',                 // 42 bytes
   BROKEN_TRADE = 'B',                // 21 bytes
   NOII = 'I',                        // 52 bytes
-  RPII = 'N'                         // 22 bytes
+  RPII = 'N',                        // 22 bytes
+  LULD_AUCTION_COLLAR = 'J',         // 37 bytes
+  OPERATIONAL_HALT = 'h',            // 23 bytes
+  DLCR_PRICE_DISCOVERY = 'O'         // 50 bytes
 };
 
 // System Event Codes
@@ -119,6 +122,113 @@ struct StockDirectoryMessage {
   static constexpr size_t SIZE = 41;
 };
 
+// Stock Trading Action Message (Type 'H')
+struct StockTradingActionMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'H'
+  char stock[8];
+  uint8_t trading_state; // H=halted, P=paused, Q=quotation only, T=trading
+  uint8_t reserved;
+  char reason[4];
+
+  static constexpr size_t SIZE = 27;
+};
+
+// Reg SHO Short Sale Price Test Restricted Indicator (Type 'Y')
+struct RegSHORestrictionMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'Y'
+  char stock[8];
+  uint8_t reg_sho_action; // 0=no test, 1=test in effect, 2=test remains
+
+  static constexpr size_t SIZE = 22;
+};
+
+// Market Participant Position Message (Type 'L')
+struct MarketParticipantPositionMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'L'
+  char mpid[4];
+  char stock[8];
+  uint8_t primary_market_maker; // Y/N
+  uint8_t market_maker_mode;
+  uint8_t market_participant_state;
+
+  static constexpr size_t SIZE = 28;
+};
+
+// MWCB Decline Level Message (Type 'V')
+struct MWCBDeclineLevelMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'V'
+  uint64_t level1;      // Prices with 8 implied decimals
+  uint64_t level2;
+  uint64_t level3;
+
+  static constexpr size_t SIZE = 37;
+};
+
+// MWCB Status Message (Type 'W')
+struct MWCBStatusMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type;   // Always 'W'
+  uint8_t breached_level; // '1', '2' or '3'
+
+  static constexpr size_t SIZE = 14;
+};
+
+// IPO Quoting Period Update Message (Type 'K')
+struct IPOQuotingPeriodMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'K'
+  char stock[8];
+  uint32_t release_time; // Seconds since midnight
+  uint8_t release_qualifier; // A=anticipated, C=cancelled/postponed
+  uint32_t ipo_price;
+
+  static constexpr size_t SIZE = 30;
+};
+
+// LULD Auction Collar Message (Type 'J')
+struct LULDAuctionCollarMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'J'
+  char stock[8];
+  uint32_t reference_price;
+  uint32_t upper_price;
+  uint32_t lower_price;
+  uint32_t extension; // Times the halt has been extended
+
+  static constexpr size_t SIZE = 37;
+};
+
+// Operational Halt Message (Type 'h')
+struct OperationalHaltMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'h'
+  char stock[8];
+  uint8_t market_code; // Q=Nasdaq, B=BX, X=PSX
+  uint8_t halt_action; // H=halted, T=resumed
+
+  static constexpr size_t SIZE = 23;
+};
+
 // Add Order Message (Type 'A')
 struct AddOrderMessage {
   uint16_t stock_locate;
@@ -257,27 +367,76 @@ struct BrokenTradeMessage {
   static constexpr size_t SIZE = 21;
 };
 
+// Net Order Imbalance Indicator Message (Type 'I')
+struct NOIIMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'I'
+  uint64_t paired_shares;
+  uint64_t imbalance_shares;
+  uint8_t imbalance_direction; // B=buy, S=sell, N=none, O=insufficient
+  char stock[8];
+  uint32_t far_price;
+  uint32_t near_price;
+  uint32_t current_reference_price;
+  uint8_t cross_type;
+  uint8_t price_variation_indicator;
+
+  static constexpr size_t SIZE = 52;
+};
+
+// Retail Price Improvement Indicator Message (Type 'N')
+struct RPIIMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'N'
+  char stock[8];
+  uint8_t interest_flag; // B=buy, S=sell, A=both, N=none
+
+  static constexpr size_t SIZE = 22;
+};
+
+// Direct Listing with Capital Raise Price Discovery Message (Type 'O')
+struct DLCRPriceDiscoveryMessage {
+  uint16_t stock_locate;
+  uint16_t tracking_number;
+  uint64_t timestamp;
+  uint8_t message_type; // Always 'O'
+  char stock[8];
+  uint8_t open_eligibility_status; // N=not eligible, Y=eligible
+  uint32_t minimum_allowable_price;
+  uint32_t maximum_allowable_price;
+  uint32_t near_execution_price;
+  uint64_t near_execution_time;
+  uint32_t lower_price_range_collar;
+  uint32_t upper_price_range_collar;
+
+  static constexpr size_t SIZE = 50;
+};
+
 #pragma pack(pop)
 
 // Helper function to get message size by type
-inline size_t get_message_size(MessageType type) {
+constexpr size_t get_message_size(MessageType type) noexcept {
   switch (type) {
   case MessageType::SYSTEM_EVENT:
     return SystemEventMessage::SIZE;
   case MessageType::STOCK_DIRECTORY:
     return StockDirectoryMessage::SIZE;
   case MessageType::STOCK_TRADING_ACTION:
-    return 27;
+    return StockTradingActionMessage::SIZE;
   case MessageType::REG_SHO_RESTRICTION:
-    return 22;
+    return RegSHORestrictionMessage::SIZE;
   case MessageType::MARKET_PARTICIPANT_POSITION:
-    return 28;
+    return MarketParticipantPositionMessage::SIZE;
   case MessageType::MWCB_DECLINE_LEVEL:
-    return 37;
+    return MWCBDeclineLevelMessage::SIZE;
   case MessageType::MWCB_STATUS:
-    return 14;
+    return MWCBStatusMessage::SIZE;
   case MessageType::IPO_QUOTING_PERIOD:
-    return 30;
+    return IPOQuotingPeriodMessage::SIZE;
   case MessageType::ADD_ORDER:
     return AddOrderMessage::SIZE;
   case MessageType::ADD_ORDER_MPID:
@@ -299,9 +458,15 @@ inline size_t get_message_size(MessageType type) {
   case MessageType::BROKEN_TRADE:
     return BrokenTradeMessage::SIZE;
   case MessageType::NOII:
-    return 52;
+    return NOIIMessage::SIZE;
   case MessageType::RPII:
-    return 22;
+    return RPIIMessage::SIZE;
+  case MessageType::LULD_AUCTION_COLLAR:
+    return LULDAuctionCollarMessage::SIZE;
+  case MessageType::OPERATIONAL_HALT:
+    return OperationalHaltMessage::SIZE;
+  case MessageType::DLCR_PRICE_DISCOVERY:
+    return DLCRPriceDiscoveryMessage::SIZE;
   default:
     return 0;
   }
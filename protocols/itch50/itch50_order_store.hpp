@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hft {
+namespace protocols {
+namespace itch50 {
+
+// Live state of one resting order
+struct OrderState {
+  uint32_t price;     // Fixed point (scale: 10000)
+  uint32_t remaining; // Shares still on the book
+  uint8_t side;       // 0=buy, 1=sell
+};
+
+// Live orders keyed by ITCH order reference number.
+// ITCH assigns references in near-monotonic order, so the live orders sit in
+// a sliding window of recent references: a power-of-two table indexed by
+// ref & mask holds them without hashing. An order still resting when a new
+// reference lands on its slot (e.g. a day order far behind the window) moves
+// to a small open-addressed overflow table rather than being lost; once that
+// is full, displaced orders are dropped and counted. Everything is allocated
+// up front, so adding never allocates.
+// Single-threaded - owned by the parser.
+class OrderStore {
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+  // overflow_capacity = 0 sizes the overflow at 1/8 of the table (min 8)
+  explicit OrderStore(size_t capacity = DEFAULT_CAPACITY,
+                      size_t overflow_capacity = 0)
+      : capacity_(round_up_pow2(capacity)), mask_(capacity_ - 1),
+        slots_(std::make_unique<Slot[]>(capacity_)), size_(0),
+        overflow_capacity_(round_up_pow2(
+            overflow_capacity != 0 ? overflow_capacity
+                                   : (capacity_ / 8 > 8 ? capacity_ / 8 : 8))),
+        overflow_mask_(overflow_capacity_ * 2 - 1),
+        overflow_(std::make_unique<Slot[]>(overflow_capacity_ * 2)),
+        overflow_size_(0), dropped_(0) {}
+
+  OrderStore(const OrderStore &) = delete;
+  OrderStore &operator=(const OrderStore &) = delete;
+
+  // Insert or overwrite an order
+  void add(uint64_t ref, const OrderState &state) noexcept {
+    Slot &slot = slots_[ref & mask_];
+    if (overflow_size_ != 0 && !(slot.live && slot.ref == ref)) {
+      const size_t index = find_overflow(ref);
+      if (index != NONE) {
+        overflow_[index].state = state;
+        return;
+      }
+    }
+    if (slot.live && slot.ref != ref) {
+      add_overflow(slot.ref, slot.state);
+    } else if (!slot.live) {
+      size_++;
+    }
+    slot.ref = ref;
+    slot.state = state;
+    slot.live = true;
+  }
+
+  // nullptr if the reference is unknown (e.g. added before we joined)
+  OrderState *find(uint64_t ref) noexcept {
+    Slot &slot = slots_[ref & mask_];
+    if (slot.live && slot.ref == ref) {
+      return &slot.state;
+    }
+    if (overflow_size_ == 0) {
+      return nullptr;
+    }
+    const size_t index = find_overflow(ref);
+    return index == NONE ? nullptr : &overflow_[index].state;
+  }
+
+  void remove(uint64_t ref) noexcept {
+    Slot &slot = slots_[ref & mask_];
+    if (slot.live && slot.ref == ref) {
+      slot.live = false;
+      size_--;
+      return;
+    }
+    if (overflow_size_ != 0) {
+      const size_t index = find_overflow(ref);
+      if (index != NONE) {
+        remove_overflow(index);
+      }
+    }
+  }
+
+  void clear() noexcept {
+    for (size_t i = 0; i < capacity_; ++i) {
+      slots_[i].live = false;
+    }
+    for (size_t i = 0; i <= overflow_mask_; ++i) {
+      overflow_[i].live = false;
+    }
+    size_ = 0;
+    overflow_size_ = 0;
+    dropped_ = 0;
+  }
+
+  // Live orders, including those in the overflow table
+  size_t size() const noexcept { return size_ + overflow_size_; }
+
+  // Live orders pushed out of the table by newer references
+  size_t overflowed() const noexcept { return overflow_size_; }
+
+  // Live orders lost because the overflow table was full
+  uint64_t dropped() const noexcept { return dropped_; }
+
+  size_t capacity() const noexcept { return capacity_; }
+  size_t overflow_capacity() const noexcept { return overflow_capacity_; }
+
+private:
+  struct Slot {
+    uint64_t ref{0};
+    OrderState state{};
+    bool live{false};
+  };
+
+  static constexpr size_t NONE = SIZE_MAX;
+
+  // Overflow home slot - displaced references are scattered, so hash them
+  size_t overflow_home(uint64_t ref) const noexcept {
+    return static_cast<size_t>((ref * 0x9E3779B97F4A7C15ULL) >> 32) &
+           overflow_mask_;
+  }
+
+  size_t find_overflow(uint64_t ref) const noexcept {
+    for (size_t i = overflow_home(ref); overflow_[i].live;
+         i = (i + 1) & overflow_mask_) {
+      if (overflow_[i].ref == ref) {
+        return i;
+      }
+    }
+    return NONE;
+  }
+
+  // Linear probing; the table is at most half full
+  void add_overflow(uint64_t ref, const OrderState &state) noexcept {
+    size_t i = overflow_home(ref);
+    while (overflow_[i].live && overflow_[i].ref != ref) {
+      i = (i + 1) & overflow_mask_;
+    }
+    if (!overflow_[i].live) {
+      if (overflow_size_ == overflow_capacity_) {
+        dropped_++;
+        return;
+      }
+      overflow_size_++;
+    }
+    overflow_[i].ref = ref;
+    overflow_[i].state = state;
+    overflow_[i].live = true;
+  }
+
+  // Backward-shift deletion keeps every probe chain unbroken
+  void remove_overflow(size_t hole) noexcept {
+    for (size_t i = (hole + 1) & overflow_mask_; overflow_[i].live;
+         i = (i + 1) & overflow_mask_) {
+      const size_t home = overflow_home(overflow_[i].ref);
+      // Move the entry back unless its home lies after the hole
+      if (((i - home) & overflow_mask_) >= ((i - hole) & overflow_mask_)) {
+        overflow_[hole] = overflow_[i];
+        hole = i;
+      }
+    }
+    overflow_[hole].live = false;
+    overflow_size_--;
+  }
+
+  static size_t round_up_pow2(size_t value) noexcept {
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  size_t capacity_;
+  size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  size_t size_; // Live orders in the table
+  size_t overflow_capacity_;
+  size_t overflow_mask_;              // Overflow slots - 1 (twice capacity)
+  std::unique_ptr<Slot[]> overflow_;  // Open-addressed, by overflow_home()
+  size_t overflow_size_;
+  uint64_t dropped_;
+};
+
+} // namespace itch50
+} // namespace protocols
+} // namespace hft
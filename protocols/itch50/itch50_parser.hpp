@@ -3,6 +3,10 @@
 #include "../../core/parser/parser_interface.hpp"
 #include "../../core/types.hpp"
 #include "itch50_messages.hpp"
+#include "itch50_order_store.hpp"
+#include <array>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -11,9 +15,9 @@ namespace protocols {
 namespace itch50 {
 
 // ITCH 5.0 Parser - converts ITCH messages into NormalizedMessage format
-class ItchParser : public core::IParser {
+class ItchParser final : public core::IParser {
 public:
-  ItchParser() : messages_parsed_(0), parse_errors_(0) {}
+  ItchParser() : messages_parsed_(0), parse_errors_(0), unknown_orders_(0) {}
 
   size_t parse(const core::MessageView &raw_packet,
                core::NormalizedMessage *output,
@@ -42,12 +46,16 @@ public:
       const uint8_t *msg_data = data + offset + 2;
       size_t msg_size = msg_length - 2;
 
-      // Parse the message
-      if (parse_message(msg_data, msg_size, output[messages_parsed],
-                        raw_packet.timestamp)) {
-        messages_parsed++;
+      // A tracked replace or priced execution expands into two messages
+      if (orders_ && msg_size > 12 && expands(msg_data[12]) &&
+          max_messages - messages_parsed < 2) {
+        break;
       }
 
+      // Parse the message
+      messages_parsed += parse_message(
+          msg_data, msg_size, output + messages_parsed, raw_packet.timestamp);
+
       offset += msg_length;
       remaining -= msg_length;
     }
@@ -66,312 +74,520 @@ public:
   void reset() override {
     messages_parsed_ = 0;
     parse_errors_ = 0;
+    unknown_orders_ = 0;
     stock_map_.clear();
+    if (orders_) {
+      orders_->clear();
+    }
   }
 
-private:
-  bool parse_message(const uint8_t *data, size_t length,
-                     core::NormalizedMessage &output,
-                     core::Timestamp local_timestamp) noexcept {
-    if (length < 13) { // Minimum header size
-      parse_errors_++;
-      return false;
+  // Resolve a symbol to its stock locate code via the stock directory
+  bool find_instrument(const char *symbol,
+                       uint64_t &instrument_id) const override {
+    const std::string key = pad_symbol(symbol);
+    for (const auto &entry : stock_map_) {
+      if (entry.second == key) {
+        instrument_id = entry.first;
+        return true;
+      }
     }
+    return false;
+  }
 
-    // Read message type
-    MessageType msg_type = static_cast<MessageType>(data[12]);
+  // Preload a stock directory entry (e.g. from the daily locate code file)
+  // so symbols resolve before the feed's stock directory messages arrive
+  void add_stock(uint16_t stock_locate, const char *symbol) {
+    stock_map_[stock_locate] = pad_symbol(symbol);
+  }
 
-    // Parse based on message type
-    switch (msg_type) {
-    case MessageType::SYSTEM_EVENT:
-      return parse_system_event(data, length, output, local_timestamp);
+  // Keep the live orders so executions, cancels and deletes carry the
+  // order's price, side and remaining shares (FLAG_ENRICHED), which ITCH
+  // only sends on the add. Replaces of a known order become an ORDER_DELETE
+  // of the old reference followed by an ORDER_ADD of the new one, both
+  // flagged FLAG_REPLACE. Executions with a price ('C') of a known order
+  // become an ORDER_EXECUTE at the resting price followed by a TRADE at the
+  // print price, both flagged FLAG_PRINT_PRICE. capacity sizes the
+  // reference window (see OrderStore). Call before parsing starts
+  void enable_order_tracking(size_t capacity = OrderStore::DEFAULT_CAPACITY) {
+    orders_ = std::make_unique<OrderStore>(capacity);
+  }
 
-    case MessageType::STOCK_DIRECTORY:
-      return parse_stock_directory(data, length, output, local_timestamp);
+  bool order_tracking() const noexcept override { return orders_ != nullptr; }
 
-    case MessageType::ADD_ORDER:
-      return parse_add_order(data, length, output, local_timestamp);
+  // Live orders being tracked
+  size_t tracked_orders() const noexcept {
+    return orders_ ? orders_->size() : 0;
+  }
 
-    case MessageType::ADD_ORDER_MPID:
-      return parse_add_order_mpid(data, length, output, local_timestamp);
+  // Order events whose reference was not tracked (e.g. added before the
+  // parser joined the feed) - passed through without order state
+  uint64_t unknown_orders() const noexcept { return unknown_orders_; }
 
-    case MessageType::ORDER_EXECUTED:
-      return parse_order_executed(data, length, output, local_timestamp);
+  // Live orders lost because the order store's overflow was full; their
+  // later events count as unknown
+  uint64_t dropped_orders() const noexcept {
+    return orders_ ? orders_->dropped() : 0;
+  }
 
-    case MessageType::ORDER_EXECUTED_WITH_PRICE:
-      return parse_order_executed_with_price(data, length, output,
-                                             local_timestamp);
+private:
+  // ITCH symbols are 8 characters, right-padded with spaces
+  static std::string pad_symbol(const char *symbol) {
+    std::string padded(symbol, strnlen(symbol, 8));
+    padded.resize(8, ' ');
+    return padded;
+  }
 
-    case MessageType::ORDER_CANCEL:
-      return parse_order_cancel(data, length, output, local_timestamp);
+  // Decoder for one message type; the common header is already decoded
+  // and the length already checked against the type's size. Returns the
+  // messages written (a tracked replace or priced execution writes two)
+  using Handler = size_t (ItchParser::*)(
+      const uint8_t *data, core::NormalizedMessage *output) noexcept;
+
+  struct Entry {
+    Handler handler; // nullptr = type not decoded, skipped silently
+    uint8_t size;    // Minimum message length
+  };
+
+  using HandlerTable = std::array<Entry, 256>;
+
+  static constexpr HandlerTable make_handler_table() noexcept {
+    HandlerTable table{};
+    auto set = [&table](MessageType type, Handler handler) {
+      const auto index = static_cast<uint8_t>(type);
+      table[index].handler = handler;
+      table[index].size = static_cast<uint8_t>(get_message_size(type));
+    };
+
+    set(MessageType::SYSTEM_EVENT, &ItchParser::parse_system_event);
+    set(MessageType::STOCK_DIRECTORY, &ItchParser::parse_stock_directory);
+    set(MessageType::STOCK_TRADING_ACTION, &ItchParser::parse_trading_action);
+    set(MessageType::REG_SHO_RESTRICTION, &ItchParser::parse_reg_sho);
+    set(MessageType::MARKET_PARTICIPANT_POSITION,
+        &ItchParser::parse_participant_position);
+    set(MessageType::MWCB_DECLINE_LEVEL, &ItchParser::parse_mwcb_decline);
+    set(MessageType::MWCB_STATUS, &ItchParser::parse_mwcb_status);
+    set(MessageType::IPO_QUOTING_PERIOD, &ItchParser::parse_ipo_quoting);
+    set(MessageType::LULD_AUCTION_COLLAR, &ItchParser::parse_luld_collar);
+    set(MessageType::OPERATIONAL_HALT, &ItchParser::parse_operational_halt);
+    set(MessageType::ADD_ORDER, &ItchParser::parse_add_order);
+    set(MessageType::ADD_ORDER_MPID, &ItchParser::parse_add_order);
+    set(MessageType::ORDER_EXECUTED, &ItchParser::parse_order_executed);
+    set(MessageType::ORDER_EXECUTED_WITH_PRICE,
+        &ItchParser::parse_order_executed_with_price);
+    set(MessageType::ORDER_CANCEL, &ItchParser::parse_order_cancel);
+    set(MessageType::ORDER_DELETE, &ItchParser::parse_order_delete);
+    set(MessageType::ORDER_REPLACE, &ItchParser::parse_order_replace);
+    set(MessageType::TRADE, &ItchParser::parse_trade);
+    set(MessageType::CROSS_TRADE, &ItchParser::parse_cross_trade);
+    set(MessageType::BROKEN_TRADE, &ItchParser::parse_broken_trade);
+    set(MessageType::NOII, &ItchParser::parse_noii);
+    set(MessageType::RPII, &ItchParser::parse_rpii);
+    set(MessageType::DLCR_PRICE_DISCOVERY, &ItchParser::parse_dlcr);
+    return table;
+  }
 
-    case MessageType::ORDER_DELETE:
-      return parse_order_delete(data, length, output, local_timestamp);
+  // One indexed load replaces the per-message switch
+  static const Entry &handler_for(uint8_t type) noexcept {
+    static constexpr HandlerTable table = make_handler_table();
+    return table[type];
+  }
 
-    case MessageType::ORDER_REPLACE:
-      return parse_order_replace(data, length, output, local_timestamp);
+  static const uint8_t *bytes(const void *field) noexcept {
+    return static_cast<const uint8_t *>(field);
+  }
 
-    case MessageType::TRADE:
-      return parse_trade(data, length, output, local_timestamp);
+  // Returns the messages written to output (0 if skipped)
+  size_t parse_message(const uint8_t *data, size_t length,
+                       core::NormalizedMessage *output,
+                       core::Timestamp local_timestamp) noexcept {
+    if (length < 13) { // Minimum header size
+      parse_errors_++;
+      return 0;
+    }
 
-    default:
+    const Entry &entry = handler_for(data[12]);
+    if (entry.handler == nullptr) {
       // Unsupported message type (not an error, just skip)
-      return false;
+      return 0;
+    }
+    if (length < entry.size) {
+      return 0;
     }
+
+    // Fields every message type shares
+    const auto *header = reinterpret_cast<const MessageHeader *>(data);
+    *output = core::NormalizedMessage{};
+    output->instrument_id = read_u16_be(bytes(&header->stock_locate));
+    output->sequence = read_u16_be(bytes(&header->tracking_number));
+    output->timestamp = read_u64_be(bytes(&header->timestamp));
+    output->local_timestamp = local_timestamp;
+    output->source_type = header->message_type;
+
+    return (this->*entry.handler)(data, output);
   }
 
-  bool parse_system_event(const uint8_t *data, size_t length,
-                          core::NormalizedMessage &output,
-                          core::Timestamp local_timestamp) noexcept {
-    if (length < SystemEventMessage::SIZE)
-      return false;
+  // Tracked state of an order, nullptr if tracking is off or it is unknown
+  OrderState *find_order(uint64_t ref) noexcept {
+    if (!orders_) {
+      return nullptr;
+    }
+    OrderState *order = orders_->find(ref);
+    if (order == nullptr) {
+      unknown_orders_++;
+    }
+    return order;
+  }
 
-    const auto *msg = reinterpret_cast<const SystemEventMessage *>(data);
+  // Take shares off a tracked order (execution or cancel) and fill in its
+  // state; the order is dropped once nothing remains
+  void reduce_order(core::NormalizedMessage *output, uint32_t shares) noexcept {
+    OrderState *order = find_order(output->order_id);
+    if (order == nullptr) {
+      return;
+    }
+    order->remaining -= shares < order->remaining ? shares : order->remaining;
+    output->side = order->side;
+    output->price = order->price;
+    output->remaining_quantity = order->remaining;
+    output->flags |= core::NormalizedMessage::FLAG_ENRICHED;
+    if (order->remaining == 0) {
+      orders_->remove(output->order_id);
+    }
+  }
 
-    output.type = core::NormalizedMessage::Type::SYSTEM_EVENT;
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.instrument_id = 0; // System events are not instrument-specific
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
+  // Message types that may write two messages with order tracking on
+  static bool expands(uint8_t type) noexcept {
+    return type == static_cast<uint8_t>(MessageType::ORDER_REPLACE) ||
+           type == static_cast<uint8_t>(MessageType::ORDER_EXECUTED_WITH_PRICE);
+  }
 
-    return true;
+  static uint8_t side_of(uint8_t indicator) noexcept {
+    return indicator == static_cast<uint8_t>(Side::BUY) ? 0 : 1;
   }
-  bool parse_stock_directory(const uint8_t *data, size_t length,
-                             core::NormalizedMessage &output,
-                             core::Timestamp local_timestamp) noexcept {
-    if (length < StockDirectoryMessage::SIZE)
-      return false;
 
-    const auto *msg = reinterpret_cast<const StockDirectoryMessage *>(data);
+  // Administrative and status messages. Nothing here touches a book; the
+  // protocol code byte goes in output->code and any numeric payload in the
+  // general fields noted per handler
+
+  // code = event code
+  size_t parse_system_event(const uint8_t *data,
+                            core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const SystemEventMessage *>(data);
+    output->type = core::NormalizedMessage::Type::SYSTEM_EVENT;
+    output->code = msg->event_code;
+    return 1;
+  }
 
-    // Extract stock locate and stock symbol
-    uint16_t stock_locate =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
+  // code = market category, quantity = round lot size
+  size_t parse_stock_directory(const uint8_t *data,
+                               core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const StockDirectoryMessage *>(data);
 
     // Store mapping for later use
-    stock_map_[stock_locate] = std::string(msg->stock, 8);
+    stock_map_[static_cast<uint16_t>(output->instrument_id)] =
+        std::string(msg->stock, 8);
 
-    // Generate a system event for new stock
-    output.type = core::NormalizedMessage::Type::SYSTEM_EVENT;
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.instrument_id = stock_locate;
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
+    output->type = core::NormalizedMessage::Type::SYSTEM_EVENT;
+    output->code = msg->market_category;
+    output->quantity = read_u32_be(bytes(&msg->round_lot_size));
+    return 1;
+  }
 
-    return true;
+  // code = trading state, order_id = 4-character reason code (big-endian)
+  size_t parse_trading_action(const uint8_t *data,
+                              core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const StockTradingActionMessage *>(data);
+    output->type = core::NormalizedMessage::Type::STATUS;
+    output->code = msg->trading_state;
+    output->order_id = read_u32_be(bytes(msg->reason));
+    return 1;
   }
 
-  bool parse_add_order(const uint8_t *data, size_t length,
-                       core::NormalizedMessage &output,
-                       core::Timestamp local_timestamp) noexcept {
-    if (length < AddOrderMessage::SIZE)
-      return false;
+  // code = Reg SHO action
+  size_t parse_reg_sho(const uint8_t *data,
+                       core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const RegSHORestrictionMessage *>(data);
+    output->type = core::NormalizedMessage::Type::STATUS;
+    output->code = msg->reg_sho_action;
+    return 1;
+  }
+
+  // code = participant state, order_id = 4-character MPID (big-endian)
+  size_t parse_participant_position(const uint8_t *data,
+                                    core::NormalizedMessage *output) noexcept {
+    const auto *msg =
+        reinterpret_cast<const MarketParticipantPositionMessage *>(data);
+    output->type = core::NormalizedMessage::Type::STATUS;
+    output->code = msg->market_participant_state;
+    output->order_id = read_u32_be(bytes(msg->mpid));
+    return 1;
+  }
+
+  // Levels 1/2/3 in price/order_id/quantity, rescaled from 8 implied
+  // decimals to the engine's 4
+  size_t parse_mwcb_decline(const uint8_t *data,
+                            core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const MWCBDeclineLevelMessage *>(data);
+    output->type = core::NormalizedMessage::Type::SYSTEM_EVENT;
+    output->price =
+        static_cast<int64_t>(read_u64_be(bytes(&msg->level1)) / 10000);
+    output->order_id = read_u64_be(bytes(&msg->level2)) / 10000;
+    output->quantity = read_u64_be(bytes(&msg->level3)) / 10000;
+    return 1;
+  }
+
+  // code = breached level
+  size_t parse_mwcb_status(const uint8_t *data,
+                           core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const MWCBStatusMessage *>(data);
+    output->type = core::NormalizedMessage::Type::SYSTEM_EVENT;
+    output->code = msg->breached_level;
+    return 1;
+  }
 
+  // code = release qualifier, price = IPO price, order_id = release time
+  size_t parse_ipo_quoting(const uint8_t *data,
+                           core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const IPOQuotingPeriodMessage *>(data);
+    output->type = core::NormalizedMessage::Type::STATUS;
+    output->code = msg->release_qualifier;
+    output->price = read_u32_be(bytes(&msg->ipo_price));
+    output->order_id = read_u32_be(bytes(&msg->release_time));
+    return 1;
+  }
+
+  // price = reference price, order_id = upper << 32 | lower collar,
+  // quantity = extension count
+  size_t parse_luld_collar(const uint8_t *data,
+                           core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const LULDAuctionCollarMessage *>(data);
+    output->type = core::NormalizedMessage::Type::STATUS;
+    output->price = read_u32_be(bytes(&msg->reference_price));
+    output->order_id =
+        (static_cast<uint64_t>(read_u32_be(bytes(&msg->upper_price))) << 32) |
+        read_u32_be(bytes(&msg->lower_price));
+    output->quantity = read_u32_be(bytes(&msg->extension));
+    return 1;
+  }
+
+  // code = halt action, order_id = market code
+  size_t parse_operational_halt(const uint8_t *data,
+                                core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const OperationalHaltMessage *>(data);
+    output->type = core::NormalizedMessage::Type::STATUS;
+    output->code = msg->halt_action;
+    output->order_id = msg->market_code;
+    return 1;
+  }
+
+  // Order book messages
+
+  // Handles 'A' and 'F' - the MPID attribution is not carried over
+  size_t parse_add_order(const uint8_t *data,
+                         core::NormalizedMessage *output) noexcept {
     const auto *msg = reinterpret_cast<const AddOrderMessage *>(data);
+    output->type = core::NormalizedMessage::Type::ORDER_ADD;
+    output->order_id = read_u64_be(bytes(&msg->order_reference_number));
+    output->side = side_of(msg->buy_sell_indicator);
+    output->quantity = read_u32_be(bytes(&msg->shares));
+    output->price = read_u32_be(bytes(&msg->price));
+    output->remaining_quantity = static_cast<uint32_t>(output->quantity);
+    if (orders_) {
+      orders_->add(output->order_id,
+                   {static_cast<uint32_t>(output->price),
+                    output->remaining_quantity, output->side});
+    }
+    return 1;
+  }
 
-    output.type = core::NormalizedMessage::Type::ORDER_ADD;
-    output.instrument_id =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
-    output.order_id = read_u64_be(
-        reinterpret_cast<const uint8_t *>(&msg->order_reference_number));
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.side =
-        (msg->buy_sell_indicator == static_cast<uint8_t>(Side::BUY)) ? 0 : 1;
-    output.quantity =
-        read_u32_be(reinterpret_cast<const uint8_t *>(&msg->shares));
-    output.price = read_u32_be(reinterpret_cast<const uint8_t *>(&msg->price));
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
-
-    return true;
-  }
-
-  bool parse_add_order_mpid(const uint8_t *data, size_t length,
-                            core::NormalizedMessage &output,
-                            core::Timestamp local_timestamp) noexcept {
-    if (length < AddOrderMPIDMessage::SIZE)
-      return false;
-
-    const auto *msg = reinterpret_cast<const AddOrderMPIDMessage *>(data);
-
-    output.type = core::NormalizedMessage::Type::ORDER_ADD;
-    output.instrument_id =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
-    output.order_id = read_u64_be(
-        reinterpret_cast<const uint8_t *>(&msg->order_reference_number));
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.side =
-        (msg->buy_sell_indicator == static_cast<uint8_t>(Side::BUY)) ? 0 : 1;
-    output.quantity =
-        read_u32_be(reinterpret_cast<const uint8_t *>(&msg->shares));
-    output.price = read_u32_be(reinterpret_cast<const uint8_t *>(&msg->price));
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
-
-    return true;
-  }
-
-  bool parse_order_executed(const uint8_t *data, size_t length,
-                            core::NormalizedMessage &output,
-                            core::Timestamp local_timestamp) noexcept {
-    if (length < OrderExecutedMessage::SIZE)
-      return false;
+  // Order events below carry only the reference; with tracking on they get
+  // the order's side, price and remaining shares
 
+  size_t parse_order_executed(const uint8_t *data,
+                              core::NormalizedMessage *output) noexcept {
     const auto *msg = reinterpret_cast<const OrderExecutedMessage *>(data);
+    output->type = core::NormalizedMessage::Type::ORDER_EXECUTE;
+    output->order_id = read_u64_be(bytes(&msg->order_reference_number));
+    output->quantity = read_u32_be(bytes(&msg->executed_shares));
+    reduce_order(output, static_cast<uint32_t>(output->quantity));
+    return 1;
+  }
 
-    output.type = core::NormalizedMessage::Type::ORDER_EXECUTE;
-    output.instrument_id =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
-    output.order_id = read_u64_be(
-        reinterpret_cast<const uint8_t *>(&msg->order_reference_number));
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.quantity =
-        read_u32_be(reinterpret_cast<const uint8_t *>(&msg->executed_shares));
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
-
-    return true;
-  }
-
-  bool
-  parse_order_executed_with_price(const uint8_t *data, size_t length,
-                                  core::NormalizedMessage &output,
-                                  core::Timestamp local_timestamp) noexcept {
-    if (length < OrderExecutedWithPriceMessage::SIZE)
-      return false;
-
+  // code = printable flag. An untracked execution carries the print price;
+  // a tracked one carries the resting price, and a TRADE with the print
+  // price (order_id = match number) follows it (room for both is checked
+  // in parse())
+  size_t
+  parse_order_executed_with_price(const uint8_t *data,
+                                  core::NormalizedMessage *output) noexcept {
     const auto *msg =
         reinterpret_cast<const OrderExecutedWithPriceMessage *>(data);
+    output->type = core::NormalizedMessage::Type::ORDER_EXECUTE;
+    output->code = msg->printable;
+    output->order_id = read_u64_be(bytes(&msg->order_reference_number));
+    output->quantity = read_u32_be(bytes(&msg->executed_shares));
+    const int64_t print_price = read_u32_be(bytes(&msg->execution_price));
+    reduce_order(output, static_cast<uint32_t>(output->quantity));
+    if (!(output->flags & core::NormalizedMessage::FLAG_ENRICHED)) {
+      output->price = print_price;
+      return 1;
+    }
 
-    output.type = core::NormalizedMessage::Type::ORDER_EXECUTE;
-    output.instrument_id =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
-    output.order_id = read_u64_be(
-        reinterpret_cast<const uint8_t *>(&msg->order_reference_number));
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.quantity =
-        read_u32_be(reinterpret_cast<const uint8_t *>(&msg->executed_shares));
-    output.price =
-        read_u32_be(reinterpret_cast<const uint8_t *>(&msg->execution_price));
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
-
-    return true;
-  }
-
-  bool parse_order_cancel(const uint8_t *data, size_t length,
-                          core::NormalizedMessage &output,
-                          core::Timestamp local_timestamp) noexcept {
-    if (length < OrderCancelMessage::SIZE)
-      return false;
+    output->flags |= core::NormalizedMessage::FLAG_PRINT_PRICE;
+    core::NormalizedMessage &print = output[1];
+    print = output[0];
+    print.type = core::NormalizedMessage::Type::TRADE;
+    print.order_id = read_u64_be(bytes(&msg->match_number));
+    print.price = print_price;
+    return 2;
+  }
 
+  size_t parse_order_cancel(const uint8_t *data,
+                            core::NormalizedMessage *output) noexcept {
     const auto *msg = reinterpret_cast<const OrderCancelMessage *>(data);
+    output->type = core::NormalizedMessage::Type::ORDER_MODIFY;
+    output->order_id = read_u64_be(bytes(&msg->order_reference_number));
+    output->quantity = read_u32_be(bytes(&msg->cancelled_shares));
+    reduce_order(output, static_cast<uint32_t>(output->quantity));
+    return 1;
+  }
 
-    output.type = core::NormalizedMessage::Type::ORDER_MODIFY;
-    output.instrument_id =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
-    output.order_id = read_u64_be(
-        reinterpret_cast<const uint8_t *>(&msg->order_reference_number));
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.quantity =
-        read_u32_be(reinterpret_cast<const uint8_t *>(&msg->cancelled_shares));
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
-
-    return true;
+  size_t parse_order_delete(const uint8_t *data,
+                            core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const OrderDeleteMessage *>(data);
+    output->type = core::NormalizedMessage::Type::ORDER_DELETE;
+    output->order_id = read_u64_be(bytes(&msg->order_reference_number));
+    const OrderState *order = find_order(output->order_id);
+    if (order != nullptr) {
+      // quantity = shares taken off the book
+      output->side = order->side;
+      output->price = order->price;
+      output->quantity = order->remaining;
+      output->flags |= core::NormalizedMessage::FLAG_ENRICHED;
+      orders_->remove(output->order_id);
+    }
+    return 1;
   }
 
-  bool parse_order_delete(const uint8_t *data, size_t length,
-                          core::NormalizedMessage &output,
-                          core::Timestamp local_timestamp) noexcept {
-    if (length < OrderDeleteMessage::SIZE)
-      return false;
+  size_t parse_order_replace(const uint8_t *data,
+                             core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const OrderReplaceMessage *>(data);
+    output->type = core::NormalizedMessage::Type::ORDER_MODIFY;
+    output->order_id = read_u64_be(bytes(&msg->new_order_reference_number));
+    output->quantity = read_u32_be(bytes(&msg->shares));
+    output->price = read_u32_be(bytes(&msg->price));
+    output->remaining_quantity = static_cast<uint32_t>(output->quantity);
+
+    const uint64_t original =
+        read_u64_be(bytes(&msg->original_order_reference_number));
+    const OrderState *order = find_order(original);
+    if (order == nullptr) {
+      return 1; // Untracked: a single ORDER_MODIFY under the new reference
+    }
 
-    const auto *msg = reinterpret_cast<const OrderDeleteMessage *>(data);
+    // Delete of the original order, then an add of the new one on the same
+    // side (room for both is checked in parse())
+    const uint8_t flags = core::NormalizedMessage::FLAG_ENRICHED |
+                          core::NormalizedMessage::FLAG_REPLACE;
+    core::NormalizedMessage &added = output[1];
+    added = output[0];
+    added.type = core::NormalizedMessage::Type::ORDER_ADD;
+    added.side = order->side;
+    added.flags = flags;
+
+    output->type = core::NormalizedMessage::Type::ORDER_DELETE;
+    output->order_id = original;
+    output->side = order->side;
+    output->price = order->price;
+    output->quantity = order->remaining;
+    output->remaining_quantity = 0;
+    output->flags = flags;
+
+    orders_->remove(original);
+    orders_->add(added.order_id,
+                 {static_cast<uint32_t>(added.price), added.remaining_quantity,
+                  added.side});
+    return 2;
+  }
 
-    output.type = core::NormalizedMessage::Type::ORDER_DELETE;
-    output.instrument_id =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
-    output.order_id = read_u64_be(
-        reinterpret_cast<const uint8_t *>(&msg->order_reference_number));
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
+  // Trade and auction messages
 
-    return true;
+  size_t parse_trade(const uint8_t *data,
+                     core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const TradeMessage *>(data);
+    output->type = core::NormalizedMessage::Type::TRADE;
+    output->order_id = read_u64_be(bytes(&msg->order_reference_number));
+    output->side = side_of(msg->buy_sell_indicator);
+    output->quantity = read_u32_be(bytes(&msg->shares));
+    output->price = read_u32_be(bytes(&msg->price));
+    return 1;
   }
 
-  bool parse_order_replace(const uint8_t *data, size_t length,
-                           core::NormalizedMessage &output,
-                           core::Timestamp local_timestamp) noexcept {
-    if (length < OrderReplaceMessage::SIZE)
-      return false;
+  // code = cross type, order_id = match number
+  size_t parse_cross_trade(const uint8_t *data,
+                           core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const CrossTradeMessage *>(data);
+    output->type = core::NormalizedMessage::Type::TRADE;
+    output->code = msg->cross_type;
+    output->order_id = read_u64_be(bytes(&msg->match_number));
+    output->quantity = read_u64_be(bytes(&msg->shares));
+    output->price = read_u32_be(bytes(&msg->cross_price));
+    return 1;
+  }
 
-    const auto *msg = reinterpret_cast<const OrderReplaceMessage *>(data);
+  // order_id = match number of the broken trade
+  size_t parse_broken_trade(const uint8_t *data,
+                            core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const BrokenTradeMessage *>(data);
+    output->type = core::NormalizedMessage::Type::TRADE_BREAK;
+    output->order_id = read_u64_be(bytes(&msg->match_number));
+    return 1;
+  }
 
-    output.type = core::NormalizedMessage::Type::ORDER_MODIFY;
-    output.instrument_id =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
-    output.order_id = read_u64_be(
-        reinterpret_cast<const uint8_t *>(&msg->new_order_reference_number));
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.quantity =
-        read_u32_be(reinterpret_cast<const uint8_t *>(&msg->shares));
-    output.price = read_u32_be(reinterpret_cast<const uint8_t *>(&msg->price));
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
-
-    return true;
-  }
-
-  bool parse_trade(const uint8_t *data, size_t length,
-                   core::NormalizedMessage &output,
-                   core::Timestamp local_timestamp) noexcept {
-    if (length < TradeMessage::SIZE)
-      return false;
+  // quantity = imbalance shares, order_id = paired shares, code = direction,
+  // price = current reference price. side is only meaningful for 'B'/'S';
+  // 'N' (no imbalance) and 'O' (insufficient orders) leave it 0, so check
+  // code
+  size_t parse_noii(const uint8_t *data,
+                    core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const NOIIMessage *>(data);
+    output->type = core::NormalizedMessage::Type::IMBALANCE;
+    output->code = msg->imbalance_direction;
+    if (msg->imbalance_direction == static_cast<uint8_t>(Side::SELL)) {
+      output->side = 1;
+    }
+    output->quantity = read_u64_be(bytes(&msg->imbalance_shares));
+    output->order_id = read_u64_be(bytes(&msg->paired_shares));
+    output->price = read_u32_be(bytes(&msg->current_reference_price));
+    return 1;
+  }
 
-    const auto *msg = reinterpret_cast<const TradeMessage *>(data);
+  // code = interest flag
+  size_t parse_rpii(const uint8_t *data,
+                    core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const RPIIMessage *>(data);
+    output->type = core::NormalizedMessage::Type::STATUS;
+    output->code = msg->interest_flag;
+    return 1;
+  }
 
-    output.type = core::NormalizedMessage::Type::TRADE;
-    output.instrument_id =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->stock_locate));
-    output.order_id = read_u64_be(
-        reinterpret_cast<const uint8_t *>(&msg->order_reference_number));
-    output.timestamp =
-        read_u64_be(reinterpret_cast<const uint8_t *>(&msg->timestamp));
-    output.local_timestamp = local_timestamp;
-    output.side =
-        (msg->buy_sell_indicator == static_cast<uint8_t>(Side::BUY)) ? 0 : 1;
-    output.quantity =
-        read_u32_be(reinterpret_cast<const uint8_t *>(&msg->shares));
-    output.price = read_u32_be(reinterpret_cast<const uint8_t *>(&msg->price));
-    output.sequence =
-        read_u16_be(reinterpret_cast<const uint8_t *>(&msg->tracking_number));
-
-    return true;
+  // code = open eligibility, price = near execution price
+  size_t parse_dlcr(const uint8_t *data,
+                    core::NormalizedMessage *output) noexcept {
+    const auto *msg = reinterpret_cast<const DLCRPriceDiscoveryMessage *>(data);
+    output->type = core::NormalizedMessage::Type::STATUS;
+    output->code = msg->open_eligibility_status;
+    output->price = read_u32_be(bytes(&msg->near_execution_price));
+    return 1;
   }
 
   // Statistics
   mutable uint64_t messages_parsed_;
   mutable uint64_t parse_errors_;
+  uint64_t unknown_orders_;
+
+  // Live orders, when tracking is enabled
+  std::unique_ptr<OrderStore> orders_;
 
   // Stock locate -> Symbol mapping
   std::unordered_map<uint16_t, std::string> stock_map_;
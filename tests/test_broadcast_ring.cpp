@@ -0,0 +1,189 @@
+#include "../core/distribution/broadcast_ring.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace hft::core;
+
+// Test 1: Basic publish/read
+void test_basic_operations() {
+  BroadcastRing<uint64_t, 16> ring;
+  BroadcastRing<uint64_t, 16>::Reader reader(ring);
+  uint64_t value = 0;
+
+  assert(ring.capacity() == 16);
+  assert(!reader.read(value));
+  assert(reader.lag() == 0);
+
+  ring.publish(42);
+  assert(ring.cursor() == 1);
+  assert(reader.lag() == 1);
+
+  assert(reader.read(value));
+  assert(value == 42);
+  assert(reader.lag() == 0);
+  assert(!reader.read(value));
+
+  std::cout << "✓ Basic operations test passed\n";
+}
+
+// Test 2: Every reader sees every element at its own pace
+void test_multiple_readers() {
+  BroadcastRing<uint64_t, 64> ring;
+  BroadcastRing<uint64_t, 64>::Reader fast(ring);
+  BroadcastRing<uint64_t, 64>::Reader slow(ring);
+  uint64_t value = 0;
+
+  for (uint64_t i = 0; i < 10; ++i) {
+    ring.publish(i);
+  }
+
+  for (uint64_t i = 0; i < 10; ++i) {
+    assert(fast.read(value));
+    assert(value == i);
+  }
+  assert(fast.lag() == 0);
+  assert(slow.lag() == 10);
+
+  for (uint64_t i = 0; i < 10; ++i) {
+    assert(slow.read(value));
+    assert(value == i);
+  }
+  assert(slow.lag() == 0);
+
+  // Readers attached later only see new data
+  BroadcastRing<uint64_t, 64>::Reader late(ring);
+  assert(!late.read(value));
+  ring.publish(99);
+  assert(late.read(value) && value == 99);
+
+  std::cout << "✓ Multiple readers test passed\n";
+}
+
+// Test 3: Claim/commit writes in place
+void test_claim_commit() {
+  BroadcastRing<uint64_t, 16> ring;
+  BroadcastRing<uint64_t, 16>::Reader reader(ring);
+  uint64_t value = 0;
+
+  uint64_t *slot = ring.claim();
+  *slot = 7;
+  assert(!reader.read(value)); // Not visible until commit
+  ring.commit();
+  assert(reader.read(value) && value == 7);
+
+  std::cout << "✓ Claim/commit test passed\n";
+}
+
+// Test 4: A lapped reader detects overrun and skips ahead
+void test_overrun() {
+  BroadcastRing<uint64_t, 16> ring;
+  BroadcastRing<uint64_t, 16>::Reader reader(ring);
+  uint64_t value = 0;
+
+  // The writer never blocks, even with a reader that has not read anything
+  for (uint64_t i = 0; i < 40; ++i) {
+    ring.publish(i);
+  }
+  assert(reader.lag() == 40);
+
+  // Everything older than the newest element is gone
+  assert(!reader.read(value));
+  assert(reader.lost() == 40);
+  assert(reader.lag() == 0);
+
+  // The reader carries on with new data
+  ring.publish(40);
+  assert(reader.read(value) && value == 40);
+  assert(reader.lost() == 40);
+
+  // Exactly one lap behind is still readable
+  for (uint64_t i = 41; i < 41 + 16; ++i) {
+    ring.publish(i);
+  }
+  for (uint64_t i = 41; i < 41 + 16; ++i) {
+    assert(reader.read(value) && value == i);
+  }
+  assert(reader.lost() == 40);
+
+  std::cout << "✓ Overrun test passed\n";
+}
+
+// Test 5: Concurrent writer and readers - values arrive in order, and
+// whatever a reader misses is accounted for as lost
+void test_thread_safety() {
+  static constexpr uint64_t NUM_ITEMS = 1000000;
+  BroadcastRing<uint64_t, 1024> ring;
+  std::vector<std::unique_ptr<BroadcastRing<uint64_t, 1024>::Reader>> readers;
+  for (int i = 0; i < 2; ++i) {
+    readers.push_back(
+        std::make_unique<BroadcastRing<uint64_t, 1024>::Reader>(ring));
+  }
+
+  std::atomic<int> finished{0};
+  std::vector<std::thread> threads;
+  for (auto &reader : readers) {
+    threads.emplace_back([&reader, &finished]() {
+      uint64_t value = 0;
+      uint64_t received = 0;
+      uint64_t last = 0;
+      bool first = true;
+
+      while (true) {
+        if (!reader->read(value)) {
+          std::this_thread::yield();
+          continue;
+        }
+        if (value == UINT64_MAX) {
+          break; // End marker
+        }
+        assert(first || value > last);
+        first = false;
+        last = value;
+        received++;
+      }
+
+      assert(received + reader->lost() >= NUM_ITEMS);
+      finished.fetch_add(1);
+    });
+  }
+
+  for (uint64_t i = 0; i < NUM_ITEMS; ++i) {
+    ring.publish(i);
+    if ((i & 1023) == 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Keep publishing the end marker - a lapped reader may skip one
+  while (finished.load() < static_cast<int>(readers.size())) {
+    ring.publish(UINT64_MAX);
+    std::this_thread::yield();
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::cout << "✓ Thread safety test passed (1M items, 2 readers)\n";
+}
+
+int main() {
+  std::cout << "Running Broadcast Ring Tests\n";
+  std::cout << "============================\n\n";
+
+  try {
+    test_basic_operations();
+    test_multiple_readers();
+    test_claim_commit();
+    test_overrun();
+    test_thread_safety();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
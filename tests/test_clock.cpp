@@ -0,0 +1,110 @@
+#include "../core/clock.hpp"
+#include "../core/types.hpp"
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace hft::core;
+
+static uint64_t steady_now() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+static uint64_t distance(uint64_t a, uint64_t b) {
+  return a > b ? a - b : b - a;
+}
+
+// Test 1: Readings track steady_clock and never go backwards
+void test_tracks_steady_clock() {
+  std::cout << "  TSC in use: " << (TscClock::uses_tsc() ? "yes" : "no")
+            << ", ticks/ns: " << TscClock::ticks_per_ns() << "\n";
+
+  // Same clock domain - within a millisecond even on a busy machine
+  assert(distance(TscClock::now(), steady_now()) < 1000000);
+
+  uint64_t last = TscClock::now();
+  for (int i = 0; i < 1000000; ++i) {
+    const uint64_t now = TscClock::now();
+    assert(now >= last);
+    last = now;
+  }
+
+  // Elapsed time agrees with steady_clock
+  const uint64_t steady_start = steady_now();
+  const uint64_t tsc_start = TscClock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const uint64_t steady_elapsed = steady_now() - steady_start;
+  const uint64_t tsc_elapsed = TscClock::now() - tsc_start;
+  assert(distance(steady_elapsed, tsc_elapsed) < steady_elapsed / 100 + 100000);
+
+  std::cout << "✓ Tracks steady clock test passed\n";
+}
+
+// Test 2: Raw ticks convert later to the same time
+void test_deferred_conversion() {
+  const uint64_t before = TscClock::now();
+  const uint64_t ticks = TscClock::ticks();
+  const uint64_t after = TscClock::now();
+
+  const uint64_t converted = TscClock::to_nanos(ticks);
+  assert(converted >= before && converted <= after);
+
+  std::cout << "✓ Deferred conversion test passed\n";
+}
+
+// Test 3: Recalibration keeps the clock continuous and close to steady
+void test_recalibration() {
+  uint64_t last = TscClock::now();
+  for (int round = 0; round < 20; ++round) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    TscClock::recalibrate();
+    const uint64_t now = TscClock::now();
+    assert(now >= last);
+    last = now;
+  }
+
+  // A tick read before recalibrating still converts sensibly after it
+  const uint64_t early = TscClock::ticks();
+  const uint64_t early_nanos = TscClock::to_nanos(early);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  TscClock::recalibrate();
+  assert(distance(TscClock::to_nanos(early), early_nanos) < 100000);
+
+  assert(distance(TscClock::now(), steady_now()) < 1000000);
+
+  std::cout << "✓ Recalibration test passed\n";
+}
+
+// Test 4: get_timestamp() stays in the same domain whichever clock backs it
+void test_engine_timestamp() {
+  assert(distance(get_timestamp(), steady_now()) < 1000000);
+
+#ifdef HFT_TSC_CLOCK
+  std::cout << "✓ Engine timestamp test passed (TSC clock)\n";
+#else
+  std::cout << "✓ Engine timestamp test passed (steady clock)\n";
+#endif
+}
+
+int main() {
+  std::cout << "Running Clock Tests\n";
+  std::cout << "===================\n\n";
+
+  try {
+    test_tracks_steady_clock();
+    test_deferred_conversion();
+    test_recalibration();
+    test_engine_timestamp();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
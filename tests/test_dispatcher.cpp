@@ -0,0 +1,763 @@
+#include "../core/distribution/dispatcher.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace hft::core;
+
+// Counts messages and checks they arrive in sequence order
+struct CountingSink {
+  std::atomic<uint64_t> received{0};
+  std::atomic<bool> in_order{true};
+  uint32_t next_sequence{0};
+
+  bool on_message(const NormalizedMessage &msg) {
+    if (msg.sequence != next_sequence) {
+      in_order.store(false);
+    }
+    next_sequence = msg.sequence + 1;
+    received.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+};
+
+static bool wait_for(const std::atomic<uint64_t> &counter, uint64_t target) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (counter.load() < target) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+// Every subscriber receives every message, in order, in the given mode
+static void check_fan_out(DispatchMode mode,
+                          ConsumerThreads threads = ConsumerThreads::SHARED) {
+  static constexpr size_t NUM_SUBSCRIBERS = 3;
+  static constexpr uint32_t NUM_MESSAGES = 100000;
+
+  DispatcherConfig config;
+  config.mode = mode;
+  config.threads = threads;
+  Dispatcher dispatcher(config);
+  assert(dispatcher.mode() == mode);
+
+  CountingSink sinks[NUM_SUBSCRIBERS];
+  for (auto &sink : sinks) {
+    dispatcher.add_subscriber(make_subscriber(
+        "sink", [&sink](const NormalizedMessage &msg) {
+          return sink.on_message(msg);
+        }));
+  }
+  assert(dispatcher.subscriber_count() == NUM_SUBSCRIBERS);
+
+  dispatcher.start();
+  assert(dispatcher.thread_count() ==
+         (threads == ConsumerThreads::PER_SUBSCRIBER ? NUM_SUBSCRIBERS : 1));
+
+  NormalizedMessage msg;
+  msg.type = NormalizedMessage::Type::TRADE;
+  for (uint32_t seq = 0; seq < NUM_MESSAGES; ++seq) {
+    msg.sequence = seq;
+    msg.local_timestamp = get_timestamp();
+    dispatcher.dispatch(msg);
+
+    // Pace the producer so neither mode has to drop
+    while (dispatcher.subscriber_stats(0).lag > 1024) {
+      std::this_thread::yield();
+    }
+  }
+
+  for (auto &sink : sinks) {
+    const bool delivered = wait_for(sink.received, NUM_MESSAGES);
+    assert(delivered);
+    (void)delivered;
+  }
+  dispatcher.stop();
+
+  assert(dispatcher.get_stats().messages_dispatched == NUM_MESSAGES);
+  for (size_t i = 0; i < NUM_SUBSCRIBERS; ++i) {
+    assert(sinks[i].in_order.load());
+    SubscriberStats stats = dispatcher.subscriber_stats(i);
+    assert(stats.messages_delivered == NUM_MESSAGES);
+    assert(stats.messages_dropped == 0);
+    assert(stats.lag == 0);
+
+    LatencyHistogram histogram;
+    assert(dispatcher.delivery_histogram(i, histogram));
+    assert(histogram.count() == NUM_MESSAGES);
+    assert(histogram.percentile(50) <= histogram.max());
+    assert(stats.min_latency_ns <= stats.max_latency_ns);
+    assert(stats.avg_latency_ns() > 0.0);
+  }
+}
+
+// Test 1: Queue-per-subscriber mode
+void test_queue_mode() {
+  check_fan_out(DispatchMode::QUEUE_PER_SUBSCRIBER);
+  std::cout << "✓ Queue mode test passed\n";
+}
+
+// Test 2: Broadcast ring mode
+void test_broadcast_mode() {
+  check_fan_out(DispatchMode::BROADCAST);
+  std::cout << "✓ Broadcast mode test passed\n";
+}
+
+// Test 3: Consumer thread per subscriber, in both fan-out modes
+void test_thread_per_subscriber() {
+  check_fan_out(DispatchMode::QUEUE_PER_SUBSCRIBER,
+                ConsumerThreads::PER_SUBSCRIBER);
+  check_fan_out(DispatchMode::BROADCAST, ConsumerThreads::PER_SUBSCRIBER);
+  std::cout << "✓ Thread per subscriber test passed\n";
+}
+
+// Test 4: Subscribers in the same group share a thread
+void test_thread_groups() {
+  DispatcherConfig config;
+  config.threads = ConsumerThreads::PER_GROUP;
+  Dispatcher dispatcher(config);
+
+  std::thread::id seen[4];
+  for (int i = 0; i < 4; ++i) {
+    SubscriberOptions options;
+    options.group = i < 3 ? 7 : 1; // Three in group 7, one alone
+    dispatcher.add_subscriber(
+        make_subscriber("grouped",
+                        [&seen, i](const NormalizedMessage &) {
+                          seen[i] = std::this_thread::get_id();
+                          return true;
+                        }),
+        options);
+  }
+
+  dispatcher.start();
+  assert(dispatcher.thread_count() == 2);
+
+  NormalizedMessage msg;
+  dispatcher.dispatch(msg);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (dispatcher.subscriber_stats(3).messages_delivered == 0 ||
+         dispatcher.subscriber_stats(0).messages_delivered == 0 ||
+         dispatcher.subscriber_stats(1).messages_delivered == 0 ||
+         dispatcher.subscriber_stats(2).messages_delivered == 0) {
+    assert(std::chrono::steady_clock::now() < deadline);
+    std::this_thread::yield();
+  }
+  dispatcher.stop();
+  assert(dispatcher.thread_count() == 0);
+
+  assert(seen[0] == seen[1] && seen[1] == seen[2]);
+  assert(seen[0] != seen[3]);
+
+  std::cout << "✓ Thread groups test passed\n";
+}
+
+// Test 5: A slow subscriber on its own thread does not hold up a fast one
+void test_slow_subscriber_isolation() {
+  static constexpr uint32_t NUM_MESSAGES = 50;
+
+  DispatcherConfig config;
+  config.threads = ConsumerThreads::PER_SUBSCRIBER;
+  Dispatcher dispatcher(config);
+
+  std::atomic<uint64_t> fast_received{0};
+  std::atomic<uint64_t> slow_received{0};
+  dispatcher.add_subscriber(make_subscriber(
+      "slow", [&slow_received](const NormalizedMessage &) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        slow_received.fetch_add(1);
+        return true;
+      }));
+  dispatcher.add_subscriber(make_subscriber(
+      "fast", [&fast_received](const NormalizedMessage &) {
+        fast_received.fetch_add(1);
+        return true;
+      }));
+  dispatcher.start();
+
+  NormalizedMessage msg;
+  for (uint32_t seq = 0; seq < NUM_MESSAGES; ++seq) {
+    msg.sequence = seq;
+    msg.local_timestamp = get_timestamp();
+    dispatcher.dispatch(msg);
+
+    // Spread the messages out so the slow subscriber's queue backs up
+    // between its batches while the fast one keeps up
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // The fast subscriber finishes long before the slow one (~1s of sleeps)
+  const bool delivered = wait_for(fast_received, NUM_MESSAGES);
+  assert(delivered);
+  (void)delivered;
+  assert(slow_received.load() < NUM_MESSAGES);
+  dispatcher.stop();
+
+  assert(dispatcher.subscriber_stats(1).max_latency_ns <
+         dispatcher.subscriber_stats(0).max_latency_ns);
+
+  std::cout << "✓ Slow subscriber isolation test passed\n";
+}
+
+// Test 6: Inline subscribers are called synchronously by dispatch() on the
+// calling thread, alongside queued subscribers that keep their threads
+void test_inline_subscriber() {
+  for (DispatchMode mode :
+       {DispatchMode::QUEUE_PER_SUBSCRIBER, DispatchMode::BROADCAST}) {
+    DispatcherConfig config;
+    config.mode = mode;
+    Dispatcher dispatcher(config);
+
+    std::thread::id inline_thread;
+    uint64_t inline_received = 0;
+    std::atomic<uint64_t> queued_received{0};
+
+    SubscriberOptions options;
+    options.inline_dispatch = true;
+    dispatcher.add_subscriber(
+        make_subscriber("inline",
+                        [&](const NormalizedMessage &) {
+                          inline_thread = std::this_thread::get_id();
+                          inline_received++;
+                          return true;
+                        }),
+        options);
+    dispatcher.add_subscriber(make_subscriber(
+        "queued", [&queued_received](const NormalizedMessage &) {
+          queued_received.fetch_add(1);
+          return true;
+        }));
+
+    dispatcher.start();
+    assert(dispatcher.thread_count() == 1); // Only the queued subscriber
+
+    NormalizedMessage msg;
+    for (uint32_t seq = 0; seq < 1000; ++seq) {
+      msg.sequence = seq;
+      msg.local_timestamp = get_timestamp();
+      dispatcher.dispatch(msg);
+      assert(inline_received == seq + 1); // Delivered before dispatch returns
+    }
+    assert(inline_thread == std::this_thread::get_id());
+
+    const bool delivered = wait_for(queued_received, 1000);
+    assert(delivered);
+    (void)delivered;
+    dispatcher.stop();
+
+    SubscriberStats stats = dispatcher.subscriber_stats(0);
+    assert(stats.messages_delivered == 1000);
+    assert(stats.messages_dropped == 0);
+    assert(stats.lag == 0);
+    assert(dispatcher.subscriber_stats(1).messages_delivered == 1000);
+  }
+
+  std::cout << "✓ Inline subscriber test passed\n";
+}
+
+// Test 7: Subscription filters - only matching messages are delivered, and
+// in queue mode non-matching ones never reach the subscriber's queue
+void test_filters() {
+  for (DispatchMode mode :
+       {DispatchMode::QUEUE_PER_SUBSCRIBER, DispatchMode::BROADCAST}) {
+    DispatcherConfig config;
+    config.mode = mode;
+    Dispatcher dispatcher(config);
+
+    std::atomic<uint64_t> trades_received{0};
+    std::atomic<uint64_t> wrong{0};
+    uint64_t inline_received = 0;
+
+    // Trades on instruments 5 and 60000 only
+    SubscriberOptions trades;
+    trades.filter.add_instrument(5).add_instrument(60000).add_type(
+        NormalizedMessage::Type::TRADE);
+    dispatcher.add_subscriber(
+        make_subscriber("trades",
+                        [&](const NormalizedMessage &msg) {
+                          if (msg.type != NormalizedMessage::Type::TRADE ||
+                              (msg.instrument_id != 5 &&
+                               msg.instrument_id != 60000)) {
+                            wrong.fetch_add(1);
+                          }
+                          trades_received.fetch_add(1);
+                          return true;
+                        }),
+        trades);
+
+    // Any type on instrument 5, delivered inline
+    SubscriberOptions inline_options;
+    inline_options.inline_dispatch = true;
+    inline_options.filter.add_instrument(5);
+    dispatcher.add_subscriber(
+        make_subscriber("inline",
+                        [&](const NormalizedMessage &msg) {
+                          if (msg.instrument_id != 5) {
+                            wrong.fetch_add(1);
+                          }
+                          inline_received++;
+                          return true;
+                        }),
+        inline_options);
+
+    NormalizedMessage msg;
+    uint64_t expected_trades = 0;
+    uint64_t expected_inline = 0;
+    for (uint64_t i = 0; i < 10000; ++i) {
+      msg.instrument_id = (i % 8 == 0) ? 5 : (i % 7 == 0 ? 60000 : i % 1000);
+      msg.type = (i % 3 == 0) ? NormalizedMessage::Type::TRADE
+                              : NormalizedMessage::Type::ORDER_ADD;
+      const bool instrument = msg.instrument_id == 5 ||
+                              msg.instrument_id == 60000;
+      if (instrument && msg.type == NormalizedMessage::Type::TRADE) {
+        expected_trades++;
+      }
+      if (msg.instrument_id == 5) {
+        expected_inline++;
+      }
+      dispatcher.dispatch(msg);
+    }
+
+    // Queue mode filters before enqueueing; the broadcast ring holds
+    // everything and the reader skips
+    if (mode == DispatchMode::QUEUE_PER_SUBSCRIBER) {
+      assert(dispatcher.subscriber_stats(0).lag == expected_trades);
+    }
+    assert(inline_received == expected_inline);
+
+    dispatcher.start();
+    const bool delivered = wait_for(trades_received, expected_trades);
+    assert(delivered);
+    (void)delivered;
+    dispatcher.stop();
+
+    assert(trades_received.load() == expected_trades);
+    assert(wrong.load() == 0);
+  }
+
+  // Unknown symbols are rejected; the filter stays "all" until narrowed
+  SubscriptionFilter filter;
+  EchoParser parser;
+  assert(filter.accepts_all());
+  assert(!filter.add_symbol("AAPL", parser));
+  assert(filter.accepts_all());
+
+  std::cout << "✓ Filters test passed\n";
+}
+
+// Test 8: Messages dispatched before start are kept until the subscriber
+// reads them; a lapped broadcast subscriber reports its losses
+void test_lag_tracking() {
+  DispatcherConfig config;
+  config.mode = DispatchMode::BROADCAST;
+  Dispatcher dispatcher(config);
+
+  dispatcher.add_subscriber(make_subscriber(
+      "slow", [](const NormalizedMessage &) { return true; }));
+
+  NormalizedMessage msg;
+  for (uint32_t seq = 0; seq < 100; ++seq) {
+    msg.sequence = seq;
+    dispatcher.dispatch(msg);
+  }
+  assert(dispatcher.subscriber_stats(0).lag == 100);
+
+  // Overrun the ring with nobody reading
+  const size_t overrun = config::DEFAULT_QUEUE_SIZE * 2;
+  for (size_t i = 0; i < overrun; ++i) {
+    dispatcher.dispatch(msg);
+  }
+  assert(dispatcher.subscriber_stats(0).lag == 100 + overrun);
+
+  dispatcher.start();
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (dispatcher.subscriber_stats(0).lag > 0 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  dispatcher.stop();
+
+  SubscriberStats stats = dispatcher.subscriber_stats(0);
+  assert(stats.lag == 0);
+  assert(stats.messages_dropped > 0);
+  assert(stats.messages_delivered + stats.messages_dropped == 100 + overrun);
+
+  std::cout << "✓ Lag tracking test passed (" << stats.messages_dropped
+            << " lost to overrun)\n";
+}
+
+// Counts deliveries and lifecycle calls; stops after `limit` messages
+class TrackingSubscriber : public ISubscriber {
+public:
+  TrackingSubscriber(std::atomic<uint64_t> &received,
+                     std::atomic<int> &shutdowns, uint64_t limit = UINT64_MAX)
+      : received_(received), shutdowns_(shutdowns), limit_(limit) {}
+
+  bool on_message(const NormalizedMessage &) noexcept override {
+    return received_.fetch_add(1) + 1 < limit_;
+  }
+  const char *name() const noexcept override { return "tracking"; }
+  void shutdown() override { shutdowns_.fetch_add(1); }
+
+private:
+  std::atomic<uint64_t> &received_;
+  std::atomic<int> &shutdowns_;
+  uint64_t limit_;
+};
+
+// Wait until every removed subscriber has been freed
+static bool wait_for_reclaim(Dispatcher &dispatcher) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (dispatcher.pending_removals() > 0) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    dispatcher.quiescent(); // Stands in for an idle producer thread
+    dispatcher.reclaim();
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+// Test 9: Subscribers added and removed while the dispatcher runs
+static void check_runtime_changes(DispatchMode mode) {
+  static constexpr uint64_t BATCH = 1000;
+
+  DispatcherConfig config;
+  config.mode = mode;
+  Dispatcher dispatcher(config);
+
+  std::atomic<uint64_t> first_received{0};
+  std::atomic<uint64_t> second_received{0};
+  std::atomic<int> shutdowns{0};
+  const SubscriberId first = dispatcher.add_subscriber(
+      std::make_unique<TrackingSubscriber>(first_received, shutdowns));
+  dispatcher.start();
+
+  NormalizedMessage msg;
+  for (uint64_t i = 0; i < BATCH; ++i) {
+    dispatcher.dispatch(msg);
+  }
+  bool delivered = wait_for(first_received, BATCH);
+  assert(delivered);
+  (void)delivered;
+
+  // Joins mid-stream and sees only what is dispatched afterwards
+  const SubscriberId second = dispatcher.add_subscriber(
+      std::make_unique<TrackingSubscriber>(second_received, shutdowns));
+  assert(second != first);
+  assert(dispatcher.subscriber_count() == 2);
+  for (uint64_t i = 0; i < BATCH; ++i) {
+    dispatcher.dispatch(msg);
+  }
+  delivered = wait_for(first_received, 2 * BATCH);
+  assert(delivered);
+  delivered = wait_for(second_received, BATCH);
+  assert(delivered);
+  assert(second_received.load() == BATCH);
+
+  // Removal stops delivery at once; shutdown waits for the grace period
+  assert(dispatcher.remove_subscriber(first));
+  assert(!dispatcher.remove_subscriber(first));
+  assert(dispatcher.subscriber_count() == 1);
+  assert(dispatcher.subscriber_stats(first).messages_delivered == 0);
+  for (uint64_t i = 0; i < BATCH; ++i) {
+    dispatcher.dispatch(msg);
+  }
+  delivered = wait_for(second_received, 2 * BATCH);
+  assert(delivered);
+  assert(first_received.load() == 2 * BATCH);
+
+  const bool reclaimed = wait_for_reclaim(dispatcher);
+  assert(reclaimed);
+  (void)reclaimed;
+  assert(shutdowns.load() == 1);
+
+  dispatcher.stop();
+  assert(shutdowns.load() == 2);
+}
+
+void test_runtime_add_remove() {
+  check_runtime_changes(DispatchMode::QUEUE_PER_SUBSCRIBER);
+  check_runtime_changes(DispatchMode::BROADCAST);
+
+  std::cout << "✓ Runtime add/remove test passed (queue and broadcast)\n";
+}
+
+// Test 10: Returning false from on_message unsubscribes
+void test_unsubscribe_from_callback() {
+  Dispatcher dispatcher;
+
+  std::atomic<uint64_t> received{0};
+  std::atomic<int> shutdowns{0};
+  dispatcher.add_subscriber(
+      std::make_unique<TrackingSubscriber>(received, shutdowns, 10));
+  dispatcher.start();
+
+  NormalizedMessage msg;
+  for (int i = 0; i < 10; ++i) {
+    dispatcher.dispatch(msg);
+  }
+  const bool delivered = wait_for(received, 10);
+  assert(delivered);
+  (void)delivered;
+
+  // Nothing more is delivered, and reclaim() unlinks it
+  for (int i = 0; i < 100; ++i) {
+    dispatcher.dispatch(msg);
+  }
+  dispatcher.reclaim();
+  assert(dispatcher.subscriber_count() == 0);
+  const bool reclaimed = wait_for_reclaim(dispatcher);
+  assert(reclaimed);
+  (void)reclaimed;
+  assert(shutdowns.load() == 1);
+  assert(received.load() == 10);
+
+  dispatcher.stop();
+  assert(shutdowns.load() == 1);
+
+  std::cout << "✓ Unsubscribe from callback test passed\n";
+}
+
+// Test 11: Per-subscriber threads come and go with their subscribers
+void test_runtime_threads() {
+  DispatcherConfig config;
+  config.threads = ConsumerThreads::PER_SUBSCRIBER;
+  Dispatcher dispatcher(config);
+  dispatcher.start();
+  assert(dispatcher.thread_count() == 0);
+
+  std::atomic<uint64_t> received[3] = {};
+  std::atomic<int> shutdowns{0};
+  SubscriberId ids[3];
+  for (int i = 0; i < 3; ++i) {
+    ids[i] = dispatcher.add_subscriber(
+        std::make_unique<TrackingSubscriber>(received[i], shutdowns));
+  }
+  assert(dispatcher.thread_count() == 3);
+
+  assert(dispatcher.remove_subscriber(ids[1]));
+  assert(dispatcher.thread_count() == 2);
+
+  NormalizedMessage msg;
+  dispatcher.dispatch(msg);
+  bool delivered = wait_for(received[0], 1);
+  assert(delivered);
+  (void)delivered;
+  delivered = wait_for(received[2], 1);
+  assert(delivered);
+  assert(received[1].load() == 0);
+
+  const bool reclaimed = wait_for_reclaim(dispatcher);
+  assert(reclaimed);
+  (void)reclaimed;
+  dispatcher.stop();
+  assert(dispatcher.thread_count() == 0);
+  assert(shutdowns.load() == 3);
+
+  std::cout << "✓ Runtime threads test passed\n";
+}
+
+// Records how messages arrive when the subscriber takes whole batches
+class BatchSubscriber : public ISubscriber {
+public:
+  std::atomic<uint64_t> received{0};
+  std::atomic<uint64_t> batches{0};
+  std::atomic<uint64_t> max_batch{0};
+  std::atomic<bool> in_order{true};
+
+  bool on_message(const NormalizedMessage &) noexcept override {
+    in_order.store(false); // Queued delivery must use on_messages
+    return true;
+  }
+  bool on_messages(const NormalizedMessage *msgs,
+                   size_t count) noexcept override {
+    for (size_t i = 0; i < count; ++i) {
+      if (msgs[i].sequence != received.load() + i) {
+        in_order.store(false);
+      }
+    }
+    if (count > max_batch.load()) {
+      max_batch.store(count);
+    }
+    batches.fetch_add(1);
+    received.fetch_add(count);
+    return true;
+  }
+  const char *name() const noexcept override { return "batch"; }
+};
+
+// Test 12: Backlogged messages are delivered through on_messages in batches
+static void check_batch_delivery(DispatchMode mode) {
+  static constexpr uint32_t NUM_MESSAGES = 10000;
+
+  DispatcherConfig config;
+  config.mode = mode;
+  Dispatcher dispatcher(config);
+
+  auto subscriber = std::make_unique<BatchSubscriber>();
+  BatchSubscriber &sink = *subscriber;
+  dispatcher.add_subscriber(std::move(subscriber));
+
+  // Build a backlog so the consumer finds full batches waiting
+  NormalizedMessage msg;
+  for (uint32_t seq = 0; seq < NUM_MESSAGES; ++seq) {
+    msg.sequence = seq;
+    dispatcher.dispatch(msg);
+  }
+
+  dispatcher.start();
+  const bool delivered = wait_for(sink.received, NUM_MESSAGES);
+  assert(delivered);
+  (void)delivered;
+  dispatcher.stop();
+
+  assert(sink.received.load() == NUM_MESSAGES);
+  assert(sink.in_order.load());
+  assert(sink.max_batch.load() == config::MAX_DELIVERY_BATCH);
+  assert(sink.batches.load() < NUM_MESSAGES);
+  assert(dispatcher.subscriber_stats(0).messages_delivered == NUM_MESSAGES);
+}
+
+void test_batch_delivery() {
+  check_batch_delivery(DispatchMode::QUEUE_PER_SUBSCRIBER);
+  check_batch_delivery(DispatchMode::BROADCAST);
+
+  std::cout << "✓ Batch delivery test passed (queue and broadcast)\n";
+}
+
+// Test 13: A conflating subscriber that falls behind gets the latest update
+// per instrument and type instead of losing the newest messages
+void test_conflation() {
+  // The buffer keeps first-seen order and replaces in place
+  ConflationBuffer buffer;
+  NormalizedMessage update;
+  update.type = NormalizedMessage::Type::QUOTE;
+  update.instrument_id = 1;
+  update.price = 100;
+  assert(buffer.add(update));
+  update.instrument_id = 2;
+  assert(buffer.add(update));
+  update.instrument_id = 1;
+  update.price = 101;
+  assert(buffer.add(update));
+  assert(buffer.conflated() == 1);
+  update.type = NormalizedMessage::Type::TRADE;
+  assert(buffer.add(update)); // Same instrument, different type
+  assert(buffer.size() == 3 && buffer.conflated() == 1);
+  assert(buffer.front().instrument_id == 1 && buffer.front().price == 101);
+  buffer.pop();
+  assert(buffer.front().instrument_id == 2);
+  buffer.pop();
+  assert(buffer.front().type == NormalizedMessage::Type::TRADE);
+  buffer.pop();
+  assert(buffer.empty());
+
+  // A full buffer still conflates known keys but refuses new ones
+  ConflationBuffer small(2);
+  update.instrument_id = 1;
+  assert(small.add(update));
+  update.instrument_id = SubscriptionFilter::MAX_INSTRUMENTS; // No key
+  assert(small.add(update));
+  assert(!small.add(update) && small.size() == 2);
+  update.instrument_id = 1;
+  update.price = 102;
+  assert(small.add(update) && small.conflated() == 1);
+  assert(small.front().price == 102);
+  small.pop();
+  assert(small.add(update) && small.size() == 2); // Wraps around the ring
+  small.pop();
+  assert(small.front().instrument_id == 1 && small.front().price == 102);
+
+  static constexpr size_t QUEUE_CAPACITY = config::DEFAULT_QUEUE_SIZE - 1;
+  static constexpr uint64_t NUM_INSTRUMENTS = 3;
+  static constexpr uint64_t UPDATES = 100;
+
+  Dispatcher dispatcher;
+  std::atomic<uint64_t> received{0};
+  int64_t last_price[NUM_INSTRUMENTS] = {};
+  SubscriberOptions options;
+  options.conflate = true;
+  dispatcher.add_subscriber(
+      make_subscriber("conflated",
+                      [&](const NormalizedMessage &msg) {
+                        if (msg.instrument_id < NUM_INSTRUMENTS) {
+                          last_price[msg.instrument_id] = msg.price;
+                        }
+                        received.fetch_add(1);
+                        return true;
+                      }),
+      options);
+
+  // Fill the queue while nobody reads, then keep updating three instruments
+  NormalizedMessage msg;
+  msg.type = NormalizedMessage::Type::QUOTE;
+  msg.instrument_id = NUM_INSTRUMENTS; // Not tracked
+  for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+    dispatcher.dispatch(msg);
+  }
+  for (uint64_t i = 0; i < UPDATES; ++i) {
+    for (uint64_t id = 0; id < NUM_INSTRUMENTS; ++id) {
+      msg.instrument_id = id;
+      msg.price = static_cast<int64_t>(i);
+      dispatcher.dispatch(msg);
+    }
+  }
+
+  SubscriberStats stats = dispatcher.subscriber_stats(0);
+  assert(stats.messages_dropped == 0);
+  assert(stats.messages_conflated == NUM_INSTRUMENTS * (UPDATES - 1));
+  assert(stats.lag == QUEUE_CAPACITY + NUM_INSTRUMENTS);
+
+  // Once the subscriber drains its queue the latest updates follow
+  dispatcher.start();
+  const uint64_t expected = QUEUE_CAPACITY + NUM_INSTRUMENTS;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (received.load() < expected &&
+         std::chrono::steady_clock::now() < deadline) {
+    dispatcher.flush_conflated(); // What the parse thread does per packet
+    std::this_thread::yield();
+  }
+  dispatcher.stop();
+
+  assert(received.load() == expected);
+  for (uint64_t id = 0; id < NUM_INSTRUMENTS; ++id) {
+    assert(last_price[id] == static_cast<int64_t>(UPDATES - 1));
+  }
+  assert(dispatcher.subscriber_stats(0).lag == 0);
+
+  std::cout << "✓ Conflation test passed\n";
+}
+
+int main() {
+  std::cout << "Running Dispatcher Tests\n";
+  std::cout << "========================\n\n";
+
+  try {
+    test_queue_mode();
+    test_broadcast_mode();
+    test_thread_per_subscriber();
+    test_thread_groups();
+    test_slow_subscriber_isolation();
+    test_inline_subscriber();
+    test_filters();
+    test_lag_tracking();
+    test_runtime_add_remove();
+    test_unsubscribe_from_callback();
+    test_runtime_threads();
+    test_batch_delivery();
+    test_conflation();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,313 @@
+#pragma once
+
+// Shared test helpers: ITCH 5.0 wire messages and normalized order events
+
+#include "../core/types.hpp"
+#include "../protocols/itch50/itch50_messages.hpp"
+#include <cstring>
+#include <vector>
+
+// Builds ITCH 5.0 messages (big-endian, without the length prefix) and
+// length-prefixed packets of them
+class ItchMessageBuilder {
+public:
+  using MessageType = hft::protocols::itch50::MessageType;
+  using SystemEventMessage = hft::protocols::itch50::SystemEventMessage;
+  using StockDirectoryMessage = hft::protocols::itch50::StockDirectoryMessage;
+  using AddOrderMessage = hft::protocols::itch50::AddOrderMessage;
+  using OrderExecutedMessage = hft::protocols::itch50::OrderExecutedMessage;
+  using OrderDeleteMessage = hft::protocols::itch50::OrderDeleteMessage;
+  using TradeMessage = hft::protocols::itch50::TradeMessage;
+
+  // Write big-endian values
+  static void write_u16_be(uint8_t *dest, uint16_t value) {
+    dest[0] = (value >> 8) & 0xFF;
+    dest[1] = value & 0xFF;
+  }
+
+  static void write_u32_be(uint8_t *dest, uint32_t value) {
+    dest[0] = (value >> 24) & 0xFF;
+    dest[1] = (value >> 16) & 0xFF;
+    dest[2] = (value >> 8) & 0xFF;
+    dest[3] = value & 0xFF;
+  }
+
+  static void write_u64_be(uint8_t *dest, uint64_t value) {
+    dest[0] = (value >> 56) & 0xFF;
+    dest[1] = (value >> 48) & 0xFF;
+    dest[2] = (value >> 40) & 0xFF;
+    dest[3] = (value >> 32) & 0xFF;
+    dest[4] = (value >> 24) & 0xFF;
+    dest[5] = (value >> 16) & 0xFF;
+    dest[6] = (value >> 8) & 0xFF;
+    dest[7] = value & 0xFF;
+  }
+
+  // Build System Event message
+  static std::vector<uint8_t> build_system_event(uint16_t stock_locate,
+                                                 uint16_t tracking,
+                                                 uint64_t timestamp,
+                                                 char event_code) {
+    std::vector<uint8_t> msg(SystemEventMessage::SIZE);
+    write_u16_be(&msg[0], stock_locate);
+    write_u16_be(&msg[2], tracking);
+    write_u64_be(&msg[4], timestamp);
+    msg[12] = 'S';
+    msg[13] = event_code;
+    return msg;
+  }
+
+  // Build Stock Directory message
+  static std::vector<uint8_t> build_stock_directory(uint16_t stock_locate,
+                                                    uint64_t timestamp,
+                                                    const char *stock) {
+    std::vector<uint8_t> msg(StockDirectoryMessage::SIZE);
+    write_u16_be(&msg[0], stock_locate);
+    write_u64_be(&msg[4], timestamp);
+    msg[12] = 'R';
+    std::memcpy(&msg[13], stock, 8);
+    return msg;
+  }
+
+  // Build Add Order message
+  static std::vector<uint8_t>
+  build_add_order(uint16_t stock_locate, uint16_t tracking, uint64_t timestamp,
+                  uint64_t order_ref, char side, uint32_t shares,
+                  const char *stock, uint32_t price) {
+    std::vector<uint8_t> msg(AddOrderMessage::SIZE);
+    write_u16_be(&msg[0], stock_locate);
+    write_u16_be(&msg[2], tracking);
+    write_u64_be(&msg[4], timestamp);
+    msg[12] = 'A';
+    write_u64_be(&msg[13], order_ref);
+    msg[21] = side;
+    write_u32_be(&msg[22], shares);
+    std::memcpy(&msg[26], stock, 8);
+    write_u32_be(&msg[34], price);
+    return msg;
+  }
+
+  // Build Order Executed message
+  static std::vector<uint8_t>
+  build_order_executed(uint16_t stock_locate, uint16_t tracking,
+                       uint64_t timestamp, uint64_t order_ref,
+                       uint32_t executed_shares, uint64_t match_number) {
+    std::vector<uint8_t> msg(OrderExecutedMessage::SIZE);
+    write_u16_be(&msg[0], stock_locate);
+    write_u16_be(&msg[2], tracking);
+    write_u64_be(&msg[4], timestamp);
+    msg[12] = 'E';
+    write_u64_be(&msg[13], order_ref);
+    write_u32_be(&msg[21], executed_shares);
+    write_u64_be(&msg[25], match_number);
+    return msg;
+  }
+
+  // Build Order Delete message
+  static std::vector<uint8_t> build_order_delete(uint16_t stock_locate,
+                                                 uint16_t tracking,
+                                                 uint64_t timestamp,
+                                                 uint64_t order_ref) {
+    std::vector<uint8_t> msg(OrderDeleteMessage::SIZE);
+    write_u16_be(&msg[0], stock_locate);
+    write_u16_be(&msg[2], tracking);
+    write_u64_be(&msg[4], timestamp);
+    msg[12] = 'D';
+    write_u64_be(&msg[13], order_ref);
+    return msg;
+  }
+
+  // Build Trade message
+  static std::vector<uint8_t>
+  build_trade(uint16_t stock_locate, uint16_t tracking, uint64_t timestamp,
+              uint64_t order_ref, char side, uint32_t shares, const char *stock,
+              uint32_t price, uint64_t match_number) {
+    std::vector<uint8_t> msg(TradeMessage::SIZE);
+    write_u16_be(&msg[0], stock_locate);
+    write_u16_be(&msg[2], tracking);
+    write_u64_be(&msg[4], timestamp);
+    msg[12] = 'P';
+    write_u64_be(&msg[13], order_ref);
+    msg[21] = side;
+    write_u32_be(&msg[22], shares);
+    std::memcpy(&msg[26], stock, 8);
+    write_u32_be(&msg[34], price);
+    write_u64_be(&msg[38], match_number);
+    return msg;
+  }
+
+  // Zeroed message of the type's size with the common header filled in
+  static std::vector<uint8_t> build_header(MessageType type,
+                                           uint16_t stock_locate,
+                                           uint16_t tracking,
+                                           uint64_t timestamp) {
+    std::vector<uint8_t> msg(hft::protocols::itch50::get_message_size(type));
+    write_u16_be(&msg[0], stock_locate);
+    write_u16_be(&msg[2], tracking);
+    write_u64_be(&msg[4], timestamp);
+    msg[12] = static_cast<uint8_t>(type);
+    return msg;
+  }
+
+  // Build Stock Trading Action message
+  static std::vector<uint8_t> build_trading_action(uint16_t stock_locate,
+                                                   char state,
+                                                   const char *reason) {
+    auto msg = build_header(MessageType::STOCK_TRADING_ACTION, stock_locate,
+                            1, 1000);
+    std::memcpy(&msg[13], "AAPL    ", 8);
+    msg[21] = state;
+    std::memcpy(&msg[23], reason, 4);
+    return msg;
+  }
+
+  // Build MWCB Decline Level message (levels with 8 implied decimals)
+  static std::vector<uint8_t> build_mwcb_decline(uint64_t level1,
+                                                 uint64_t level2,
+                                                 uint64_t level3) {
+    auto msg = build_header(MessageType::MWCB_DECLINE_LEVEL, 0, 1, 1000);
+    write_u64_be(&msg[13], level1);
+    write_u64_be(&msg[21], level2);
+    write_u64_be(&msg[29], level3);
+    return msg;
+  }
+
+  // Build LULD Auction Collar message
+  static std::vector<uint8_t> build_luld_collar(uint16_t stock_locate,
+                                                uint32_t reference,
+                                                uint32_t upper, uint32_t lower,
+                                                uint32_t extension) {
+    auto msg =
+        build_header(MessageType::LULD_AUCTION_COLLAR, stock_locate, 1, 1000);
+    std::memcpy(&msg[13], "AAPL    ", 8);
+    write_u32_be(&msg[21], reference);
+    write_u32_be(&msg[25], upper);
+    write_u32_be(&msg[29], lower);
+    write_u32_be(&msg[33], extension);
+    return msg;
+  }
+
+  // Build Operational Halt message
+  static std::vector<uint8_t> build_operational_halt(uint16_t stock_locate,
+                                                     char market,
+                                                     char action) {
+    auto msg =
+        build_header(MessageType::OPERATIONAL_HALT, stock_locate, 1, 1000);
+    std::memcpy(&msg[13], "AAPL    ", 8);
+    msg[21] = market;
+    msg[22] = action;
+    return msg;
+  }
+
+  // Build Cross Trade message
+  static std::vector<uint8_t> build_cross_trade(uint16_t stock_locate,
+                                                uint64_t shares,
+                                                uint32_t price,
+                                                uint64_t match_number,
+                                                char cross_type) {
+    auto msg = build_header(MessageType::CROSS_TRADE, stock_locate, 1, 1000);
+    write_u64_be(&msg[13], shares);
+    std::memcpy(&msg[21], "AAPL    ", 8);
+    write_u32_be(&msg[29], price);
+    write_u64_be(&msg[33], match_number);
+    msg[41] = cross_type;
+    return msg;
+  }
+
+  // Build Broken Trade message
+  static std::vector<uint8_t> build_broken_trade(uint16_t stock_locate,
+                                                 uint64_t match_number) {
+    auto msg = build_header(MessageType::BROKEN_TRADE, stock_locate, 1, 1000);
+    write_u64_be(&msg[13], match_number);
+    return msg;
+  }
+
+  // Build NOII message
+  static std::vector<uint8_t> build_noii(uint16_t stock_locate,
+                                         uint64_t paired, uint64_t imbalance,
+                                         char direction, uint32_t reference) {
+    auto msg = build_header(MessageType::NOII, stock_locate, 1, 1000);
+    write_u64_be(&msg[13], paired);
+    write_u64_be(&msg[21], imbalance);
+    msg[29] = direction;
+    std::memcpy(&msg[30], "AAPL    ", 8);
+    write_u32_be(&msg[38], 1500000); // Far price
+    write_u32_be(&msg[42], 1490000); // Near price
+    write_u32_be(&msg[46], reference);
+    msg[50] = 'O';
+    msg[51] = 'L';
+    return msg;
+  }
+
+  // Build Order Executed with Price message
+  static std::vector<uint8_t> build_order_executed_with_price(
+      uint16_t stock_locate, uint64_t order_ref, uint32_t executed_shares,
+      uint32_t price) {
+    auto msg = build_header(MessageType::ORDER_EXECUTED_WITH_PRICE,
+                            stock_locate, 1, 1000);
+    write_u64_be(&msg[13], order_ref);
+    write_u32_be(&msg[21], executed_shares);
+    write_u64_be(&msg[25], 999);
+    msg[33] = 'Y';
+    write_u32_be(&msg[34], price);
+    return msg;
+  }
+
+  // Build Order Cancel message
+  static std::vector<uint8_t> build_order_cancel(uint16_t stock_locate,
+                                                 uint64_t order_ref,
+                                                 uint32_t cancelled_shares) {
+    auto msg = build_header(MessageType::ORDER_CANCEL, stock_locate, 1, 1000);
+    write_u64_be(&msg[13], order_ref);
+    write_u32_be(&msg[21], cancelled_shares);
+    return msg;
+  }
+
+  // Build Order Replace message
+  static std::vector<uint8_t> build_order_replace(uint16_t stock_locate,
+                                                  uint64_t original_ref,
+                                                  uint64_t new_ref,
+                                                  uint32_t shares,
+                                                  uint32_t price) {
+    auto msg = build_header(MessageType::ORDER_REPLACE, stock_locate, 1, 1000);
+    write_u64_be(&msg[13], original_ref);
+    write_u64_be(&msg[21], new_ref);
+    write_u32_be(&msg[29], shares);
+    write_u32_be(&msg[33], price);
+    return msg;
+  }
+
+  // Build ITCH packet with message length headers
+  static std::vector<uint8_t>
+  build_packet(const std::vector<std::vector<uint8_t>> &messages) {
+    std::vector<uint8_t> packet;
+
+    for (const auto &msg : messages) {
+      // Add 2-byte length header (length + 2 for the header itself)
+      uint16_t length = static_cast<uint16_t>(msg.size() + 2);
+      uint8_t len_bytes[2];
+      write_u16_be(len_bytes, length);
+      packet.push_back(len_bytes[0]);
+      packet.push_back(len_bytes[1]);
+      packet.insert(packet.end(), msg.begin(), msg.end());
+    }
+
+    return packet;
+  }
+};
+
+// Order event on instrument 1 as ItchParser emits it with order tracking:
+// the order's side and price filled in (FLAG_ENRICHED)
+inline hft::core::NormalizedMessage
+order_message(hft::core::NormalizedMessage::Type type, uint64_t order_id,
+              uint8_t side, int64_t price, uint64_t quantity) {
+  hft::core::NormalizedMessage msg;
+  msg.type = type;
+  msg.instrument_id = 1;
+  msg.order_id = order_id;
+  msg.side = side;
+  msg.price = price;
+  msg.quantity = quantity;
+  msg.flags = hft::core::NormalizedMessage::FLAG_ENRICHED;
+  return msg;
+}
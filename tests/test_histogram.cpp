@@ -0,0 +1,105 @@
+#include "../core/metrics/histogram.hpp"
+#include <cassert>
+#include <iostream>
+#include <memory>
+
+using namespace hft::core;
+
+// Test 1: Bucket boundaries - exact for small values, within 1/64 above
+void test_bucket_precision() {
+  for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; ++value) {
+    assert(LatencyHistogram::bucket_of(value) == value);
+    assert(LatencyHistogram::highest_in_bucket(value) == value);
+  }
+
+  size_t last_bucket = 0;
+  const uint64_t limit = uint64_t{1} << 40;
+  for (uint64_t value = 1; value < limit; value += value / 7 + 1) {
+    const size_t bucket = LatencyHistogram::bucket_of(value);
+    const uint64_t highest = LatencyHistogram::highest_in_bucket(bucket);
+    assert(bucket < LatencyHistogram::BUCKET_COUNT);
+    assert(bucket >= last_bucket); // Monotonic
+    assert(highest >= value);
+    assert(highest - value <= value / LatencyHistogram::SUB_BUCKETS);
+    last_bucket = bucket;
+  }
+
+  // Full range fits
+  assert(LatencyHistogram::bucket_of(UINT64_MAX) ==
+         LatencyHistogram::BUCKET_COUNT - 1);
+  assert(LatencyHistogram::highest_in_bucket(
+             LatencyHistogram::BUCKET_COUNT - 1) == UINT64_MAX);
+
+  std::cout << "✓ Bucket precision test passed\n";
+}
+
+// Test 2: Percentiles of a known distribution
+void test_percentiles() {
+  auto histogram = std::make_unique<LatencyHistogram>();
+  assert(histogram->percentile(99) == 0);
+
+  for (uint64_t value = 1; value <= 100000; ++value) {
+    histogram->record(value);
+  }
+  assert(histogram->count() == 100000);
+  assert(histogram->min() == 1);
+  assert(histogram->max() == 100000);
+  assert(histogram->mean() == 50000.5);
+
+  const uint64_t p50 = histogram->percentile(50);
+  const uint64_t p99 = histogram->percentile(99);
+  const uint64_t p9999 = histogram->percentile(99.99);
+  assert(p50 >= 50000 && p50 <= 50000 + 50000 / 64);
+  assert(p99 >= 99000 && p99 <= 99000 + 99000 / 64);
+  assert(p9999 >= 99990 && p9999 <= 100000);
+  assert(histogram->percentile(100) == 100000); // Clamped to max
+  assert(histogram->percentile(0) == 1);
+
+  // A single outlier shows up in the tail only
+  histogram->record(10000000);
+  assert(histogram->percentile(99) <= 99000 + 99000 / 64);
+  assert(histogram->percentile(100) == 10000000);
+
+  histogram->reset();
+  assert(histogram->count() == 0);
+  assert(histogram->percentile(50) == 0);
+
+  std::cout << "✓ Percentiles test passed\n";
+}
+
+// Test 3: Histograms recorded on separate threads merge into one
+void test_merge() {
+  auto fast = std::make_unique<LatencyHistogram>();
+  auto slow = std::make_unique<LatencyHistogram>();
+  auto combined = std::make_unique<LatencyHistogram>();
+
+  fast->record(100, 990);
+  slow->record(5000, 10);
+
+  combined->merge(*fast);
+  combined->merge(*slow);
+  assert(combined->count() == 1000);
+  assert(combined->min() == 100);
+  assert(combined->max() == 5000);
+  assert(combined->percentile(99) >= 100 && combined->percentile(99) <= 101);
+  assert(combined->percentile(99.5) >= 5000);
+
+  std::cout << "✓ Merge test passed\n";
+}
+
+int main() {
+  std::cout << "Running Latency Histogram Tests\n";
+  std::cout << "===============================\n\n";
+
+  try {
+    test_bucket_precision();
+    test_percentiles();
+    test_merge();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
@@ -1,142 +1,20 @@
 #include "../core/types.hpp"
 #include "../protocols/itch50/itch50_messages.hpp"
 #include "../protocols/itch50/itch50_parser.hpp"
+#include "test_helpers.hpp"
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstring>
 #include <iostream>
+#include <map>
+#include <random>
+#include <utility>
 #include <vector>
 
 using namespace hft::protocols::itch50;
 using namespace hft::core;
 
-// Helper to create ITCH messages
-class ItchMessageBuilder {
-public:
-  // Write big-endian values
-  static void write_u16_be(uint8_t *dest, uint16_t value) {
-    dest[0] = (value >> 8) & 0xFF;
-    dest[1] = value & 0xFF;
-  }
-
-  static void write_u32_be(uint8_t *dest, uint32_t value) {
-    dest[0] = (value >> 24) & 0xFF;
-    dest[1] = (value >> 16) & 0xFF;
-    dest[2] = (value >> 8) & 0xFF;
-    dest[3] = value & 0xFF;
-  }
-
-  static void write_u64_be(uint8_t *dest, uint64_t value) {
-    dest[0] = (value >> 56) & 0xFF;
-    dest[1] = (value >> 48) & 0xFF;
-    dest[2] = (value >> 40) & 0xFF;
-    dest[3] = (value >> 32) & 0xFF;
-    dest[4] = (value >> 24) & 0xFF;
-    dest[5] = (value >> 16) & 0xFF;
-    dest[6] = (value >> 8) & 0xFF;
-    dest[7] = value & 0xFF;
-  }
-
-  // Build System Event message
-  static std::vector<uint8_t> build_system_event(uint16_t stock_locate,
-                                                 uint16_t tracking,
-                                                 uint64_t timestamp,
-                                                 char event_code) {
-    std::vector<uint8_t> msg(SystemEventMessage::SIZE);
-    write_u16_be(&msg[0], stock_locate);
-    write_u16_be(&msg[2], tracking);
-    write_u64_be(&msg[4], timestamp);
-    msg[12] = 'S';
-    msg[13] = event_code;
-    return msg;
-  }
-
-  // Build Add Order message
-  static std::vector<uint8_t>
-  build_add_order(uint16_t stock_locate, uint16_t tracking, uint64_t timestamp,
-                  uint64_t order_ref, char side, uint32_t shares,
-                  const char *stock, uint32_t price) {
-    std::vector<uint8_t> msg(AddOrderMPIDMessage::SIZE);
-    write_u16_be(&msg[0], stock_locate);
-    write_u16_be(&msg[2], tracking);
-    write_u64_be(&msg[4], timestamp);
-    msg[12] = 'A';
-    write_u64_be(&msg[13], order_ref);
-    msg[21] = side;
-    write_u32_be(&msg[22], shares);
-    std::memcpy(&msg[26], stock, 8);
-    write_u32_be(&msg[34], price);
-    return msg;
-  }
-
-  // Build Order Executed message
-  static std::vector<uint8_t>
-  build_order_executed(uint16_t stock_locate, uint16_t tracking,
-                       uint64_t timestamp, uint64_t order_ref,
-                       uint32_t executed_shares, uint64_t match_number) {
-    std::vector<uint8_t> msg(OrderExecutedMessage::SIZE);
-    write_u16_be(&msg[0], stock_locate);
-    write_u16_be(&msg[2], tracking);
-    write_u64_be(&msg[4], timestamp);
-    msg[12] = 'E';
-    write_u64_be(&msg[13], order_ref);
-    write_u32_be(&msg[21], executed_shares);
-    write_u64_be(&msg[25], match_number);
-    return msg;
-  }
-
-  // Build Order Delete message
-  static std::vector<uint8_t> build_order_delete(uint16_t stock_locate,
-                                                 uint16_t tracking,
-                                                 uint64_t timestamp,
-                                                 uint64_t order_ref) {
-    std::vector<uint8_t> msg(OrderDeleteMessage::SIZE);
-    write_u16_be(&msg[0], stock_locate);
-    write_u16_be(&msg[2], tracking);
-    write_u64_be(&msg[4], timestamp);
-    msg[12] = 'D';
-    write_u64_be(&msg[13], order_ref);
-    return msg;
-  }
-
-  // Build Trade message
-  static std::vector<uint8_t>
-  build_trade(uint16_t stock_locate, uint16_t tracking, uint64_t timestamp,
-              uint64_t order_ref, char side, uint32_t shares, const char *stock,
-              uint32_t price, uint64_t match_number) {
-    std::vector<uint8_t> msg(TradeMessage::SIZE);
-    write_u16_be(&msg[0], stock_locate);
-    write_u16_be(&msg[2], tracking);
-    write_u64_be(&msg[4], timestamp);
-    msg[12] = 'P';
-    write_u64_be(&msg[13], order_ref);
-    msg[21] = side;
-    write_u32_be(&msg[22], shares);
-    std::memcpy(&msg[26], stock, 8);
-    write_u32_be(&msg[34], price);
-    write_u64_be(&msg[38], match_number);
-    return msg;
-  }
-
-  // Build ITCH packet with message length headers
-  static std::vector<uint8_t>
-  build_packet(const std::vector<std::vector<uint8_t>> &messages) {
-    std::vector<uint8_t> packet;
-
-    for (const auto &msg : messages) {
-      // Add 2-byte length header (length + 2 for the header itself)
-      uint16_t length = static_cast<uint16_t>(msg.size() + 2);
-      uint8_t len_bytes[2];
-      write_u16_be(len_bytes, length);
-      packet.push_back(len_bytes[0]);
-      packet.push_back(len_bytes[1]);
-      packet.insert(packet.end(), msg.begin(), msg.end());
-    }
-
-    return packet;
-  }
-};
-
 // Test 1: Parse System Event
 void test_system_event() {
   ItchParser parser;
@@ -364,6 +242,514 @@ void test_statistics() {
   std::cout << "✓ Statistics test passed\n";
 }
 
+// Test 9: Symbol resolution for subscription filters
+void test_find_instrument() {
+  ItchParser parser;
+  uint64_t instrument_id = 0;
+
+  assert(!parser.find_instrument("AAPL", instrument_id));
+
+  // Learned from the feed's stock directory
+  auto msg = ItchMessageBuilder::build_stock_directory(42, 1000, "AAPL    ");
+  auto packet = ItchMessageBuilder::build_packet({msg});
+  MessageView view{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                   0};
+  NormalizedMessage output[1];
+  assert(parser.parse(view, output, 1) == 1);
+  assert(output[0].instrument_id == 42);
+
+  assert(parser.find_instrument("AAPL", instrument_id));
+  assert(instrument_id == 42);
+  assert(parser.find_instrument("AAPL    ", instrument_id));
+  assert(!parser.find_instrument("AAP", instrument_id));
+
+  // Preloaded before the feed starts
+  parser.add_stock(7, "MSFT");
+  assert(parser.find_instrument("MSFT", instrument_id));
+  assert(instrument_id == 7);
+
+  std::cout << "✓ Find instrument test passed\n";
+}
+
+// Test 10: Administrative and status messages
+void test_status_messages() {
+  ItchParser parser;
+  NormalizedMessage output[8];
+
+  auto reg_sho = ItchMessageBuilder::build_header(
+      MessageType::REG_SHO_RESTRICTION, 5, 2, 2000);
+  reg_sho[21] = '1';
+  auto position = ItchMessageBuilder::build_header(
+      MessageType::MARKET_PARTICIPANT_POSITION, 5, 3, 3000);
+  std::memcpy(&position[13], "GSCO", 4);
+  position[27] = 'A';
+  auto mwcb_status =
+      ItchMessageBuilder::build_header(MessageType::MWCB_STATUS, 0, 4, 4000);
+  mwcb_status[13] = '2';
+  auto ipo = ItchMessageBuilder::build_header(MessageType::IPO_QUOTING_PERIOD,
+                                              5, 5, 5000);
+  ItchMessageBuilder::write_u32_be(&ipo[21], 34200);
+  ipo[25] = 'A';
+  ItchMessageBuilder::write_u32_be(&ipo[26], 270000);
+  auto rpii = ItchMessageBuilder::build_header(MessageType::RPII, 5, 6, 6000);
+  rpii[21] = 'B';
+
+  auto packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_trading_action(5, 'H', "LUDP"), reg_sho,
+       position, ItchMessageBuilder::build_mwcb_decline(
+                     380000000000ULL, 350000000000ULL, 300000000000ULL),
+       mwcb_status, ipo, rpii,
+       ItchMessageBuilder::build_operational_halt(5, 'Q', 'H')});
+  MessageView view{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                   0};
+  assert(parser.parse(view, output, 8) == 8);
+
+  // Trading action: state in code, reason packed into order_id
+  assert(output[0].type == NormalizedMessage::Type::STATUS);
+  assert(output[0].source_type == 'H');
+  assert(output[0].code == 'H');
+  assert(output[0].instrument_id == 5);
+  assert(output[0].order_id == 0x4C554450); // "LUDP"
+
+  assert(output[1].type == NormalizedMessage::Type::STATUS);
+  assert(output[1].code == '1');
+  assert(output[1].sequence == 2);
+  assert(output[1].timestamp == 2000);
+
+  assert(output[2].source_type == 'L');
+  assert(output[2].code == 'A');
+  assert(output[2].order_id == 0x4753434F); // "GSCO"
+
+  // MWCB levels rescaled from 8 to 4 implied decimals
+  assert(output[3].type == NormalizedMessage::Type::SYSTEM_EVENT);
+  assert(output[3].price == 38000000);
+  assert(output[3].order_id == 35000000);
+  assert(output[3].quantity == 30000000);
+
+  assert(output[4].type == NormalizedMessage::Type::SYSTEM_EVENT);
+  assert(output[4].code == '2');
+
+  assert(output[5].code == 'A');
+  assert(output[5].price == 270000);
+  assert(output[5].order_id == 34200);
+
+  assert(output[6].source_type == 'N');
+  assert(output[6].code == 'B');
+
+  assert(output[7].type == NormalizedMessage::Type::STATUS);
+  assert(output[7].source_type == 'h');
+  assert(output[7].code == 'H');
+  assert(output[7].order_id == 'Q');
+
+  std::cout << "✓ Status messages test passed\n";
+}
+
+// Test 11: Auction, cross and trade-break messages
+void test_auction_messages() {
+  ItchParser parser;
+  NormalizedMessage output[8];
+
+  auto dlcr = ItchMessageBuilder::build_header(
+      MessageType::DLCR_PRICE_DISCOVERY, 9, 1, 1000);
+  dlcr[21] = 'Y';
+  ItchMessageBuilder::write_u32_be(&dlcr[30], 255000);
+
+  auto packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_luld_collar(9, 1000000, 1050000, 950000, 2),
+       ItchMessageBuilder::build_cross_trade(9, 123456, 1010000, 77, 'O'),
+       ItchMessageBuilder::build_broken_trade(9, 77),
+       ItchMessageBuilder::build_noii(9, 5000, 1200, 'S', 1005000), dlcr,
+       ItchMessageBuilder::build_noii(9, 5000, 0, 'N', 1005000),
+       ItchMessageBuilder::build_noii(9, 5000, 0, 'O', 1005000)});
+  MessageView view{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                   0};
+  assert(parser.parse(view, output, 8) == 7);
+
+  assert(output[0].type == NormalizedMessage::Type::STATUS);
+  assert(output[0].source_type == 'J');
+  assert(output[0].price == 1000000);
+  assert(output[0].order_id == ((1050000ULL << 32) | 950000));
+  assert(output[0].quantity == 2);
+
+  assert(output[1].type == NormalizedMessage::Type::TRADE);
+  assert(output[1].code == 'O');
+  assert(output[1].quantity == 123456);
+  assert(output[1].price == 1010000);
+  assert(output[1].order_id == 77);
+
+  assert(output[2].type == NormalizedMessage::Type::TRADE_BREAK);
+  assert(output[2].order_id == 77);
+
+  assert(output[3].type == NormalizedMessage::Type::IMBALANCE);
+  assert(output[3].code == 'S');
+  assert(output[3].side == 1);
+  assert(output[3].quantity == 1200);
+  assert(output[3].order_id == 5000);
+  assert(output[3].price == 1005000);
+
+  assert(output[4].source_type == 'O');
+  assert(output[4].code == 'Y');
+  assert(output[4].price == 255000);
+
+  // No imbalance and insufficient orders have no side
+  assert(output[5].type == NormalizedMessage::Type::IMBALANCE);
+  assert(output[5].code == 'N');
+  assert(output[5].side == 0);
+  assert(output[5].quantity == 0);
+  assert(output[6].code == 'O');
+  assert(output[6].side == 0);
+
+  std::cout << "✓ Auction messages test passed\n";
+}
+
+// Test 12: Truncated and unknown messages are skipped
+void test_unsupported_messages() {
+  ItchParser parser;
+  NormalizedMessage output[4];
+
+  auto truncated = ItchMessageBuilder::build_noii(1, 1, 1, 'B', 1);
+  truncated.resize(30);
+  auto unknown =
+      ItchMessageBuilder::build_header(MessageType::SYSTEM_EVENT, 0, 1, 1000);
+  unknown[12] = 'z';
+  auto valid = ItchMessageBuilder::build_broken_trade(1, 5);
+
+  auto packet = ItchMessageBuilder::build_packet({truncated, unknown, valid});
+  MessageView view{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                   0};
+  assert(parser.parse(view, output, 4) == 1);
+  assert(output[0].type == NormalizedMessage::Type::TRADE_BREAK);
+
+  Statistics stats;
+  parser.get_stats(stats);
+  assert(stats.parse_errors == 0);
+
+  // Earlier contents of a reused output slot do not leak through
+  output[0].side = 1;
+  output[0].price = 42;
+  auto mwcb = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_header(MessageType::MWCB_STATUS, 0, 1, 1)});
+  MessageView mwcb_view{mwcb.data(), static_cast<uint32_t>(mwcb.size()), 1000,
+                        0};
+  assert(parser.parse(mwcb_view, output, 1) == 1);
+  assert(output[0].side == 0);
+  assert(output[0].price == 0);
+
+  std::cout << "✓ Unsupported messages test passed\n";
+}
+
+// Test 13: Order store keeps references, including displaced ones
+void test_order_store() {
+  OrderStore store(4);
+  assert(store.capacity() == 4);
+  assert(store.find(1) == nullptr);
+
+  store.add(1, {100, 10, 0});
+  store.add(2, {200, 20, 1});
+  assert(store.size() == 2);
+  assert(store.find(2)->price == 200);
+
+  // 5 lands on 1's slot while 1 is still resting
+  store.add(5, {500, 50, 0});
+  assert(store.overflowed() == 1);
+  assert(store.size() == 3);
+  assert(store.find(1)->remaining == 10);
+  assert(store.find(5)->remaining == 50);
+
+  store.find(5)->remaining = 7;
+  assert(store.find(5)->remaining == 7);
+
+  store.remove(1);
+  store.remove(5);
+  assert(store.find(1) == nullptr);
+  assert(store.find(5) == nullptr);
+  assert(store.size() == 1);
+
+  store.clear();
+  assert(store.size() == 0);
+  assert(store.find(2) == nullptr);
+
+  // A full overflow drops the displaced order and counts it
+  OrderStore small(4, 2);
+  assert(small.overflow_capacity() == 2);
+  for (uint32_t ref = 0; ref < 16; ++ref) {
+    small.add(ref, {ref, ref, 0});
+  }
+  assert(small.overflowed() == 2);
+  assert(small.dropped() == 10);
+  assert(small.size() == 6);
+  assert(small.find(15)->price == 15);
+
+  // Overflow entries stay reachable as others are removed around them
+  OrderStore wide(1, 64);
+  std::map<uint64_t, uint32_t> model;
+  std::mt19937_64 rng(7);
+  for (uint32_t i = 0; i < 20000; ++i) {
+    const uint64_t ref = rng() % 96;
+    if (rng() % 2 == 0 && model.size() < 64) {
+      wide.add(ref, {i, i, 0});
+      model[ref] = i;
+    } else {
+      wide.remove(ref);
+      model.erase(ref);
+    }
+    assert(wide.size() == model.size());
+  }
+  assert(wide.dropped() == 0);
+  for (uint64_t ref = 0; ref < 96; ++ref) {
+    const OrderState *order = wide.find(ref);
+    assert((order != nullptr) == (model.count(ref) == 1));
+    assert(order == nullptr || order->price == model[ref]);
+  }
+
+  std::cout << "✓ Order store test passed\n";
+}
+
+// Test 14: Order events carry the tracked order's state
+void test_order_tracking() {
+  ItchParser parser;
+  NormalizedMessage output[16];
+  assert(!parser.order_tracking());
+  parser.enable_order_tracking(1024);
+  assert(parser.order_tracking());
+
+  auto packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_add_order(3, 1, 1000, 10, 'S', 500,
+                                           "AAPL    ", 1500000),
+       ItchMessageBuilder::build_order_executed(3, 2, 1001, 10, 100, 1),
+       ItchMessageBuilder::build_order_executed_with_price(3, 10, 50,
+                                                           1499000),
+       ItchMessageBuilder::build_order_cancel(3, 10, 150),
+       ItchMessageBuilder::build_order_delete(3, 3, 1002, 10)});
+  MessageView view{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                   0};
+  assert(parser.parse(view, output, 16) == 6);
+
+  assert(output[0].type == NormalizedMessage::Type::ORDER_ADD);
+  assert(output[0].remaining_quantity == 500);
+  assert(output[0].flags == 0);
+
+  // Executed at the order's price
+  assert(output[1].type == NormalizedMessage::Type::ORDER_EXECUTE);
+  assert(output[1].flags == NormalizedMessage::FLAG_ENRICHED);
+  assert(output[1].instrument_id == 3);
+  assert(output[1].side == 1);
+  assert(output[1].price == 1500000);
+  assert(output[1].quantity == 100);
+  assert(output[1].remaining_quantity == 400);
+
+  // Executed at its own price: the execution keeps the resting price and
+  // the print follows as a trade
+  const uint8_t print_flags =
+      NormalizedMessage::FLAG_ENRICHED | NormalizedMessage::FLAG_PRINT_PRICE;
+  assert(output[2].type == NormalizedMessage::Type::ORDER_EXECUTE);
+  assert(output[2].flags == print_flags);
+  assert(output[2].order_id == 10);
+  assert(output[2].side == 1);
+  assert(output[2].price == 1500000);
+  assert(output[2].quantity == 50);
+  assert(output[2].remaining_quantity == 350);
+  assert(output[3].type == NormalizedMessage::Type::TRADE);
+  assert(output[3].flags == print_flags);
+  assert(output[3].source_type == 'C');
+  assert(output[3].code == 'Y');
+  assert(output[3].order_id == 999);
+  assert(output[3].side == 1);
+  assert(output[3].price == 1499000);
+  assert(output[3].quantity == 50);
+
+  assert(output[4].type == NormalizedMessage::Type::ORDER_MODIFY);
+  assert(output[4].side == 1);
+  assert(output[4].price == 1500000);
+  assert(output[4].quantity == 150);
+  assert(output[4].remaining_quantity == 200);
+
+  // Delete reports the shares it takes off the book
+  assert(output[5].type == NormalizedMessage::Type::ORDER_DELETE);
+  assert(output[5].flags == NormalizedMessage::FLAG_ENRICHED);
+  assert(output[5].side == 1);
+  assert(output[5].price == 1500000);
+  assert(output[5].quantity == 200);
+  assert(output[5].remaining_quantity == 0);
+  assert(parser.tracked_orders() == 0);
+
+  // Fully executed orders are dropped
+  packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_add_order(3, 1, 1000, 11, 'B', 100,
+                                           "AAPL    ", 1500000),
+       ItchMessageBuilder::build_order_executed(3, 2, 1001, 11, 100, 1)});
+  view = MessageView{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                     0};
+  assert(parser.parse(view, output, 16) == 2);
+  assert(output[1].remaining_quantity == 0);
+  assert(parser.tracked_orders() == 0);
+
+  // Unknown references pass through unenriched
+  packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_order_delete(3, 4, 1003, 99)});
+  view = MessageView{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                     0};
+  assert(parser.parse(view, output, 16) == 1);
+  assert(output[0].flags == 0);
+  assert(output[0].quantity == 0);
+  assert(parser.unknown_orders() == 1);
+
+  // ...and an unknown execution with a price reports the print price
+  packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_order_executed_with_price(3, 98, 10,
+                                                           1498000)});
+  view = MessageView{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                     0};
+  assert(parser.parse(view, output, 16) == 1);
+  assert(output[0].type == NormalizedMessage::Type::ORDER_EXECUTE);
+  assert(output[0].flags == 0);
+  assert(output[0].price == 1498000);
+
+  // A priced execution needs room for both messages
+  packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_add_order(3, 1, 1000, 12, 'B', 100,
+                                           "AAPL    ", 1500000)});
+  view = MessageView{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                     0};
+  assert(parser.parse(view, output, 16) == 1);
+  packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_order_executed_with_price(3, 12, 10,
+                                                           1501000)});
+  view = MessageView{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                     0};
+  assert(parser.parse(view, output, 1) == 0);
+  assert(parser.parse(view, output, 2) == 2);
+  assert(output[0].price == 1500000);
+  assert(output[0].remaining_quantity == 90);
+  assert(output[1].price == 1501000);
+
+  std::cout << "✓ Order tracking test passed\n";
+}
+
+// Test 15: Replaces become a delete of the old reference and an add of the
+// new one
+void test_order_replace() {
+  ItchParser parser;
+  NormalizedMessage output[4];
+
+  // Without tracking a replace stays a single modify
+  auto replace = ItchMessageBuilder::build_order_replace(3, 20, 21, 300,
+                                                         1510000);
+  auto packet = ItchMessageBuilder::build_packet({replace});
+  MessageView view{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                   0};
+  assert(parser.parse(view, output, 4) == 1);
+  assert(output[0].type == NormalizedMessage::Type::ORDER_MODIFY);
+  assert(output[0].order_id == 21);
+
+  parser.enable_order_tracking(1024);
+  packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_add_order(3, 1, 1000, 20, 'B', 200,
+                                           "AAPL    ", 1500000),
+       ItchMessageBuilder::build_order_cancel(3, 20, 50), replace});
+  view = MessageView{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                     0};
+  assert(parser.parse(view, output, 4) == 4);
+
+  const uint8_t flags =
+      NormalizedMessage::FLAG_ENRICHED | NormalizedMessage::FLAG_REPLACE;
+  assert(output[2].type == NormalizedMessage::Type::ORDER_DELETE);
+  assert(output[2].flags == flags);
+  assert(output[2].order_id == 20);
+  assert(output[2].price == 1500000);
+  assert(output[2].quantity == 150);
+  assert(output[2].side == 0);
+  assert(output[3].type == NormalizedMessage::Type::ORDER_ADD);
+  assert(output[3].flags == flags);
+  assert(output[3].order_id == 21);
+  assert(output[3].price == 1510000);
+  assert(output[3].quantity == 300);
+  assert(output[3].remaining_quantity == 300);
+  assert(output[3].side == 0);
+  assert(output[3].sequence == output[2].sequence);
+
+  // The new reference is tracked, the old one is gone
+  assert(parser.tracked_orders() == 1);
+  packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_order_cancel(3, 21, 100),
+       ItchMessageBuilder::build_order_cancel(3, 20, 100)});
+  view = MessageView{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                     0};
+  assert(parser.parse(view, output, 4) == 2);
+  assert(output[0].flags == NormalizedMessage::FLAG_ENRICHED);
+  assert(output[0].remaining_quantity == 200);
+  assert(output[1].flags == 0);
+
+  // A replace that does not fit in the output is left for lack of room
+  packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_order_cancel(3, 21, 10),
+       ItchMessageBuilder::build_order_replace(3, 21, 22, 100, 1520000)});
+  view = MessageView{packet.data(), static_cast<uint32_t>(packet.size()), 1000,
+                     0};
+  assert(parser.parse(view, output, 2) == 1);
+  assert(parser.tracked_orders() == 1);
+
+  std::cout << "✓ Order replace test passed\n";
+}
+
+// Test 16: Parse cost per message type
+void test_per_type_performance() {
+  constexpr int MESSAGES = 100;
+  constexpr int ITERATIONS = 5000;
+
+  auto add_order = ItchMessageBuilder::build_add_order(
+      1, 1, 1000, 111, 'B', 100, "AAPL    ", 1500000);
+  auto add_mpid = ItchMessageBuilder::build_header(MessageType::ADD_ORDER_MPID,
+                                                   1, 1, 1000);
+  std::copy(add_order.begin() + 13, add_order.end(), add_mpid.begin() + 13);
+
+  const std::vector<std::pair<const char *, std::vector<uint8_t>>> samples = {
+      {"S system event",
+       ItchMessageBuilder::build_system_event(0, 1, 1000, 'O')},
+      {"H trading action",
+       ItchMessageBuilder::build_trading_action(1, 'T', "    ")},
+      {"V MWCB decline", ItchMessageBuilder::build_mwcb_decline(1, 2, 3)},
+      {"J LULD collar", ItchMessageBuilder::build_luld_collar(1, 1, 2, 3, 0)},
+      {"h operational halt",
+       ItchMessageBuilder::build_operational_halt(1, 'Q', 'T')},
+      {"A add order", add_order},
+      {"F add order MPID", add_mpid},
+      {"E order executed",
+       ItchMessageBuilder::build_order_executed(1, 1, 1000, 111, 50, 999)},
+      {"D order delete",
+       ItchMessageBuilder::build_order_delete(1, 1, 1000, 111)},
+      {"P trade", ItchMessageBuilder::build_trade(1, 1, 1000, 111, 'S', 100,
+                                                  "AAPL    ", 1500000, 999)},
+      {"Q cross trade",
+       ItchMessageBuilder::build_cross_trade(1, 1000, 1500000, 999, 'O')},
+      {"B broken trade", ItchMessageBuilder::build_broken_trade(1, 999)},
+      {"I NOII", ItchMessageBuilder::build_noii(1, 100, 50, 'B', 1500000)},
+  };
+
+  ItchParser parser;
+  NormalizedMessage output[MESSAGES];
+  std::cout << "✓ Per-type performance test passed\n";
+  for (const auto &sample : samples) {
+    const auto packet = ItchMessageBuilder::build_packet(
+        std::vector<std::vector<uint8_t>>(MESSAGES, sample.second));
+    MessageView view{packet.data(), static_cast<uint32_t>(packet.size()),
+                     1000, 0};
+    assert(parser.parse(view, output, MESSAGES) == MESSAGES);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+      parser.parse(view, output, MESSAGES);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double per_message =
+        static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                .count()) /
+        (static_cast<double>(ITERATIONS) * MESSAGES);
+    std::cout << "  " << sample.first << ": " << per_message << " ns\n";
+  }
+}
+
 int main() {
   std::cout << "Running ITCH 5.0 Parser Tests\n";
   std::cout << "==============================\n\n";
@@ -377,6 +763,14 @@ int main() {
     test_multiple_messages();
     test_performance();
     test_statistics();
+    test_find_instrument();
+    test_status_messages();
+    test_auction_messages();
+    test_unsupported_messages();
+    test_order_store();
+    test_order_tracking();
+    test_order_replace();
+    test_per_type_performance();
 
     std::cout << "\n All ITCH 5.0 parser tests passed!\n";
     return 0;
@@ -1,5 +1,7 @@
 #include "../core/distribution/lockfree_queue.hpp"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <thread>
 #include <vector>
@@ -222,6 +224,157 @@ void test_mpsc_queue() {
   std::cout << "✓ MPSC queue test passed\n";
 }
 
+// Test 8: In-place claim/commit
+void test_claim_commit() {
+  struct Record {
+    uint64_t id;
+    uint64_t payload[7];
+  };
+
+  SPSCQueue<Record, 4> queue; // 3 usable slots
+
+  // Build elements directly in queue memory
+  for (uint64_t i = 0; i < 3; i++) {
+    Record *slot = queue.try_claim();
+    assert(slot != nullptr);
+    slot->id = i;
+    slot->payload[6] = i * 10;
+    queue.commit();
+  }
+
+  // Full queue refuses further claims
+  assert(queue.try_claim() == nullptr);
+
+  // Claimed but uncommitted slots are invisible to the consumer
+  Record value{};
+  assert(queue.pop(value));
+  assert(queue.try_claim() != nullptr);
+  assert(queue.size() == 2);
+
+  for (uint64_t i = 1; i < 3; i++) {
+    assert(queue.pop(value));
+    assert(value.id == i);
+    assert(value.payload[6] == i * 10);
+  }
+  assert(!queue.pop(value));
+
+  std::cout << "✓ Claim/commit test passed\n";
+}
+
+// Test 9: Emplace constructs in the slot
+void test_emplace() {
+  struct Pair {
+    int a;
+    int b;
+    Pair() : a(0), b(0) {}
+    Pair(int x, int y) : a(x), b(y) {}
+  };
+
+  SPSCQueue<Pair, 16> queue;
+
+  assert(queue.emplace(1, 2));
+  assert(queue.emplace(3, 4));
+
+  Pair value;
+  assert(queue.pop(value));
+  assert(value.a == 1 && value.b == 2);
+  assert(queue.pop(value));
+  assert(value.a == 3 && value.b == 4);
+
+  std::cout << "✓ Emplace test passed\n";
+}
+
+// Test 10: Batch push/pop
+void test_batch_operations() {
+  SPSCQueue<int, 16> queue; // 15 usable slots
+
+  int input[20];
+  for (int i = 0; i < 20; i++) {
+    input[i] = i;
+  }
+
+  // Partial push when the batch exceeds free space
+  assert(queue.push_n(input, 10) == 10);
+  assert(queue.push_n(input + 10, 10) == 5);
+  assert(queue.push_n(input, 1) == 0);
+  assert(queue.size() == 15);
+
+  // Partial pop, then wrap around the end of the buffer
+  int output[20];
+  assert(queue.pop_n(output, 8) == 8);
+  for (int i = 0; i < 8; i++) {
+    assert(output[i] == i);
+  }
+
+  assert(queue.push_n(input + 15, 5) == 5);
+  assert(queue.pop_n(output, 20) == 12);
+  for (int i = 0; i < 12; i++) {
+    assert(output[i] == i + 8);
+  }
+  assert(queue.pop_n(output, 4) == 0);
+  assert(queue.empty());
+
+  // Single and batch operations interleave in FIFO order
+  assert(queue.push(100));
+  assert(queue.push_n(input, 2) == 2);
+  int value;
+  assert(queue.pop(value) && value == 100);
+  assert(queue.pop_n(output, 4) == 2);
+  assert(output[0] == 0 && output[1] == 1);
+
+  std::cout << "✓ Batch operations test passed\n";
+}
+
+// Test 11: Batch thread safety (single producer, single consumer)
+void test_batch_thread_safety() {
+  static constexpr size_t NUM_ITEMS = 1000000;
+  static constexpr size_t BATCH = 64;
+  SPSCQueue<uint64_t, 1024> queue;
+
+  std::thread producer([&queue]() {
+    uint64_t batch[BATCH];
+    uint64_t next = 0;
+    while (next < NUM_ITEMS) {
+      size_t count = std::min(BATCH, NUM_ITEMS - next);
+      for (size_t i = 0; i < count; i++) {
+        batch[i] = next + i;
+      }
+
+      size_t pushed = 0;
+      while (pushed < count) {
+        size_t n = queue.push_n(batch + pushed, count - pushed);
+        if (n == 0) {
+          std::this_thread::yield();
+        }
+        pushed += n;
+      }
+      next += count;
+    }
+  });
+
+  std::thread consumer([&queue]() {
+    uint64_t batch[BATCH];
+    uint64_t expected = 0;
+    while (expected < NUM_ITEMS) {
+      size_t n = queue.pop_n(batch, BATCH);
+      if (n == 0) {
+        std::this_thread::yield();
+      }
+      for (size_t i = 0; i < n; i++) {
+        assert(batch[i] == expected);
+        expected++;
+      }
+    }
+  });
+
+  producer.join();
+  consumer.join();
+
+  assert(queue.empty());
+
+  std::cout << "✓ Batch thread safety test passed (1M items)\n";
+}
+
 int main() {
   std::cout << "Running Lock-Free Queue Tests\n";
   std::cout << "==============================\n\n";
@@ -234,6 +387,10 @@ int main() {
     test_move_semantics();
     test_performance();
     test_mpsc_queue();
+    test_claim_commit();
+    test_emplace();
+    test_batch_operations();
+    test_batch_thread_safety();
 
     std::cout << "\n✅ All tests passed!\n";
     return 0;
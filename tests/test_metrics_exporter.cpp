@@ -0,0 +1,203 @@
+#include "../core/core_engine.hpp"
+#include "../core/metrics/metrics_exporter.hpp"
+#include "../core/metrics/prometheus.hpp"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace hft::core;
+
+// One blocking HTTP exchange with the exporter
+static std::string http_request(uint16_t port, const std::string &request) {
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  assert(fd >= 0);
+  struct sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  const int connected =
+      connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+  assert(connected == 0);
+  if (connected != 0) {
+    close(fd);
+    return std::string();
+  }
+
+  // No SIGPIPE if the exporter has already closed the connection
+  send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+  std::string response;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+    response.append(buffer, static_cast<size_t>(n));
+  }
+  close(fd);
+  return response;
+}
+
+static std::string get(uint16_t port, const char *path) {
+  return http_request(port, std::string("GET ") + path +
+                                " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+}
+
+// Value of the first sample line starting with prefix
+static uint64_t sample_value(const std::string &text,
+                             const std::string &prefix) {
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.rfind(prefix + " ", 0) == 0) {
+      return std::stoull(line.substr(prefix.size() + 1));
+    }
+  }
+  assert(false && "sample not found");
+  return 0;
+}
+
+// Test 1: Text format - families, labels, cumulative buckets
+void test_text_format() {
+  LatencyHistogram histogram;
+  histogram.record(80);       // <= 100ns
+  histogram.record(2000);     // <= 2.5us
+  histogram.record(2000);
+  histogram.record(50000000); // Beyond the last bound
+
+  PrometheusText text;
+  text.family("test_total", "counter", "A counter");
+  text.sample("test_total", {{"name", "a\"b\\c"}}, 7);
+  text.family("test_seconds", "histogram", "A histogram");
+  text.latency_histogram("test_seconds", {{"stage", "parse"}}, histogram);
+  const std::string &out = text.str();
+
+  assert(out.rfind("# HELP test_total A counter\n"
+                   "# TYPE test_total counter\n",
+                   0) == 0);
+  assert(out.find("test_total{name=\"a\\\"b\\\\c\"} 7\n") !=
+         std::string::npos);
+  const std::string bucket = "test_seconds_bucket{stage=\"parse\",le=";
+  assert(sample_value(out, bucket + "\"1e-07\"}") == 1);
+  assert(sample_value(out, bucket + "\"2.5e-06\"}") == 3);
+  assert(sample_value(out, bucket + "\"0.01\"}") == 3);
+  assert(sample_value(out, bucket + "\"+Inf\"}") == 4);
+  assert(sample_value(out, "test_seconds_count{stage=\"parse\"}") == 4);
+  assert(out.find("test_seconds_sum{stage=\"parse\"} 0.05000408\n") !=
+         std::string::npos);
+
+  // le = 250ns covers its whole sub-bucket (250-251ns), not 252ns
+  LatencyHistogram edges;
+  edges.record(251);
+  edges.record(252);
+  PrometheusText edge_text;
+  edge_text.latency_histogram("edge_seconds", {}, edges);
+  assert(sample_value(edge_text.str(), "edge_seconds_bucket{le=\"2.5e-07\"}") ==
+         1);
+  assert(sample_value(edge_text.str(), "edge_seconds_bucket{le=\"5e-07\"}") ==
+         2);
+  assert(sample_value(edge_text.str(), "edge_seconds_count") == 2);
+
+  std::cout << "✓ Text format test passed\n";
+}
+
+// Test 2: Engine metrics cover counters, stages and subscribers
+void test_engine_metrics() {
+  CoreEngine engine;
+  SubscriberOptions options;
+  options.inline_dispatch = true;
+  engine.add_subscriber(
+      make_subscriber("inline", [](const NormalizedMessage &) { return true; }),
+      options);
+  engine.add_subscriber(make_subscriber(
+      "queued", [](const NormalizedMessage &) { return true; }));
+
+  uint8_t payload[16] = {};
+  for (uint32_t i = 0; i < 50; ++i) {
+    MessageView view(payload, sizeof(payload), get_timestamp(), i);
+    engine.process_packet(view);
+  }
+
+  const std::string text = engine.metrics_text();
+  assert(sample_value(text, "hft_messages_parsed_total") == 50);
+  assert(sample_value(text, "hft_messages_dispatched_total") == 50);
+  assert(sample_value(text, "hft_parse_errors_total") == 0);
+  assert(sample_value(text,
+                      "hft_stage_latency_seconds_count{stage=\"parse\"}") ==
+         50);
+  assert(sample_value(text, "hft_subscriber_delivered_total"
+                            "{id=\"0\",subscriber=\"inline\"}") == 50);
+  assert(sample_value(text, "hft_subscriber_queue_depth"
+                            "{id=\"1\",subscriber=\"queued\"}") == 50);
+  assert(text.find("hft_subscriber_delivery_latency_seconds_count{id=\"1\"") !=
+         std::string::npos);
+  // Each family is declared exactly once
+  assert(text.find("# TYPE hft_stage_latency_seconds histogram") ==
+         text.rfind("# TYPE hft_stage_latency_seconds histogram"));
+
+  std::cout << "✓ Engine metrics test passed\n";
+}
+
+// Test 3: Exporter serves /metrics over HTTP from its own thread
+void test_http_exporter() {
+  std::atomic<uint64_t> renders{0};
+  MetricsExporter exporter([&renders] {
+    renders++;
+    return std::string("hft_up 1\n");
+  });
+  assert(exporter.port() == 0);
+  const bool started = exporter.start(0);
+  assert(started);
+  (void)started;
+  const uint16_t port = exporter.port();
+  assert(port != 0);
+
+  const std::string ok = get(port, "/metrics");
+  assert(ok.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+  assert(ok.find("Content-Type: text/plain; version=0.0.4") !=
+         std::string::npos);
+  assert(ok.find("Content-Length: 9\r\n") != std::string::npos);
+  assert(ok.substr(ok.size() - 9) == "hft_up 1\n");
+
+  const std::string missing = get(port, "/other");
+  assert(missing.rfind("HTTP/1.1 404", 0) == 0);
+  const std::string post =
+      http_request(port, "POST /metrics HTTP/1.1\r\n\r\n");
+  assert(post.rfind("HTTP/1.1 405", 0) == 0);
+  assert(exporter.scrapes() == 1);
+  assert(renders == 1);
+
+  // Port in use
+  MetricsExporter clash([] { return std::string(); });
+  const bool clashed = clash.start(port);
+  assert(!clashed);
+  (void)clashed;
+
+  exporter.stop();
+  assert(!exporter.is_running());
+  assert(exporter.port() == 0);
+
+  std::cout << "✓ HTTP exporter test passed\n";
+}
+
+int main() {
+  std::cout << "Running Metrics Exporter Tests\n";
+  std::cout << "==============================\n\n";
+
+  try {
+    test_text_format();
+    test_engine_metrics();
+    test_http_exporter();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,281 @@
+#include "../core/book/order_book.hpp"
+#include "test_helpers.hpp"
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace hft::core;
+
+static OrderBookConfig small_config() {
+  OrderBookConfig config;
+  config.max_orders = 1024;
+  config.max_levels = 256;
+  config.max_instruments = 16;
+  config.reserve_levels = 8;
+  return config;
+}
+
+// Test 1: Levels sort best first on both sides
+void test_price_levels() {
+  OrderBook book(small_config());
+  BookLevel level;
+  assert(!book.best(1, OrderBook::BID, level));
+
+  assert(book.add_order(1, 1, OrderBook::BID, 1000000, 100));
+  assert(book.add_order(1, 2, OrderBook::BID, 1000100, 200));
+  assert(book.add_order(1, 3, OrderBook::BID, 999900, 300));
+  assert(book.add_order(1, 4, OrderBook::BID, 1000100, 50));
+  assert(book.add_order(1, 5, OrderBook::ASK, 1000300, 10));
+  assert(book.add_order(1, 6, OrderBook::ASK, 1000200, 20));
+
+  BookLevel bids[8];
+  assert(book.depth(1, OrderBook::BID, bids, 8) == 3);
+  assert(bids[0].price == 1000100 && bids[0].quantity == 250 &&
+         bids[0].orders == 2);
+  assert(bids[1].price == 1000000 && bids[1].quantity == 100);
+  assert(bids[2].price == 999900);
+  assert(book.depth(1, OrderBook::BID, bids, 1) == 1);
+
+  assert(book.best(1, OrderBook::ASK, level));
+  assert(level.price == 1000200 && level.quantity == 20);
+  assert(book.order_count() == 6);
+  assert(book.level_count() == 5);
+
+  // Other instruments have their own books
+  assert(!book.best(2, OrderBook::BID, level));
+  assert(book.add_order(2, 7, OrderBook::BID, 5, 1));
+  assert(book.best(2, OrderBook::BID, level) && level.price == 5);
+  assert(book.best(1, OrderBook::BID, level) && level.price == 1000100);
+
+  std::cout << "✓ Price levels test passed\n";
+}
+
+// Test 2: Executions, cancels and deletes keep time priority
+void test_order_lifecycle() {
+  OrderBook book(small_config());
+  for (uint64_t id = 1; id <= 3; ++id) {
+    assert(book.add_order(1, id, OrderBook::ASK, 1000000, 100 * id));
+  }
+
+  std::vector<uint64_t> queue;
+  auto collect = [&queue](const BookOrder &order) {
+    queue.push_back(order.order_id);
+  };
+  assert(book.for_each_order(1, OrderBook::ASK, 1000000, collect) == 3);
+  assert((queue == std::vector<uint64_t>{1, 2, 3}));
+
+  // Partial execution keeps the order at the front
+  assert(book.apply(
+      order_message(NormalizedMessage::Type::ORDER_EXECUTE, 1, 0, 0, 40)));
+  BookOrder order;
+  assert(book.find_order(1, order));
+  assert(order.quantity == 60 && order.price == 1000000 &&
+         order.side == OrderBook::ASK && order.instrument_id == 1);
+  queue.clear();
+  book.for_each_order(1, OrderBook::ASK, 1000000, collect);
+  assert((queue == std::vector<uint64_t>{1, 2, 3}));
+
+  // Cancels reduce, full executions remove
+  assert(book.apply(
+      order_message(NormalizedMessage::Type::ORDER_MODIFY, 2, 0, 0, 50)));
+  assert(book.apply(
+      order_message(NormalizedMessage::Type::ORDER_EXECUTE, 1, 0, 0, 60)));
+  assert(!book.find_order(1, order));
+  BookLevel level;
+  assert(book.best(1, OrderBook::ASK, level));
+  assert(level.quantity == 150 + 300 && level.orders == 2);
+
+  // Deleting from the middle of the queue
+  assert(book.add_order(1, 4, OrderBook::ASK, 1000000, 5));
+  assert(book.apply(
+      order_message(NormalizedMessage::Type::ORDER_DELETE, 3, 0, 0, 0)));
+  queue.clear();
+  book.for_each_order(1, OrderBook::ASK, 1000000, collect);
+  assert((queue == std::vector<uint64_t>{2, 4}));
+
+  // Emptied levels disappear
+  assert(book.delete_order(2));
+  assert(book.delete_order(4));
+  assert(!book.best(1, OrderBook::ASK, level));
+  assert(book.order_count() == 0 && book.level_count() == 0);
+
+  // Unknown orders and other message types
+  assert(!book.apply(
+      order_message(NormalizedMessage::Type::ORDER_DELETE, 99, 0, 0, 0)));
+  assert(
+      book.apply(order_message(NormalizedMessage::Type::TRADE, 99, 0, 0, 10)));
+
+  const OrderBookStats &stats = book.stats();
+  assert(stats.executions == 2 && stats.cancels == 1 && stats.deletes == 2);
+  assert(stats.unknown_orders == 1);
+
+  std::cout << "✓ Order lifecycle test passed\n";
+}
+
+// Test 3: Full pools, duplicates and out-of-range instruments are refused
+void test_rejects() {
+  OrderBookConfig config = small_config();
+  config.max_orders = 4;
+  config.max_levels = 2;
+  OrderBook book(config);
+
+  assert(book.add_order(1, 1, OrderBook::BID, 100, 1));
+  assert(!book.add_order(1, 1, OrderBook::BID, 100, 1)); // Duplicate
+  assert(book.add_order(1, 2, OrderBook::BID, 101, 1));
+  assert(!book.add_order(1, 3, OrderBook::BID, 102, 1)); // No level left
+  assert(book.add_order(1, 3, OrderBook::BID, 101, 1));
+  assert(book.add_order(1, 4, OrderBook::BID, 100, 1));
+  assert(!book.add_order(1, 5, OrderBook::BID, 100, 1)); // No order left
+  assert(!book.add_order(16, 6, OrderBook::BID, 100, 1));
+  assert(!book.add_order(1, 6, 2, 100, 1));
+  assert(book.stats().rejected == 5);
+
+  // A refused add leaves no trace
+  BookOrder order;
+  assert(!book.find_order(5, order));
+  assert(book.order_count() == 4);
+
+  // Freed nodes are reused
+  assert(book.delete_order(2));
+  assert(book.delete_order(3));
+  assert(book.add_order(1, 7, OrderBook::ASK, 200, 1));
+
+  book.clear();
+  assert(book.order_count() == 0 && book.level_count() == 0);
+  assert(!book.find_order(1, order));
+  assert(book.stats().adds == 0);
+  for (uint64_t id = 10; id < 14; ++id) {
+    assert(book.add_order(1, id, OrderBook::ASK, 200, 1));
+  }
+
+  std::cout << "✓ Rejects test passed\n";
+}
+
+// Test 4: Random activity matches a simple reference model
+void test_against_model() {
+  OrderBookConfig config = small_config();
+  config.max_orders = 4096;
+  config.max_levels = 1024;
+  OrderBook book(config);
+
+  struct Model {
+    uint32_t instrument;
+    uint8_t side;
+    int64_t price;
+    uint64_t quantity;
+  };
+  std::unordered_map<uint64_t, Model> orders;
+  std::mt19937_64 rng(42);
+  uint64_t next_id = 1;
+
+  for (int step = 0; step < 200000; ++step) {
+    const uint64_t action = rng() % 10;
+    if (orders.size() < 2000 && (action < 5 || orders.empty())) {
+      const Model model{static_cast<uint32_t>(rng() % 4),
+                        static_cast<uint8_t>(rng() % 2),
+                        static_cast<int64_t>(1000 + rng() % 40),
+                        1 + rng() % 500};
+      // Ids advance with gaps, as exchange references do
+      next_id += 1 + rng() % 3;
+      assert(book.add_order(model.instrument, next_id, model.side,
+                            model.price, model.quantity));
+      orders[next_id] = model;
+      continue;
+    }
+
+    auto it = orders.begin();
+    std::advance(it, rng() % std::min<size_t>(orders.size(), 16));
+    if (action < 8) {
+      const uint64_t quantity = 1 + rng() % 300;
+      assert(book.reduce_order(it->first, quantity));
+      if (quantity >= it->second.quantity) {
+        orders.erase(it);
+      } else {
+        it->second.quantity -= quantity;
+      }
+    } else {
+      assert(book.delete_order(it->first));
+      orders.erase(it);
+    }
+  }
+
+  // Aggregate the model per level and compare every book
+  std::map<int64_t, std::pair<uint64_t, uint32_t>> expected[4][2];
+  for (const auto &entry : orders) {
+    BookOrder order;
+    assert(book.find_order(entry.first, order));
+    assert(order.quantity == entry.second.quantity);
+    assert(order.price == entry.second.price);
+    auto &level =
+        expected[entry.second.instrument][entry.second.side][order.price];
+    level.first += order.quantity;
+    level.second++;
+  }
+  assert(book.order_count() == orders.size());
+
+  size_t levels = 0;
+  for (uint32_t instrument = 0; instrument < 4; ++instrument) {
+    for (uint8_t side = 0; side < 2; ++side) {
+      BookLevel depth[64];
+      const size_t count = book.depth(instrument, side, depth, 64);
+      assert(count == expected[instrument][side].size());
+      levels += count;
+      for (size_t i = 0; i < count; ++i) {
+        const auto &level = expected[instrument][side][depth[i].price];
+        assert(depth[i].quantity == level.first);
+        assert(depth[i].orders == level.second);
+        if (i > 0) {
+          assert(side == OrderBook::BID ? depth[i].price < depth[i - 1].price
+                                        : depth[i].price > depth[i - 1].price);
+        }
+      }
+    }
+  }
+  assert(book.level_count() == levels);
+
+  std::cout << "✓ Reference model test passed (" << orders.size()
+            << " orders resting)\n";
+}
+
+// Test 5: Subscriber applies delivered batches
+void test_subscriber() {
+  OrderBookSubscriber subscriber(small_config());
+  NormalizedMessage msgs[3];
+  msgs[0] = order_message(NormalizedMessage::Type::ORDER_ADD, 1,
+                          OrderBook::BID, 1000000, 100);
+  msgs[1] = order_message(NormalizedMessage::Type::ORDER_ADD, 2,
+                          OrderBook::ASK, 1000100, 100);
+  msgs[2] =
+      order_message(NormalizedMessage::Type::ORDER_EXECUTE, 1, 0, 0, 30);
+
+  assert(subscriber.on_messages(msgs, 3));
+  BookLevel level;
+  assert(subscriber.book().best(1, OrderBook::BID, level));
+  assert(level.price == 1000000 && level.quantity == 70);
+  assert(subscriber.book().best(1, OrderBook::ASK, level));
+  assert(level.price == 1000100);
+
+  std::cout << "✓ Subscriber test passed\n";
+}
+
+int main() {
+  std::cout << "Running Order Book Tests\n";
+  std::cout << "========================\n\n";
+
+  try {
+    test_price_levels();
+    test_order_lifecycle();
+    test_rejects();
+    test_against_model();
+    test_subscriber();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
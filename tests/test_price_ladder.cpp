@@ -0,0 +1,323 @@
+#include "../core/book/price_ladder.hpp"
+#include "../protocols/itch50/itch50_parser.hpp"
+#include "test_helpers.hpp"
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace hft::core;
+using namespace hft::protocols::itch50;
+
+// Test 1: Levels aggregate orders and sort best first
+void test_levels() {
+  PriceLadder ladder;
+  BookLevel level;
+  assert(!ladder.best(PriceLadder::BID, level));
+
+  ladder.add(PriceLadder::BID, 1000000, 100);
+  ladder.add(PriceLadder::BID, 1000100, 200);
+  ladder.add(PriceLadder::BID, 999900, 300);
+  ladder.add(PriceLadder::BID, 1000100, 50);
+  ladder.add(PriceLadder::ASK, 1000300, 10);
+  ladder.add(PriceLadder::ASK, 1000200, 20);
+
+  BookLevel bids[8];
+  assert(ladder.depth(PriceLadder::BID, bids, 8) == 3);
+  assert(bids[0].price == 1000100 && bids[0].quantity == 250 &&
+         bids[0].orders == 2);
+  assert(bids[1].price == 1000000 && bids[1].quantity == 100);
+  assert(bids[2].price == 999900);
+
+  assert(ladder.best(PriceLadder::ASK, level));
+  assert(level.price == 1000200 && level.quantity == 20);
+  assert(ladder.level(PriceLadder::ASK, 1000300, level) &&
+         level.quantity == 10);
+  assert(!ladder.level(PriceLadder::ASK, 1000400, level));
+  assert(ladder.level_count() == 5);
+
+  // Partial reductions keep the level, the last shares remove it
+  assert(ladder.reduce(PriceLadder::BID, 1000100, 200, 1));
+  assert(ladder.best(PriceLadder::BID, level));
+  assert(level.price == 1000100 && level.quantity == 50 && level.orders == 1);
+  assert(ladder.reduce(PriceLadder::BID, 1000100, 50, 1));
+  assert(ladder.best(PriceLadder::BID, level) && level.price == 1000000);
+  assert(!ladder.reduce(PriceLadder::BID, 1000100, 1));
+  assert(ladder.level_count() == 4);
+  assert(ladder.recentres() == 0 && ladder.overflow_levels() == 0);
+
+  std::cout << "✓ Levels test passed\n";
+}
+
+// Test 2: Bit scans walk levels spread across bitmap words
+void test_bit_scan() {
+  PriceLadder ladder(1, 4096);
+  const int64_t base = 100000;
+  ladder.add(PriceLadder::BID, base, 1);
+  const int64_t low = ladder.window_base();
+  const int64_t prices[] = {low, low + 63, low + 64, low + 700, low + 2047,
+                            low + 4095};
+  for (int64_t price : prices) {
+    ladder.add(PriceLadder::BID, price, 1);
+    ladder.add(PriceLadder::ASK, price, 1);
+  }
+  assert(ladder.overflow_levels() == 0);
+
+  BookLevel depth[16];
+  const size_t bids = ladder.depth(PriceLadder::BID, depth, 16);
+  assert(bids == 7);
+  for (size_t i = 1; i < bids; ++i) {
+    assert(depth[i].price < depth[i - 1].price);
+  }
+  assert(depth[0].price == low + 4095 && depth[6].price == low);
+
+  const size_t asks = ladder.depth(PriceLadder::ASK, depth, 16);
+  assert(asks == 6);
+  for (size_t i = 1; i < asks; ++i) {
+    assert(depth[i].price > depth[i - 1].price);
+  }
+  assert(depth[0].price == low && depth[5].price == low + 4095);
+
+  // Emptying a whole word moves the best to the next one
+  ladder.reduce(PriceLadder::ASK, low, 1);
+  ladder.reduce(PriceLadder::ASK, low + 63, 1);
+  BookLevel level;
+  assert(ladder.best(PriceLadder::ASK, level) && level.price == low + 64);
+
+  std::cout << "✓ Bit scan test passed\n";
+}
+
+// Test 3: The window follows the touch; far and off-grid levels overflow
+void test_recentre() {
+  PriceLadder ladder(100, 64);
+  ladder.add(PriceLadder::BID, 1000000, 100);
+  ladder.add(PriceLadder::ASK, 1000100, 100);
+  const int64_t base = ladder.window_base();
+
+  // Deep levels outside the window, and a sub-penny price
+  ladder.add(PriceLadder::BID, 900000, 5);
+  ladder.add(PriceLadder::ASK, 1000150, 7);
+  assert(ladder.overflow_levels() == 2 && ladder.recentres() == 0);
+
+  BookLevel asks[4];
+  assert(ladder.depth(PriceLadder::ASK, asks, 4) == 2);
+  assert(asks[0].price == 1000100 && asks[1].price == 1000150);
+
+  // An improving bid far above the window moves it; the old touch falls
+  // out and is still reported
+  ladder.add(PriceLadder::BID, 1010000, 10);
+  ladder.add(PriceLadder::ASK, 1010100, 20);
+  assert(ladder.recentres() >= 1);
+  assert(ladder.window_base() != base);
+
+  BookLevel level;
+  assert(ladder.best(PriceLadder::BID, level) && level.price == 1010000);
+  assert(ladder.best(PriceLadder::ASK, level) && level.price == 1000100);
+  BookLevel bids[4];
+  assert(ladder.depth(PriceLadder::BID, bids, 4) == 3);
+  assert(bids[1].price == 1000000 && bids[1].quantity == 100);
+  assert(bids[2].price == 900000 && bids[2].quantity == 5);
+
+  // Moving back pulls overflow levels into the window again
+  assert(ladder.reduce(PriceLadder::BID, 1010000, 10));
+  ladder.add(PriceLadder::ASK, 1000050, 1); // Off grid: overflow
+  ladder.add(PriceLadder::ASK, 999900, 3);  // Improves: recentres
+  assert(ladder.level(PriceLadder::BID, 1000000, level) &&
+         level.quantity == 100);
+  assert(ladder.level_count() == 7);
+  assert(ladder.reduce(PriceLadder::BID, 900000, 5));
+  assert(ladder.reduce(PriceLadder::ASK, 1000150, 7));
+
+  ladder.clear();
+  assert(ladder.empty() && ladder.level_count() == 0);
+  assert(!ladder.best(PriceLadder::ASK, level));
+
+  // A full overflow keeps its best levels and counts the rest
+  PriceLadder bounded(100, 64, 2);
+  assert(bounded.add(PriceLadder::BID, 1000000, 1));
+  assert(bounded.add(PriceLadder::BID, 900000, 2));
+  assert(bounded.add(PriceLadder::BID, 800000, 3));
+  assert(!bounded.add(PriceLadder::BID, 700000, 4)); // Worst: dropped
+  assert(!bounded.add(PriceLadder::BID, 950000, 5)); // Pushes out 800000
+  assert(bounded.overflow_levels() == 2 && bounded.dropped_levels() == 2);
+  assert(bounded.depth(PriceLadder::BID, bids, 4) == 3);
+  assert(bids[1].price == 950000 && bids[2].price == 900000);
+  assert(!bounded.reduce(PriceLadder::BID, 800000, 3));
+
+  std::cout << "✓ Recentre test passed\n";
+}
+
+// Test 4: A drifting random walk matches a std::map reference
+void test_against_model() {
+  PriceLadder ladder(100, 64, 4096);
+  std::map<int64_t, std::pair<uint64_t, uint32_t>> model[2];
+  std::mt19937_64 rng(7);
+  int64_t mid = 500000;
+
+  for (int step = 0; step < 300000; ++step) {
+    // Drift far enough to leave the window many times
+    if (rng() % 64 == 0) {
+      mid += (static_cast<int64_t>(rng() % 21) - 10) * 100;
+      mid = std::max<int64_t>(mid, 100000);
+    }
+    const uint8_t side = rng() % 2;
+    auto &levels = model[side];
+    if (levels.empty() || rng() % 2 == 0) {
+      const int64_t ticks = 1 + static_cast<int64_t>(rng() % 40);
+      int64_t price = side == PriceLadder::BID ? mid - ticks * 100
+                                               : mid + ticks * 100;
+      if (rng() % 50 == 0) {
+        price += 25; // Off the tick grid
+      }
+      const uint64_t quantity = 1 + rng() % 500;
+      ladder.add(side, price, quantity);
+      levels[price].first += quantity;
+      levels[price].second++;
+    } else {
+      auto it = levels.begin();
+      std::advance(it, rng() % levels.size());
+      const uint64_t quantity = 1 + rng() % 400;
+      assert(ladder.reduce(side, it->first, quantity, 1));
+      if (quantity >= it->second.first) {
+        levels.erase(it);
+      } else {
+        it->second.first -= quantity;
+        it->second.second -= std::min<uint32_t>(1, it->second.second);
+      }
+    }
+
+    if (step % 997 == 0) {
+      for (uint8_t s = 0; s < 2; ++s) {
+        std::vector<BookLevel> depth(model[s].size() + 1);
+        const size_t count = ladder.depth(s, depth.data(), depth.size());
+        assert(count == model[s].size());
+        size_t i = 0;
+        auto check = [&](const auto &entry) {
+          assert(depth[i].price == entry.first);
+          assert(depth[i].quantity == entry.second.first);
+          assert(depth[i].orders == entry.second.second);
+          i++;
+        };
+        if (s == PriceLadder::BID) {
+          for (auto it = model[s].rbegin(); it != model[s].rend(); ++it) {
+            check(*it);
+          }
+        } else {
+          for (const auto &entry : model[s]) {
+            check(entry);
+          }
+        }
+      }
+    }
+  }
+  assert(ladder.level_count() == model[0].size() + model[1].size());
+  assert(ladder.recentres() > 0 && ladder.dropped_levels() == 0);
+
+  std::cout << "✓ Reference model test passed (" << ladder.recentres()
+            << " recentres, " << ladder.overflow_levels()
+            << " levels in overflow)\n";
+}
+
+// Test 5: The book and subscriber apply enriched order messages
+void test_book() {
+  PriceLadderConfig config;
+  config.max_instruments = 16;
+  config.max_ladders = 2;
+  PriceLadderSubscriber subscriber(config);
+  using Type = NormalizedMessage::Type;
+
+  NormalizedMessage msgs[4];
+  msgs[0] = order_message(Type::ORDER_ADD, 0, 0, 1000000, 100);
+  msgs[1] = order_message(Type::ORDER_ADD, 0, 0, 1000000, 200);
+  msgs[2] = order_message(Type::ORDER_EXECUTE, 0, 0, 1000000, 30);
+  msgs[2].remaining_quantity = 70;
+  msgs[3] = order_message(Type::ORDER_DELETE, 0, 0, 1000000, 200);
+  assert(subscriber.on_messages(msgs, 4));
+
+  const PriceLadderBook &book = subscriber.book();
+  BookLevel level;
+  assert(book.best(1, PriceLadderBook::BID, level));
+  assert(level.quantity == 70 && level.orders == 1);
+  assert(!book.best(1, PriceLadderBook::ASK, level));
+  assert(!book.best(2, PriceLadderBook::BID, level));
+  assert(book.ladder(2) == nullptr);
+
+  // Events the ladder cannot place
+  PriceLadderBook &ladders = subscriber.book();
+  NormalizedMessage untracked =
+      order_message(Type::ORDER_DELETE, 0, 0, 1000000, 70);
+  untracked.flags = 0;
+  assert(!ladders.apply(untracked));
+  assert(!ladders.apply(order_message(Type::ORDER_MODIFY, 0, 1, 1000000, 1)));
+  NormalizedMessage far = order_message(Type::ORDER_ADD, 0, 0, 1000000, 1);
+  far.instrument_id = 16;
+  assert(!ladders.apply(far));
+  assert(ladders.apply(order_message(Type::TRADE, 0, 0, 1000000, 1)));
+
+  // Ladders come from the preallocated pool; once it is used up new
+  // instruments are rejected
+  NormalizedMessage other = order_message(Type::ORDER_ADD, 0, 1, 1000100, 5);
+  other.instrument_id = 3;
+  assert(ladders.apply(other));
+  other.instrument_id = 4;
+  assert(!ladders.apply(other));
+  assert(book.ladder(4) == nullptr && book.ladders_used() == 2);
+
+  const PriceLadderStats &stats = book.stats();
+  assert(stats.updates == 5 && stats.untracked == 1);
+  assert(stats.unmatched == 1 && stats.rejected == 2);
+
+  // The last shares take the order count with them
+  NormalizedMessage fill =
+      order_message(Type::ORDER_EXECUTE, 0, 0, 1000000, 70);
+  assert(ladders.apply(fill));
+  assert(!book.best(1, PriceLadderBook::BID, level));
+
+  ladders.clear();
+  assert(book.stats().updates == 0);
+
+  // An execution at its own price ('C') comes off the order's level, not
+  // the print price's
+  ItchParser parser;
+  parser.enable_order_tracking(16);
+  const std::vector<uint8_t> packet = ItchMessageBuilder::build_packet(
+      {ItchMessageBuilder::build_add_order(1, 0, 0, 42, 'B', 100, "TEST    ",
+                                           1000000),
+       ItchMessageBuilder::build_order_executed_with_price(1, 42, 30,
+                                                           1000100)});
+  const MessageView view(packet.data(), static_cast<uint32_t>(packet.size()),
+                         0, 0);
+  NormalizedMessage parsed[4];
+  const size_t count = parser.parse(view, parsed, 4);
+  assert(count == 3);
+  for (size_t i = 0; i < count; ++i) {
+    subscriber.on_message(parsed[i]);
+  }
+  assert(book.best(1, PriceLadderBook::BID, level));
+  assert(level.price == 1000000 && level.quantity == 70 && level.orders == 1);
+  BookLevel bids[4];
+  assert(book.depth(1, PriceLadderBook::BID, bids, 4) == 1);
+  assert(book.stats().unmatched == 0);
+
+  std::cout << "✓ Book test passed\n";
+}
+
+int main() {
+  std::cout << "Running Price Ladder Tests\n";
+  std::cout << "==========================\n\n";
+
+  try {
+    test_levels();
+    test_bit_scan();
+    test_recentre();
+    test_against_model();
+    test_book();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,187 @@
+#include "../core/core_engine.hpp"
+#include "../core/metrics/stats_page.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace hft::core;
+
+// Unique per process so parallel test runs do not collide
+static std::string page_name(const char *suffix) {
+  return "/hft-test-" + std::to_string(getpid()) + "-" + suffix;
+}
+
+static StatsPage make_page(uint64_t value, size_t subscribers) {
+  StatsPage page;
+  page.updated = value;
+  page.engine.packets_received = value;
+  page.engine.messages_parsed = value;
+  for (auto &stage : page.stages) {
+    stage.count = value;
+    stage.p99_ns = value;
+  }
+  for (size_t i = 0; i < subscribers; ++i) {
+    StatsPageSubscriber row;
+    row.id = i;
+    std::snprintf(row.name, sizeof(row.name), "sub-%zu", i);
+    row.delivered = value;
+    row.queue_depth = value;
+    page.subscribers.push_back(row);
+  }
+  return page;
+}
+
+// Test 1: Published page reads back intact in a separate mapping
+void test_round_trip() {
+  const std::string name = page_name("round-trip");
+  StatsPageWriter writer;
+  const bool created = writer.create(name, 4);
+  assert(created);
+  (void)created;
+
+  StatsPageReader reader;
+  const bool attached = reader.attach(name);
+  assert(attached);
+  (void)attached;
+  StatsPage page;
+  bool read = reader.read(page);
+  assert(read);
+  assert(page.pid == static_cast<uint64_t>(getpid()));
+  assert(page.updates == 0);
+  assert(page.subscribers.empty());
+
+  writer.publish(make_page(42, 3));
+  read = reader.read(page);
+  assert(read);
+  assert(page.updates == 1);
+  assert(page.updated == 42);
+  assert(page.engine.packets_received == 42);
+  assert(page.stages[3].p99_ns == 42);
+  assert(page.subscribers.size() == 3);
+  assert(std::strcmp(page.subscribers[2].name, "sub-2") == 0);
+  assert(page.subscribers[2].queue_depth == 42);
+
+  // Rows beyond the page's capacity are left out
+  writer.publish(make_page(43, 10));
+  read = reader.read(page);
+  assert(read);
+  assert(page.updates == 2);
+  assert(page.subscribers.size() == 4);
+
+  // Closing removes the page for new readers
+  writer.close();
+  StatsPageReader late;
+  const bool late_attached = late.attach(name);
+  assert(!late_attached);
+  (void)late_attached;
+  read = late.read(page);
+  assert(!read);
+  (void)read;
+
+  std::cout << "✓ Round trip test passed\n";
+}
+
+// Test 2: Readers never see a half-written page
+void test_consistent_reads() {
+  const std::string name = page_name("consistent");
+  StatsPageWriter writer;
+  const bool created = writer.create(name, 8);
+  assert(created);
+  (void)created;
+  StatsPageReader reader;
+  const bool attached = reader.attach(name);
+  assert(attached);
+  (void)attached;
+
+  std::atomic<bool> done{false};
+  std::thread publisher([&] {
+    for (uint64_t i = 1; i <= 20000; ++i) {
+      writer.publish(make_page(i, 1 + i % 8));
+    }
+    done.store(true);
+  });
+
+  uint64_t reads = 0;
+  uint64_t last = 0;
+  while (!done.load()) {
+    StatsPage page;
+    if (!reader.read(page)) {
+      continue;
+    }
+    const uint64_t value = page.updated;
+    assert(value >= last);
+    assert(page.engine.packets_received == value);
+    assert(page.engine.messages_parsed == value);
+    for (const auto &stage : page.stages) {
+      assert(stage.count == value);
+    }
+    if (value != 0) {
+      assert(page.subscribers.size() == 1 + value % 8);
+      assert(page.updates == value);
+    }
+    for (const auto &row : page.subscribers) {
+      assert(row.delivered == value);
+    }
+    last = value;
+    reads++;
+  }
+  publisher.join();
+  assert(reads > 0);
+
+  std::cout << "✓ Consistent reads test passed (" << reads << " reads)\n";
+}
+
+// Test 3: Engine snapshot covers counters, stages and subscribers
+void test_engine_page() {
+  CoreEngine engine;
+  SubscriberOptions options;
+  options.inline_dispatch = true;
+  engine.add_subscriber(
+      make_subscriber("inline-sink",
+                      [](const NormalizedMessage &) { return true; }),
+      options);
+  engine.add_subscriber(make_subscriber(
+      "queued-sink", [](const NormalizedMessage &) { return true; }));
+
+  uint8_t payload[16] = {};
+  for (uint32_t i = 0; i < 100; ++i) {
+    MessageView view(payload, sizeof(payload), get_timestamp(), i);
+    engine.process_packet(view);
+  }
+
+  const StatsPage page = engine.stats_page();
+  assert(page.engine.messages_parsed == 100);
+  assert(page.stages[static_cast<size_t>(LatencyStage::PARSE)].count == 100);
+  assert(page.subscribers.size() == 2);
+  assert(std::strcmp(page.subscribers[0].name, "inline-sink") == 0);
+  assert(page.subscribers[0].inline_dispatch);
+  assert(page.subscribers[0].delivered == 100);
+  // Queued subscriber's consumer thread is not running
+  assert(!page.subscribers[1].inline_dispatch);
+  assert(page.subscribers[1].delivered == 0);
+  assert(page.subscribers[1].queue_depth == 100);
+
+  std::cout << "✓ Engine page test passed\n";
+}
+
+int main() {
+  std::cout << "Running Stats Page Tests\n";
+  std::cout << "========================\n\n";
+
+  try {
+    test_round_trip();
+    test_consistent_reads();
+    test_engine_page();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
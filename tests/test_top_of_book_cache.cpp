@@ -0,0 +1,210 @@
+#include "../core/book/top_of_book_cache.hpp"
+#include "../core/core_engine.hpp"
+#include "../protocols/itch50/itch50_parser.hpp"
+#include "test_helpers.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace hft::core;
+using namespace hft::protocols::itch50;
+
+// Test 1: Quotes and trades land in the right fields
+void test_basic_updates() {
+  TopOfBookCache cache;
+  TopOfBook top;
+
+  assert(!cache.read(7, top)); // Never updated
+  assert(!cache.read(TopOfBookCache::MAX_INSTRUMENTS, top));
+
+  NormalizedMessage msg;
+  msg.type = NormalizedMessage::Type::QUOTE;
+  msg.instrument_id = 7;
+  msg.side = 0;
+  msg.price = 1000000;
+  msg.quantity = 100;
+  msg.timestamp = 1;
+  cache.update(msg);
+
+  msg.side = 1;
+  msg.price = 1000100;
+  msg.quantity = 200;
+  msg.timestamp = 2;
+  cache.update(msg);
+
+  assert(cache.read(7, top));
+  assert(top.bid_price == 1000000 && top.bid_quantity == 100);
+  assert(top.ask_price == 1000100 && top.ask_quantity == 200);
+  assert(top.last_price == 0);
+  assert(top.timestamp == 2);
+
+  msg.type = NormalizedMessage::Type::TRADE;
+  msg.price = 1000050;
+  msg.quantity = 50;
+  msg.timestamp = 3;
+  cache.update(msg);
+
+  // Executions without a price or at the resting price of a separate print,
+  // and order messages leave it alone
+  msg.type = NormalizedMessage::Type::ORDER_EXECUTE;
+  msg.price = 0;
+  cache.update(msg);
+  msg.price = 1000000;
+  msg.flags = NormalizedMessage::FLAG_PRINT_PRICE;
+  cache.update(msg);
+  msg.type = NormalizedMessage::Type::ORDER_ADD;
+  msg.price = 1;
+  cache.update(msg);
+
+  assert(cache.read(7, top));
+  assert(top.last_price == 1000050 && top.last_quantity == 50);
+  assert(top.bid_price == 1000000);
+  assert(top.timestamp == 3);
+  assert(!cache.read(8, top));
+
+  cache.clear();
+  assert(cache.read(7, top) && top.bid_price == 0 && top.last_price == 0);
+
+  std::cout << "✓ Basic updates test passed\n";
+}
+
+// Test 2: Readers on other threads never see a half-written entry
+void test_concurrent_reads() {
+  static constexpr uint64_t NUM_UPDATES = 1000000;
+  static constexpr uint64_t INSTRUMENT = 42;
+  TopOfBookCache cache;
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; ++i) {
+    readers.emplace_back([&cache, &done]() {
+      TopOfBook top;
+      uint64_t reads = 0;
+      while (!done.load() || reads == 0) {
+        if (!cache.read(INSTRUMENT, top)) {
+          continue;
+        }
+        // Each write keeps price, quantity and timestamp in step
+        assert(top.bid_quantity == static_cast<uint64_t>(top.bid_price));
+        assert(top.ask_quantity + 1 == static_cast<uint64_t>(top.ask_price) ||
+               top.ask_price == 0);
+        assert(top.timestamp == top.bid_quantity ||
+               top.timestamp == top.ask_quantity);
+        reads++;
+      }
+    });
+  }
+
+  for (uint64_t i = 1; i <= NUM_UPDATES; ++i) {
+    const int64_t price = static_cast<int64_t>(i);
+    cache.update_quote(INSTRUMENT, 0, price, i, i);
+    cache.update_quote(INSTRUMENT, 1, price + 1, i, i);
+  }
+  done.store(true);
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  std::cout << "✓ Concurrent reads test passed (1M updates, 3 readers)\n";
+}
+
+// Test 3: The engine derives the bid and offer from ITCH order flow
+void test_engine_order_flow() {
+  CoreConfig config;
+  config.book_top_of_book = true;
+  config.book.max_orders = 1024;
+  config.book.max_levels = 256;
+  CoreEngine engine(config);
+
+  // The books need order tracking; without it the engine will not start
+  engine.set_parser(std::make_unique<ItchParser>());
+  bool refused = false;
+  try {
+    engine.start();
+  } catch (const std::runtime_error &) {
+    refused = true;
+  }
+  assert(refused);
+  (void)refused;
+
+  auto parser = std::make_unique<ItchParser>();
+  parser->enable_order_tracking(1024);
+  engine.set_parser(std::move(parser));
+
+  static constexpr uint16_t LOCATE = 5;
+  using Builder = ItchMessageBuilder;
+  auto process = [&engine](const std::vector<std::vector<uint8_t>> &messages) {
+    const std::vector<uint8_t> packet = Builder::build_packet(messages);
+    return engine.process_packet(
+        MessageView(packet.data(), static_cast<uint32_t>(packet.size()),
+                    get_timestamp(), 0));
+  };
+  auto add = [](uint64_t ref, char side, uint32_t shares, uint32_t price) {
+    return Builder::build_add_order(LOCATE, 0, 1, ref, side, shares,
+                                    "TEST    ", price);
+  };
+  auto executed = [](uint64_t ref, uint32_t shares) {
+    return Builder::build_order_executed(LOCATE, 0, 1, ref, shares, 0);
+  };
+  auto remove = [](uint64_t ref) {
+    return Builder::build_order_delete(LOCATE, 0, 1, ref);
+  };
+
+  const size_t parsed =
+      process({add(1, 'B', 100, 1000000), add(2, 'B', 200, 1000100),
+               add(3, 'S', 300, 1000300), add(4, 'S', 50, 1000400)});
+  assert(parsed == 4);
+  (void)parsed;
+
+  TopOfBook top;
+  assert(engine.get_top_of_book(LOCATE, top));
+  assert(top.bid_price == 1000100 && top.bid_quantity == 200);
+  assert(top.ask_price == 1000300 && top.ask_quantity == 300);
+
+  // Executions and cancels shrink the touch, deletes move it
+  process({executed(2, 50), Builder::build_order_cancel(LOCATE, 3, 100)});
+  assert(engine.get_top_of_book(LOCATE, top));
+  assert(top.bid_price == 1000100 && top.bid_quantity == 150);
+  assert(top.ask_price == 1000300 && top.ask_quantity == 200);
+
+  process({remove(2), executed(3, 200)});
+  assert(engine.get_top_of_book(LOCATE, top));
+  assert(top.bid_price == 1000000 && top.bid_quantity == 100);
+  assert(top.ask_price == 1000400 && top.ask_quantity == 50);
+
+  // A replace moves the order: its old level goes
+  process({Builder::build_order_replace(LOCATE, 4, 5, 60, 1000350)});
+  assert(engine.get_top_of_book(LOCATE, top));
+  assert(top.ask_price == 1000350 && top.ask_quantity == 60);
+  process({remove(5)});
+  assert(engine.get_top_of_book(LOCATE, top));
+  assert(top.ask_price == 0 && top.ask_quantity == 0);
+
+  // An emptied side reads as no bid
+  process({add(6, 'S', 10, 1000400), remove(1)});
+  assert(engine.get_top_of_book(LOCATE, top));
+  assert(top.bid_price == 0 && top.bid_quantity == 0);
+  assert(top.ask_price == 1000400);
+  assert(!engine.get_top_of_book(LOCATE + 1, top));
+
+  std::cout << "✓ Engine order flow test passed\n";
+}
+
+int main() {
+  std::cout << "Running Top of Book Cache Tests\n";
+  std::cout << "===============================\n\n";
+
+  try {
+    test_basic_updates();
+    test_concurrent_reads();
+    test_engine_order_flow();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
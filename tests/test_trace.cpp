@@ -0,0 +1,294 @@
+#ifndef HFT_TRACE
+#define HFT_TRACE // Trace points are compiled in for this test
+#endif
+
+#include "../core/core_engine.hpp"
+#include "../core/trace/chrome_trace.hpp"
+#include "../core/trace/tracer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace hft::core;
+
+static bool wait_for(const std::atomic<uint64_t> &counter, uint64_t target) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (counter.load() < target) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+// Points recorded for one trace id across all threads
+static std::vector<TracePoint> points_for(
+    const std::vector<TraceThread> &threads, uint32_t trace_id) {
+  std::vector<TracePoint> points;
+  for (const auto &thread : threads) {
+    for (const auto &event : thread.events) {
+      if (event.trace_id == trace_id) {
+        points.push_back(event.point);
+      }
+    }
+  }
+  return points;
+}
+
+static size_t count_of(const std::vector<TracePoint> &points,
+                       TracePoint point) {
+  return static_cast<size_t>(std::count(points.begin(), points.end(), point));
+}
+
+// Test 1: Ring keeps the newest events, oldest first, once it wraps
+void test_ring_wrap() {
+  TraceRing ring;
+  const uint64_t total = TraceRing::CAPACITY + 100;
+  for (uint64_t i = 0; i < total; ++i) {
+    TraceEvent event{};
+    event.timestamp = i;
+    event.trace_id = static_cast<uint32_t>(i + 1);
+    event.point = TracePoint::ENQUEUE;
+    ring.record(event);
+  }
+  assert(ring.recorded() == total);
+
+  std::vector<TraceEvent> events;
+  ring.collect(events);
+  // The slot after the head may be mid-write, so it is never reported
+  assert(events.size() == TraceRing::CAPACITY - 1);
+  for (size_t i = 0; i < events.size(); ++i) {
+    assert(events[i].timestamp == total - events.size() + i);
+  }
+
+  std::cout << "✓ Ring wrap test passed\n";
+}
+
+// Test 2: One message in N is sampled, each with a fresh nonzero id
+void test_sampling() {
+  Tracer &tracer = Tracer::instance();
+  tracer.set_sample_interval(0);
+  for (int i = 0; i < 100; ++i) {
+    assert(tracer.sample() == 0);
+  }
+
+  tracer.set_sample_interval(4);
+  std::set<uint32_t> ids;
+  size_t sampled = 0;
+  for (int i = 0; i < 400; ++i) {
+    const uint32_t id = tracer.sample();
+    if (id != 0) {
+      sampled++;
+      ids.insert(id);
+    }
+  }
+  assert(sampled == 100);
+  assert(ids.size() == 100);
+
+  tracer.set_sample_interval(0);
+  std::cout << "✓ Sampling test passed\n";
+}
+
+// Test 3: Each thread records into its own ring; dump round-trips
+void test_threads_and_dump() {
+  static constexpr int NUM_THREADS = 4;
+  static constexpr uint32_t EVENTS = 1000;
+  static constexpr uint32_t BASE_ID = 0xF0000000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < NUM_THREADS; ++t) {
+    threads.emplace_back([t] {
+      Tracer &tracer = Tracer::instance();
+      tracer.set_thread_name(("writer " + std::to_string(t)).c_str());
+      for (uint32_t i = 0; i < EVENTS; ++i) {
+        tracer.record(TracePoint::CALLBACK_BEGIN, BASE_ID + t,
+                      static_cast<uint16_t>(i), get_timestamp());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const std::vector<TraceThread> collected = Tracer::instance().collect();
+  std::set<std::string> names;
+  for (const auto &thread : collected) {
+    if (thread.name.rfind("writer ", 0) != 0) {
+      continue;
+    }
+    names.insert(thread.name);
+    // All of a writer's events sit on its own ring, in order
+    assert(thread.events.size() == EVENTS);
+    for (uint32_t i = 0; i < EVENTS; ++i) {
+      assert(thread.events[i].trace_id == thread.events[0].trace_id);
+      assert(thread.events[i].detail == i);
+    }
+  }
+  assert(names.size() == NUM_THREADS);
+
+  const char *path = "test_trace_dump.bin";
+  assert(Tracer::write_trace_file(path, collected));
+  std::vector<TraceThread> loaded;
+  assert(Tracer::read_trace_file(path, loaded));
+  std::remove(path);
+
+  assert(loaded.size() == collected.size());
+  for (size_t i = 0; i < loaded.size(); ++i) {
+    assert(loaded[i].index == collected[i].index);
+    assert(loaded[i].name == collected[i].name);
+    assert(loaded[i].events.size() == collected[i].events.size());
+    for (size_t j = 0; j < loaded[i].events.size(); ++j) {
+      assert(loaded[i].events[j].timestamp ==
+             collected[i].events[j].timestamp);
+      assert(loaded[i].events[j].trace_id == collected[i].events[j].trace_id);
+    }
+  }
+
+  std::vector<TraceThread> missing;
+  assert(!Tracer::read_trace_file("no_such_trace.bin", missing));
+
+  std::cout << "✓ Threads and dump test passed\n";
+}
+
+// Test 4: Sampled messages leave every trace point behind, through the
+// engine on the calling thread and through a consumer thread
+void test_engine_points() {
+  Tracer &tracer = Tracer::instance();
+
+  CoreConfig config;
+  config.trace_sample_interval = 2;
+  CoreEngine engine(config);
+  assert(tracer.sample_interval() == 2);
+
+  std::vector<uint32_t> traced;
+  SubscriberOptions options;
+  options.inline_dispatch = true;
+  engine.add_subscriber(
+      make_subscriber("inline",
+                      [&traced](const NormalizedMessage &msg) {
+                        if (msg.trace_id != 0) {
+                          traced.push_back(msg.trace_id);
+                        }
+                        return true;
+                      }),
+      options);
+
+  uint8_t payload[32] = {};
+  for (uint32_t i = 0; i < 10; ++i) {
+    MessageView view(payload, sizeof(payload), get_timestamp(), i);
+    assert(engine.process_packet(view) == 1);
+  }
+  assert(traced.size() == 5);
+
+  std::vector<TraceThread> threads = tracer.collect();
+  for (const uint32_t id : traced) {
+    const std::vector<TracePoint> points = points_for(threads, id);
+    assert(count_of(points, TracePoint::RECEIVE) == 1);
+    assert(count_of(points, TracePoint::PARSE_BEGIN) == 1);
+    assert(count_of(points, TracePoint::PARSE_END) == 1);
+    assert(count_of(points, TracePoint::ENQUEUE) == 1);
+    assert(count_of(points, TracePoint::CALLBACK_BEGIN) == 1);
+    assert(count_of(points, TracePoint::CALLBACK_END) == 1);
+  }
+
+  // Queued delivery records its callback points on the consumer thread
+  Dispatcher dispatcher;
+  std::atomic<uint64_t> received{0};
+  const SubscriberId queued = dispatcher.add_subscriber(
+      make_subscriber("queued", [&received](const NormalizedMessage &) {
+        received.fetch_add(1);
+        return true;
+      }));
+  dispatcher.start();
+
+  std::vector<uint32_t> ids;
+  for (int i = 0; i < 100; ++i) {
+    NormalizedMessage msg;
+    msg.trace_id = tracer.sample();
+    msg.local_timestamp = get_timestamp();
+    if (msg.trace_id != 0) {
+      ids.push_back(msg.trace_id);
+    }
+    dispatcher.dispatch(msg);
+  }
+  const bool delivered = wait_for(received, 100);
+  assert(delivered);
+  (void)delivered;
+  dispatcher.stop();
+  assert(ids.size() == 50);
+
+  threads = tracer.collect();
+  for (const uint32_t id : ids) {
+    assert(count_of(points_for(threads, id), TracePoint::ENQUEUE) == 1);
+    bool on_consumer = false;
+    for (const auto &thread : threads) {
+      for (const auto &event : thread.events) {
+        if (event.trace_id == id &&
+            event.point == TracePoint::CALLBACK_END) {
+          assert(event.detail == queued);
+          on_consumer = thread.name.rfind("dispatch", 0) == 0;
+        }
+      }
+    }
+    assert(on_consumer);
+  }
+
+  tracer.set_sample_interval(0);
+  std::cout << "✓ Engine trace points test passed\n";
+}
+
+// Test 5: Chrome export has slices, flows and thread names
+void test_chrome_export() {
+  std::ostringstream json;
+  ChromeTraceWriter::write(Tracer::instance().collect(), json);
+  const std::string text = json.str();
+
+  assert(text.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+  assert(text.find("\"name\":\"thread_name\"") != std::string::npos);
+  assert(text.find("\"name\":\"dispatch 0\"") != std::string::npos);
+  assert(text.find("\"name\":\"parse\"") != std::string::npos);
+  assert(text.find("\"name\":\"wait\"") != std::string::npos);
+  assert(text.find("\"name\":\"callback\"") != std::string::npos);
+  assert(text.find("\"ph\":\"s\"") != std::string::npos);
+  assert(text.find("\"ph\":\"f\"") != std::string::npos);
+
+  // Well-formed nesting
+  int depth = 0;
+  for (const char c : text) {
+    if (c == '{' || c == '[') {
+      depth++;
+    } else if (c == '}' || c == ']') {
+      depth--;
+      assert(depth >= 0);
+    }
+  }
+  assert(depth == 0);
+
+  std::cout << "✓ Chrome export test passed\n";
+}
+
+int main() {
+  std::cout << "Running Trace Tests\n";
+  std::cout << "===================\n\n";
+
+  try {
+    test_ring_wrap();
+    test_sampling();
+    test_threads_and_dump();
+    test_engine_points();
+    test_chrome_export();
+
+    std::cout << "\n✅ All tests passed!\n";
+    return 0;
+  } catch (const std::exception &e) {
+    std::cerr << "\n❌ Test failed: " << e.what() << "\n";
+    return 1;
+  }
+}
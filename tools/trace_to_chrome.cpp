@@ -0,0 +1,41 @@
+// Convert a binary trace dump (Tracer::write) to Chrome trace-event JSON
+// Usage: trace_to_chrome <trace.bin> [trace.json]
+// Open the output in chrome://tracing or https://ui.perfetto.dev
+
+#include "core/trace/chrome_trace.hpp"
+#include <fstream>
+#include <iostream>
+
+using namespace hft::core;
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <trace.bin> [trace.json]\n";
+    return 1;
+  }
+
+  std::vector<TraceThread> threads;
+  if (!Tracer::read_trace_file(argv[1], threads)) {
+    std::cerr << "Failed to read trace file " << argv[1] << "\n";
+    return 1;
+  }
+
+  size_t events = 0;
+  for (const auto &thread : threads) {
+    events += thread.events.size();
+  }
+
+  if (argc == 3) {
+    std::ofstream out(argv[2]);
+    if (!out) {
+      std::cerr << "Failed to open " << argv[2] << "\n";
+      return 1;
+    }
+    ChromeTraceWriter::write(threads, out);
+    std::cerr << "Wrote " << events << " events from " << threads.size()
+              << " threads to " << argv[2] << "\n";
+  } else {
+    ChromeTraceWriter::write(threads, std::cout);
+  }
+  return 0;
+}
@@ -0,0 +1,172 @@
+// Live engine statistics from the shared-memory stats page, vmstat style
+// Usage: winter-stat [-p page] [-s] [interval [count]]
+//   -p page   Stats page name (CoreConfig::stats_page), default /hft-stats
+//   -s        Also print a per-subscriber table every interval
+//   interval  Seconds between reports (default 1)
+//   count     Reports to print before exiting (default: run until killed)
+// Attaches read-only; the feed handler is never paused or signalled.
+
+#include "core/metrics/stats_page.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace hft::core;
+
+static void usage(const char *program) {
+  std::fprintf(stderr, "Usage: %s [-p page] [-s] [interval [count]]\n",
+               program);
+}
+
+static double rate(uint64_t now, uint64_t before, double seconds) {
+  return now >= before ? static_cast<double>(now - before) / seconds : 0.0;
+}
+
+static void print_header() {
+  std::printf("%10s %8s %10s %10s %7s %9s %9s %9s %9s %8s %8s\n", "recv/s",
+              "drop/s", "parsed/s", "disp/s", "err/s", "parse50", "parse99",
+              "deliv50", "deliv99", "maxdepth", "subdrop");
+}
+
+static void print_line(const StatsPage &now, const StatsPage &before) {
+  const double seconds =
+      static_cast<double>(now.updated - before.updated) / 1e9;
+  const auto &parse = now.stages[static_cast<size_t>(LatencyStage::PARSE)];
+  const auto &deliver =
+      now.stages[static_cast<size_t>(LatencyStage::QUEUE_TO_SUBSCRIBER)];
+
+  uint64_t max_depth = 0;
+  uint64_t sub_dropped = 0;
+  for (const auto &row : now.subscribers) {
+    max_depth = std::max(max_depth, row.queue_depth);
+    sub_dropped += row.dropped;
+  }
+
+  std::printf(
+      "%10.0f %8.0f %10.0f %10.0f %7.0f %9llu %9llu %9llu %9llu %8llu %8llu\n",
+      rate(now.engine.packets_received, before.engine.packets_received,
+           seconds),
+      rate(now.engine.packets_dropped, before.engine.packets_dropped, seconds),
+      rate(now.engine.messages_parsed, before.engine.messages_parsed, seconds),
+      rate(now.engine.messages_dispatched, before.engine.messages_dispatched,
+           seconds),
+      rate(now.engine.parse_errors, before.engine.parse_errors, seconds),
+      static_cast<unsigned long long>(parse.p50_ns),
+      static_cast<unsigned long long>(parse.p99_ns),
+      static_cast<unsigned long long>(deliver.p50_ns),
+      static_cast<unsigned long long>(deliver.p99_ns),
+      static_cast<unsigned long long>(max_depth),
+      static_cast<unsigned long long>(sub_dropped));
+}
+
+static void print_subscribers(const StatsPage &now, const StatsPage &before) {
+  const double seconds =
+      static_cast<double>(now.updated - before.updated) / 1e9;
+  std::printf("  %4s %-24s %10s %8s %8s %8s %9s %9s\n", "id", "subscriber",
+              "deliv/s", "dropped", "conflat", "depth", "p50", "p99");
+  for (const auto &row : now.subscribers) {
+    uint64_t delivered_before = row.delivered;
+    for (const auto &old : before.subscribers) {
+      if (old.id == row.id) {
+        delivered_before = old.delivered;
+      }
+    }
+    std::printf("  %4llu %-24.24s %10.0f %8llu %8llu %8llu %9llu %9llu%s\n",
+                static_cast<unsigned long long>(row.id), row.name,
+                rate(row.delivered, delivered_before, seconds),
+                static_cast<unsigned long long>(row.dropped),
+                static_cast<unsigned long long>(row.conflated),
+                static_cast<unsigned long long>(row.queue_depth),
+                static_cast<unsigned long long>(row.latency.p50_ns),
+                static_cast<unsigned long long>(row.latency.p99_ns),
+                row.inline_dispatch ? " (inline)" : "");
+  }
+}
+
+int main(int argc, char **argv) {
+  std::string page_name = "/hft-stats";
+  bool show_subscribers = false;
+  double interval = 1.0;
+  long count = -1;
+
+  int positional = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+      page_name = argv[++i];
+    } else if (std::strcmp(argv[i], "-s") == 0) {
+      show_subscribers = true;
+    } else if (argv[i][0] != '-' && positional == 0) {
+      interval = std::atof(argv[i]);
+      positional++;
+    } else if (argv[i][0] != '-' && positional == 1) {
+      count = std::atol(argv[i]);
+      positional++;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (interval <= 0.0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  StatsPageReader reader;
+  if (!reader.attach(page_name)) {
+    std::fprintf(stderr, "No stats page %s (is the engine running with "
+                         "CoreConfig::stats_page set?)\n",
+                 page_name.c_str());
+    return 1;
+  }
+
+  StatsPage before;
+  if (!reader.read(before)) {
+    std::fprintf(stderr, "Stats page %s is not readable\n", page_name.c_str());
+    return 1;
+  }
+  std::printf("engine pid %llu, page %s\n",
+              static_cast<unsigned long long>(before.pid), page_name.c_str());
+
+  const auto period = std::chrono::duration<double>(interval);
+  int lines = 0;
+  for (long printed = 0; count < 0 || printed < count; ++printed) {
+    std::this_thread::sleep_for(period);
+
+    StatsPage now;
+    if (!reader.read(now)) {
+      continue;
+    }
+    if (now.updates == before.updates) {
+      // Not republished since last time - engine stopped or restarted;
+      // re-attach in case a new page replaced this one
+      StatsPageReader fresh;
+      StatsPage page;
+      if (fresh.attach(page_name) && fresh.read(page) &&
+          page.pid != before.pid) {
+        std::printf("engine restarted (pid %llu)\n",
+                    static_cast<unsigned long long>(page.pid));
+        reader.attach(page_name);
+        before = page;
+        lines = 0;
+      }
+      continue;
+    }
+
+    if (lines % 20 == 0 || show_subscribers) {
+      print_header();
+    }
+    print_line(now, before);
+    if (show_subscribers) {
+      print_subscribers(now, before);
+      std::printf("\n");
+    }
+    std::fflush(stdout);
+    lines++;
+    before = now;
+  }
+  return 0;
+}